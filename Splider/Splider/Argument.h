@@ -6,6 +6,7 @@
 #define _SPLIDER_ARGUMENT_H
 
 #include "Linx/Data/Vector.h" // Index
+#include "Splider/Memory.h"
 #include "Splider/Mode.h"
 
 namespace Splider {
@@ -24,7 +25,7 @@ class SplineArg {
   template <typename, typename, Mode>
   friend class Spline;
 
-  template <typename>
+  template <typename, typename>
   friend class BiCospline;
 
 public:
@@ -90,7 +91,7 @@ class Args {
   template <typename, typename, Mode>
   friend class Spline;
 
-  template <typename>
+  template <typename, typename>
   friend class BiCospline; // TODO rm
 
 public:
@@ -102,9 +103,10 @@ public:
 
   /**
    * @brief Iterator-based constructor.
+   * @param resource The memory resource of the arguments
    */
   template <typename TDomain, typename TIt>
-  explicit Args(const TDomain& domain, TIt begin, TIt end) : m_args()
+  explicit Args(const TDomain& domain, TIt begin, TIt end, Resource* resource = default_resource()) : m_args(resource)
   {
     m_args.reserve(std::distance(begin, end));
     for (; begin != end; ++begin) {
@@ -116,16 +118,26 @@ public:
    * @brief Range-based constructor.
    */
   template <typename TDomain, typename TRange>
-  explicit Args(const TDomain& domain, const TRange& u) : Args(domain, u.begin(), u.end())
+  explicit Args(const TDomain& domain, const TRange& u, Resource* resource = default_resource()) :
+      Args(domain, u.begin(), u.end(), resource)
   {}
 
   /**
    * @brief List-based constructor.
    */
   template <typename TDomain>
-  Args(const TDomain& domain, std::initializer_list<Value> u) : Args(domain, u.begin(), u.end())
+  Args(const TDomain& domain, std::initializer_list<Value> u, Resource* resource = default_resource()) :
+      Args(domain, u.begin(), u.end(), resource)
   {}
 
+  /**
+   * @brief Get the memory resource.
+   */
+  Resource* resource() const
+  {
+    return m_args.get_allocator().resource();
+  }
+
   /**
    * @brief Get the number of arguments.
    */
@@ -144,7 +156,7 @@ public:
 
 private:
 
-  std::vector<SplineArg<Value>> m_args; ///< The arguments
+  Buffer<SplineArg<Value>> m_args; ///< The arguments
 };
 
 } // namespace Splider
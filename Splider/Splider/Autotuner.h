@@ -0,0 +1,512 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDER_AUTOTUNER_H
+#define _SPLIDER_AUTOTUNER_H
+
+#include "Splider/C2.h"
+#include "Splider/CatmullRom.h"
+#include "Splider/Hermite.h"
+#include "Splider/HugePages.h"
+#include "Splider/Lagrange.h"
+#include "Splider/Linspace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Splider {
+
+/**
+ * @brief A resampling configuration, as selected by `Autotuner`.
+ *
+ * The configuration is serialized as `key=value` lines, such that it can be saved once and loaded at startup.
+ */
+struct Tuning {
+  std::string method = "C2"; ///< The method: C2, C2FD, HermiteFD, CatmullRom or Lagrange
+  std::string domain = "partition"; ///< The domain type: partition or linspace (for evenly spaced knots only)
+  std::string layout = "cospline"; ///< The argument layout: cospline (precomputed) or spline (on the fly)
+  Linx::Index batch = 0; ///< The number of arguments per batch, or 0 for a single batch
+  Linx::Index threads = 1; ///< The number of threads
+  Linx::Index prefetch = 0; ///< The software prefetching distance of the cospline layout, or 0
+  double error = 0; ///< The estimated maximum absolute error
+  double ns_per_element = 0; ///< The measured resampling time per argument
+
+  /**
+   * @brief Serialize the configuration.
+   */
+  std::string serialize() const
+  {
+    std::ostringstream os;
+    os.precision(17);
+    os << "method=" << method << '\n';
+    os << "domain=" << domain << '\n';
+    os << "layout=" << layout << '\n';
+    os << "batch=" << batch << '\n';
+    os << "threads=" << threads << '\n';
+    os << "prefetch=" << prefetch << '\n';
+    os << "error=" << error << '\n';
+    os << "ns_per_element=" << ns_per_element << '\n';
+    return os.str();
+  }
+
+  /**
+   * @brief Parse a serialized configuration.
+   *
+   * Missing keys are set to their default values, unknown keys are rejected.
+   */
+  static Tuning parse(const std::string& text)
+  {
+    Tuning out;
+    std::istringstream is(text);
+    std::string line;
+    while (std::getline(is, line)) {
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+      const auto pos = line.find('=');
+      if (pos == std::string::npos) {
+        throw std::runtime_error("Malformed tuning line: " + line);
+      }
+      const auto key = line.substr(0, pos);
+      const auto value = line.substr(pos + 1);
+      if (key == "method") {
+        out.method = value;
+      } else if (key == "domain") {
+        out.domain = value;
+      } else if (key == "layout") {
+        out.layout = value;
+      } else if (key == "batch") {
+        out.batch = std::stol(value);
+      } else if (key == "threads") {
+        out.threads = std::stol(value);
+      } else if (key == "prefetch") {
+        out.prefetch = std::stol(value);
+      } else if (key == "error") {
+        out.error = std::stod(value);
+      } else if (key == "ns_per_element") {
+        out.ns_per_element = std::stod(value);
+      } else {
+        throw std::runtime_error("Unknown tuning key: " + key);
+      }
+    }
+    return out;
+  }
+
+  /**
+   * @brief Save the configuration to a file.
+   */
+  void save(const std::string& filename) const
+  {
+    std::ofstream file(filename);
+    if (not file) {
+      throw std::runtime_error("Cannot open tuning file: " + filename);
+    }
+    file << serialize();
+  }
+
+  /**
+   * @brief Load a configuration from a file.
+   */
+  static Tuning load(const std::string& filename)
+  {
+    std::ifstream file(filename);
+    if (not file) {
+      throw std::runtime_error("Cannot open tuning file: " + filename);
+    }
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return parse(ss.str());
+  }
+};
+
+/**
+ * @brief Multi-threaded batch resampler of a given builder.
+ *
+ * Each thread owns a spline and processes every `threads`-th batch of arguments.
+ * When there are several threads, they are pinned to CPUs with `run_pinned()`.
+ *
+ * Precomputed arguments are allocated from an optional memory resource,
+ * e.g. a `HugePageResource` with `tuning.threads` threads and a block of `tuning.batch` arguments,
+ * such that each batch is first-touched on the NUMA node of the thread which processes it.
+ */
+template <typename TBuilder, typename TValue>
+class BatchResampler {
+public:
+
+  /**
+   * @brief Constructor.
+   */
+  template <typename TX>
+  BatchResampler(TBuilder build, const TX& x, const Tuning& tuning, Resource* resource = default_resource()) :
+      m_build(std::move(build)), m_x(std::begin(x), std::end(x)), m_args(resource),
+      m_batch(tuning.batch > 0 ? tuning.batch : std::max<Linx::Index>(m_x.size(), 1)),
+      m_threads(std::max<Linx::Index>(tuning.threads, 1)), m_prefetch(tuning.prefetch)
+  {
+    if (tuning.layout == "cospline") {
+      m_args = m_build.args(m_x, m_args.get_allocator().resource());
+    } else if (tuning.layout != "spline") {
+      throw std::runtime_error("Unknown layout: " + tuning.layout);
+    }
+  }
+
+  /**
+   * @brief Resample knot values.
+   */
+  std::vector<TValue> operator()(const std::vector<TValue>& v) const
+  {
+    const Linx::Index size = m_x.size();
+    std::vector<TValue> y(size);
+    const auto batches = (size + m_batch - 1) / m_batch;
+    auto work = [&](Linx::Index t) {
+      auto spline = m_build.spline(v);
+      spline.prefetch_distance(m_prefetch);
+      for (auto b = t; b < batches; b += m_threads) {
+        const auto begin = b * m_batch;
+        const auto end = std::min(size, (b + 1) * m_batch);
+        if (m_args.empty()) {
+          for (auto i = begin; i < end; ++i) {
+            y[i] = spline(m_x[i]);
+          }
+        } else {
+          spline.transform(m_args.begin() + begin, m_args.begin() + end, y.begin() + begin);
+        }
+      }
+    };
+    const auto threads = std::min(m_threads, batches);
+    if (threads <= 1) {
+      work(0);
+      return y;
+    }
+    run_pinned(threads, work);
+    return y;
+  }
+
+private:
+
+  TBuilder m_build; ///< The builder
+  std::vector<typename TBuilder::Real> m_x; ///< The arguments
+  Buffer<typename TBuilder::Arg> m_args; ///< The precomputed arguments, if any
+  Linx::Index m_batch; ///< The batch size
+  Linx::Index m_threads; ///< The number of threads
+  Linx::Index m_prefetch; ///< The prefetching distance
+};
+
+/**
+ * @brief Resampler which applies a given configuration.
+ *
+ * The method and domain are resolved at construction, such that they can be selected at run time,
+ * e.g. from a saved `Tuning`.
+ */
+template <typename TValue = double>
+class TunedResampler {
+public:
+
+  /**
+   * @brief Constructor.
+   * @param tuning The configuration
+   * @param u The knot abscissae
+   * @param x The arguments
+   */
+  template <typename TU, typename TX>
+  TunedResampler(const Tuning& tuning, const TU& u, const TX& x) : m_tuning(tuning), m_func()
+  {
+    if (tuning.method == "C2") {
+      make<C2>(u, x);
+    } else if (tuning.method == "C2FD") {
+      make<C2::FiniteDiff>(u, x);
+    } else if (tuning.method == "HermiteFD") {
+      make<Hermite::FiniteDiff>(u, x);
+    } else if (tuning.method == "CatmullRom") {
+      make<Hermite::CatmullRom::Uniform>(u, x);
+    } else if (tuning.method == "Lagrange") {
+      make<Lagrange>(u, x);
+    } else {
+      throw std::runtime_error("Unknown method: " + tuning.method);
+    }
+  }
+
+  /**
+   * @brief Get the configuration.
+   */
+  const Tuning& tuning() const
+  {
+    return m_tuning;
+  }
+
+  /**
+   * @brief Resample knot values.
+   */
+  std::vector<TValue> operator()(const std::vector<TValue>& v) const
+  {
+    return m_func(v);
+  }
+
+private:
+
+  /**
+   * @brief Instantiate the resampler of a given method.
+   */
+  template <typename TMethod, typename TU, typename TX>
+  void make(const TU& u, const TX& x)
+  {
+    using Real = std::decay_t<decltype(*std::begin(u))>;
+    using Bounds = typename TMethod::Bounds;
+    if (m_tuning.domain == "partition") {
+      using Build = Builder<typename TMethod::Domain<Real>, TMethod, Bounds, static_cast<Bounds>(0)>;
+      set(std::make_shared<BatchResampler<Build, TValue>>(Build(std::begin(u), std::end(u)), x, m_tuning));
+    } else if (m_tuning.domain == "linspace") {
+      using Build = Builder<Linspace<Real>, TMethod, Bounds, static_cast<Bounds>(0)>;
+      const Linx::Index size = std::distance(std::begin(u), std::end(u));
+      const auto front = *std::begin(u);
+      const auto back = *std::next(std::begin(u), size - 1);
+      const auto step = (back - front) / (size - 1);
+      set(std::make_shared<BatchResampler<Build, TValue>>(Build(front, step, size), x, m_tuning));
+    } else {
+      throw std::runtime_error("Unknown domain: " + m_tuning.domain);
+    }
+  }
+
+  /**
+   * @brief Set the resampling function.
+   *
+   * The resampler is shared because its splines reference the domain it owns.
+   */
+  template <typename TResampler>
+  void set(std::shared_ptr<TResampler> resampler)
+  {
+    m_func = [=](const std::vector<TValue>& v) {
+      return (*resampler)(v);
+    };
+  }
+
+  Tuning m_tuning; ///< The configuration
+  std::function<std::vector<TValue>(const std::vector<TValue>&)> m_func; ///< The resampling function
+};
+
+/**
+ * @brief Autotuner which selects the fastest configuration meeting an accuracy bound.
+ *
+ * The candidate configurations are micro-benchmarked on a representative sample of the problem.
+ * The interpolation error of each method is estimated from the sample itself,
+ * by interpolating the odd knots from the even knots, which gives a pessimistic estimate
+ * of the error of the interpolation from all the knots.
+ *
+ * \code
+ * Splider::Autotuner<double> tuner(u, v, x);
+ * const auto tuning = tuner.tune(1.e-3);
+ * tuning.save("splider.tuning");
+ * ...
+ * Splider::TunedResampler<double> resample(Splider::Tuning::load("splider.tuning"), u, x);
+ * const auto y = resample(v);
+ * \endcode
+ */
+template <typename TValue = double>
+class Autotuner {
+public:
+
+  /**
+   * @brief Constructor.
+   * @param u The knot abscissae
+   * @param v The knot values
+   * @param x The arguments
+   */
+  template <typename TU, typename TV, typename TX>
+  Autotuner(const TU& u, const TV& v, const TX& x) :
+      m_u(std::begin(u), std::end(u)), m_v(std::begin(v), std::end(v)), m_x(std::begin(x), std::end(x)),
+      m_methods {"C2", "C2FD", "HermiteFD", "CatmullRom", "Lagrange"}, m_batches {0, 256, 4096},
+      m_threads {1, static_cast<Linx::Index>(std::max(std::thread::hardware_concurrency(), 1U))},
+      m_prefetches {0, 8, 32}, m_reps(5)
+  {
+    if (m_u.size() < 8) {
+      throw std::runtime_error("Autotuning requires at least 8 knots.");
+    }
+  }
+
+  /**
+   * @brief Set the candidate methods.
+   */
+  void methods(std::vector<std::string> candidates)
+  {
+    m_methods = std::move(candidates);
+  }
+
+  /**
+   * @brief Set the candidate batch sizes, where 0 means a single batch.
+   */
+  void batches(std::vector<Linx::Index> candidates)
+  {
+    m_batches = std::move(candidates);
+  }
+
+  /**
+   * @brief Set the candidate thread counts.
+   */
+  void threads(std::vector<Linx::Index> candidates)
+  {
+    m_threads = std::move(candidates);
+  }
+
+  /**
+   * @brief Set the candidate prefetching distances, where 0 disables prefetching.
+   *
+   * Prefetching only applies to the cospline layout, and pays off with unsorted arguments and large knot arrays.
+   */
+  void prefetches(std::vector<Linx::Index> candidates)
+  {
+    m_prefetches = std::move(candidates);
+  }
+
+  /**
+   * @brief Set the number of repetitions per candidate.
+   */
+  void repetitions(Linx::Index count)
+  {
+    m_reps = std::max<Linx::Index>(count, 1);
+  }
+
+  /**
+   * @brief Check whether the knots are evenly spaced, up to a relative tolerance.
+   */
+  bool is_even(double tolerance = 1.e-9) const
+  {
+    const auto step = (m_u.back() - m_u.front()) / (m_u.size() - 1);
+    for (std::size_t i = 1; i < m_u.size(); ++i) {
+      if (std::abs(m_u[i] - m_u[i - 1] - step) > tolerance * std::abs(step)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Estimate the maximum interpolation error of a method.
+   */
+  double estimate_error(const std::string& method) const
+  {
+    std::vector<double> u;
+    std::vector<TValue> v;
+    std::vector<double> x;
+    std::vector<TValue> expected;
+    for (std::size_t i = 0; i < m_u.size(); ++i) {
+      if (i % 2 == 0) {
+        u.push_back(m_u[i]);
+        v.push_back(m_v[i]);
+      } else if (i < m_u.size() - 1) {
+        x.push_back(m_u[i]);
+        expected.push_back(m_v[i]);
+      }
+    }
+    Tuning tuning;
+    tuning.method = method;
+    const auto y = TunedResampler<TValue>(tuning, u, x)(v);
+    double error = 0;
+    for (std::size_t i = 0; i < y.size(); ++i) {
+      error = std::max<double>(error, std::abs(y[i] - expected[i]));
+    }
+    return error;
+  }
+
+  /**
+   * @brief Measure the median resampling time per argument of a configuration, in nanoseconds.
+   */
+  double measure(const Tuning& tuning) const
+  {
+    const TunedResampler<TValue> resample(tuning, m_u, m_x);
+    std::vector<double> samples;
+    for (Linx::Index r = 0; r < m_reps; ++r) {
+      const auto start = std::chrono::steady_clock::now();
+      const auto y = resample(m_v);
+      const auto stop = std::chrono::steady_clock::now();
+      samples.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2] / std::max<std::size_t>(m_x.size(), 1);
+  }
+
+  /**
+   * @brief List the candidate configurations of the methods which meet an accuracy bound.
+   */
+  std::vector<Tuning> candidates(double tolerance) const
+  {
+    std::vector<std::string> domains {"partition"};
+    if (is_even()) {
+      domains.push_back("linspace");
+    }
+    std::vector<Tuning> out;
+    for (const auto& method : m_methods) {
+      const auto error = estimate_error(method);
+      if (error > tolerance) {
+        continue;
+      }
+      for (const auto& domain : domains) {
+        for (const std::string layout : {"cospline", "spline"}) {
+          for (auto batch : m_batches) {
+            for (auto threads : m_threads) {
+              if (threads > 1 && batch == 0) {
+                continue; // Nothing to share
+              }
+              for (auto prefetch : m_prefetches) {
+                if (prefetch > 0 && layout == "spline") {
+                  continue; // Intervals are unknown in advance
+                }
+                Tuning tuning;
+                tuning.method = method;
+                tuning.domain = domain;
+                tuning.layout = layout;
+                tuning.batch = batch;
+                tuning.threads = threads;
+                tuning.prefetch = prefetch;
+                tuning.error = error;
+                out.push_back(tuning);
+              }
+            }
+          }
+        }
+      }
+    }
+    return out;
+  }
+
+  /**
+   * @brief Benchmark the candidates and return the fastest one which meets an accuracy bound.
+   * @param tolerance The maximum absolute error
+   */
+  Tuning tune(double tolerance) const
+  {
+    auto configs = candidates(tolerance);
+    if (configs.empty()) {
+      throw std::runtime_error("No method meets the accuracy bound.");
+    }
+    for (auto& c : configs) {
+      c.ns_per_element = measure(c);
+    }
+    return *std::min_element(configs.begin(), configs.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.ns_per_element < rhs.ns_per_element;
+    });
+  }
+
+private:
+
+  std::vector<double> m_u; ///< The knot abscissae
+  std::vector<TValue> m_v; ///< The knot values
+  std::vector<double> m_x; ///< The arguments
+  std::vector<std::string> m_methods; ///< The candidate methods
+  std::vector<Linx::Index> m_batches; ///< The candidate batch sizes
+  std::vector<Linx::Index> m_threads; ///< The candidate thread counts
+  std::vector<Linx::Index> m_prefetches; ///< The candidate prefetching distances
+  Linx::Index m_reps; ///< The number of repetitions
+};
+
+} // namespace Splider
+
+#endif
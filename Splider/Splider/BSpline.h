@@ -0,0 +1,756 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDER_BSPLINE_H
+#define _SPLIDER_BSPLINE_H
+
+#include "Linx/Base/SeqUtils.h" // IsRange
+#include "Splider/Builder.h"
+#include "Splider/Instrument.h"
+#include "Splider/Linspace.h"
+#include "Splider/Memory.h"
+#include "Splider/Polynomial.h"
+#include "Splider/Prefetch.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace Splider {
+
+/**
+ * @brief The B-spline boundary conditions.
+ */
+enum class BSplineBounds {
+  Mirror = 0 ///< Whole-sample symmetric extension, i.e. null derivatives at the bounds
+};
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief Apply the cubic B-spline prefilter in place to parallel lines of samples.
+ * @param data The first sample of the first line
+ * @param n The number of samples per line
+ * @param stride The distance between consecutive samples of a line
+ * @param count The number of lines, which are contiguous, i.e. the sample `k` of line `l` is `data[l + k * stride]`
+ * @param sums A buffer of `count` values
+ *
+ * This is the recursive filter of Unser et al., i.e. a causal and an anticausal first-order IIR pass
+ * with pole \f$\sqrt{3} - 2\f$, and mirror boundary conditions.
+ * The innermost loops run across lines, such that they are vectorized when filtering along a slow axis.
+ */
+template <typename TReal, typename T>
+void bspline_prefilter(T* data, Linx::Index n, Linx::Index stride, Linx::Index count, T* sums)
+{
+  const auto z = std::sqrt(TReal(3)) - 2;
+  const auto line = [&](Linx::Index k) {
+    return data + k * stride;
+  };
+  for (Linx::Index k = 0; k < n; ++k) {
+    auto c = line(k);
+    for (Linx::Index l = 0; l < count; ++l) {
+      c[l] *= TReal(6);
+    }
+  }
+  if (n == 1) {
+    return;
+  }
+
+  // Causal initialization
+  const auto log_epsilon = std::log(std::numeric_limits<TReal>::epsilon());
+  const auto horizon = static_cast<Linx::Index>(std::ceil(log_epsilon / std::log(-z)));
+  std::copy_n(line(0), count, sums);
+  if (horizon < n) {
+    auto zk = z;
+    for (Linx::Index k = 1; k < horizon; ++k, zk *= z) {
+      const auto c = line(k);
+      for (Linx::Index l = 0; l < count; ++l) {
+        sums[l] += zk * c[l];
+      }
+    }
+  } else {
+    auto zk = z;
+    auto z2n = std::pow(z, TReal(n - 1));
+    const auto iz = 1 / z;
+    const auto last = line(n - 1);
+    for (Linx::Index l = 0; l < count; ++l) {
+      sums[l] += z2n * last[l];
+    }
+    z2n *= z2n * iz;
+    for (Linx::Index k = 1; k < n - 1; ++k, zk *= z, z2n *= iz) {
+      const auto c = line(k);
+      for (Linx::Index l = 0; l < count; ++l) {
+        sums[l] += (zk + z2n) * c[l];
+      }
+    }
+    for (Linx::Index l = 0; l < count; ++l) {
+      sums[l] /= (1 - zk * zk);
+    }
+  }
+  std::copy_n(sums, count, line(0));
+
+  // Causal pass
+  for (Linx::Index k = 1; k < n; ++k) {
+    const auto previous = line(k - 1);
+    auto c = line(k);
+    for (Linx::Index l = 0; l < count; ++l) {
+      c[l] += z * previous[l];
+    }
+  }
+
+  // Anticausal initialization and pass
+  const auto last = line(n - 1);
+  const auto before = line(n - 2);
+  for (Linx::Index l = 0; l < count; ++l) {
+    last[l] = (z / (z * z - 1)) * (z * before[l] + last[l]);
+  }
+  for (Linx::Index k = n - 2; k >= 0; --k) {
+    const auto next = line(k + 1);
+    auto c = line(k);
+    for (Linx::Index l = 0; l < count; ++l) {
+      c[l] = z * (next[l] - c[l]);
+    }
+  }
+}
+
+/**
+ * @brief Check that knots are uniformly spaced, and make the corresponding `Linspace`.
+ */
+template <typename TIt>
+auto make_linspace(TIt begin, TIt end)
+{
+  using Real = std::decay_t<typename std::iterator_traits<TIt>::value_type>;
+  const std::vector<Real> u(begin, end);
+  const auto n = static_cast<Linx::Index>(u.size());
+  if (n < 2) {
+    throw std::runtime_error("B-splines require at least 2 knots.");
+  }
+  const auto step = (u[n - 1] - u[0]) / (n - 1);
+  for (Linx::Index i = 0; i < n; ++i) {
+    if (std::abs(u[i] - (u[0] + i * step)) > std::abs(step) * Real(1e-6)) {
+      throw std::runtime_error("B-splines require uniformly spaced knots.");
+    }
+  }
+  return Linspace<Real>(u[0], step, n);
+}
+
+} // namespace Internal
+/// @endcond
+
+/**
+ * @brief A cubic B-spline argument.
+ */
+template <typename TDomain>
+class BSplineArg {
+  template <typename, typename, BSplineBounds, typename>
+  friend class BSplineSpline;
+
+  template <typename, typename, BSplineBounds, typename>
+  friend class BiBSpline;
+
+  template <typename, typename>
+  friend class Fitter;
+
+public:
+
+  /**
+   * @brief The knots domain type.
+   */
+  using Domain = TDomain;
+
+  /**
+   * @brief The argument floating point type.
+   */
+  using Real = typename Domain::Value;
+
+  /**
+   * @brief Constructor.
+   */
+  BSplineArg(const Domain& domain, Real x)
+  {
+    m_i = domain.index(x);
+    const auto t = (x - domain[m_i]) / domain.length(m_i);
+    const auto s = 1 - t;
+    const auto t2 = t * t;
+    const auto t3 = t2 * t;
+    m_w[0] = s * s * s / 6;
+    m_w[1] = (4 - 6 * t2 + 3 * t3) / 6;
+    m_w[2] = (1 + 3 * (t + t2 - t3)) / 6;
+    m_w[3] = t3 / 6;
+  }
+
+  /**
+   * @brief Get the subinterval index.
+   */
+  inline Linx::Index index() const
+  {
+    return m_i;
+  }
+
+private:
+
+  Linx::Index m_i; ///< The subinterval index
+  std::array<Real, 4> m_w; ///< The weights of the coefficients `i - 1` to `i + 2`
+};
+
+/**
+ * @brief The cubic B-spline evaluator.
+ *
+ * The knot values are converted into B-spline coefficients by a recursive prefilter,
+ * which requires neither a tridiagonal system nor its storage,
+ * and the spline is evaluated as a 4-tap B-spline kernel.
+ * The coefficients are stored with one mirrored coefficient at each end, such that evaluation does not branch.
+ */
+template <typename TDomain, typename TValue, BSplineBounds B, typename TInstrument = NoInstrument>
+class BSplineSpline : public PowerBasisMixin<BSplineSpline<TDomain, TValue, B, TInstrument>>, public PrefetchMixin {
+  friend PowerBasisMixin<BSplineSpline>;
+
+public:
+
+  /**
+   * @brief The knots domain type.
+   */
+  using Domain = TDomain;
+
+  /**
+   * @brief The abscissae floating point type.
+   */
+  using Real = typename Domain::Value;
+
+  /**
+   * @brief The argument type.
+   */
+  using Arg = BSplineArg<Domain>;
+
+  /**
+   * @brief The knot value type.
+   */
+  using Value = TValue;
+
+  /**
+   * @brief Null knots constructor.
+   * @param resource The memory resource of the knot values and coefficients
+   */
+  explicit BSplineSpline(const Domain& u, Resource* resource = default_resource()) :
+      m_domain(u), m_v(m_domain.size(), resource), m_c(m_domain.size() + 2, resource), m_valid(true), m_instrument()
+  {}
+
+  /**
+   * @brief Iterator-based constructor.
+   */
+  template <typename TIt>
+  explicit BSplineSpline(const Domain& u, TIt begin, TIt end, Resource* resource = default_resource()) :
+      m_domain(u), m_v(begin, end, resource), m_c(m_v.size() + 2, resource), m_valid(false), m_instrument()
+  {}
+
+  /**
+   * @brief Get the knots domain.
+   */
+  inline const Domain& domain() const
+  {
+    return m_domain;
+  }
+
+  /**
+   * @brief Get the memory resource.
+   */
+  inline Resource* resource() const
+  {
+    return m_v.get_allocator().resource();
+  }
+
+  /**
+   * @brief Assign the knot values.
+   */
+  template <typename TIt>
+  void assign(TIt begin, TIt end)
+  {
+    m_v.assign(begin, end);
+    invalidate();
+  }
+
+  /**
+   * @brief Assign the knot values.
+   */
+  template <typename TV, typename std::enable_if_t<Linx::IsRange<TV>::value>* = nullptr>
+  void assign(const TV& v)
+  {
+    assign(std::begin(v), std::end(v));
+  }
+
+  /**
+   * @brief Assign the knot values.
+   */
+  template <typename TV>
+  void assign(std::initializer_list<TV> v)
+  {
+    assign(v.begin(), v.end());
+  }
+
+  /**
+   * @brief Set a knot value.
+   */
+  void set(Linx::Index i, Value v)
+  {
+    m_v[i] = v;
+    invalidate();
+  }
+
+  /**
+   * @brief Update the B-spline coefficients.
+   */
+  void update(Linx::Index)
+  {
+    if (m_valid) {
+      m_instrument.increment(Event::Skip);
+      return;
+    }
+    m_instrument.start(Event::Solve);
+    const auto n = m_domain.ssize();
+    std::copy(m_v.begin(), m_v.end(), m_c.begin() + 1);
+    Value sum;
+    Internal::bspline_prefilter<Real>(&m_c[1], n, 1, 1, &sum);
+    m_c[0] = m_c[std::min<Linx::Index>(2, n)];
+    m_c[n + 1] = m_c[std::max<Linx::Index>(n - 1, 1)];
+    m_valid = true;
+    m_instrument.stop(Event::Solve);
+  }
+
+  /**
+   * @brief Add a scaled spline of the same type and domain, i.e. compute `this = a * x + this`.
+   * @return This spline
+   * @see `PiecewiseCubicMixin::axpy()`
+   */
+  BSplineSpline& axpy(Value a, BSplineSpline& x)
+  {
+    if (x.domain().size() != m_domain.size() || x.domain()[0] != m_domain[0] || x.domain()[1] != m_domain[1]) {
+      throw std::runtime_error("Cannot combine splines: domain mismatch.");
+    }
+    const auto n = m_v.size();
+    if (not m_valid && not x.m_valid) {
+      for (std::size_t i = 0; i < n; ++i) {
+        m_v[i] += a * x.m_v[i];
+      }
+      return *this;
+    }
+    update(0);
+    x.update(0);
+    for (std::size_t i = 0; i < n; ++i) {
+      m_v[i] += a * x.m_v[i];
+    }
+    for (std::size_t i = 0; i < n + 2; ++i) {
+      m_c[i] += a * x.m_c[i];
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Scale the spline, i.e. compute `this = a * this`.
+   * @return This spline
+   */
+  BSplineSpline& scale(Value a)
+  {
+    for (auto& e : m_v) {
+      e *= a;
+    }
+    if (m_valid) {
+      for (auto& e : m_c) {
+        e *= a;
+      }
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Evaluate the spline for a given argument.
+   */
+  inline Value operator()(Real x)
+  {
+    check_range(m_instrument, m_domain, x);
+    m_instrument.increment(Event::Argument);
+    return operator()(Arg(m_domain, x));
+  }
+
+  /**
+   * @brief Evaluate the spline for a given argument.
+   */
+  Value operator()(const Arg& arg)
+  {
+    update(arg.m_i);
+    m_instrument.increment(Event::Evaluation);
+    const auto c = &m_c[arg.m_i];
+    return c[0] * arg.m_w[0] + c[1] * arg.m_w[1] + c[2] * arg.m_w[2] + c[3] * arg.m_w[3];
+  }
+
+  /**
+   * @brief Evaluate the spline for multiple arguments.
+   */
+  template <typename TIt>
+  std::vector<Value> operator()(TIt begin, TIt end)
+  {
+    std::vector<Value> out;
+    out.reserve(std::distance(begin, end));
+    transform(begin, end, std::back_inserter(out));
+    return out;
+  }
+
+  /**
+   * @brief Evaluate the spline for multiple arguments.
+   */
+  template <typename TX, typename std::enable_if_t<Linx::IsRange<TX>::value>* = nullptr>
+  std::vector<Value> operator()(const TX& x)
+  {
+    return operator()(std::begin(x), std::end(x));
+  }
+
+  /**
+   * @brief Evaluate the spline for multiple arguments.
+   */
+  template <typename TX>
+  std::vector<Value> operator()(std::initializer_list<TX> x)
+  {
+    return operator()(x.begin(), x.end());
+  }
+
+  /**
+   * @brief Evaluate the spline for multiple arguments into an output iterator.
+   * @return The output iterator past the last written value
+   *
+   * This method does not allocate, and is the preferred entry point for steady-state evaluation.
+   */
+  template <typename TIt, typename TOut>
+  TOut transform(TIt begin, TIt end, TOut out)
+  {
+    m_instrument.start(Event::Batch);
+    out = prefetch_transform<Arg>(
+        begin,
+        end,
+        out,
+        [&](const auto& x) {
+          return (*this)(x);
+        },
+        [&](const Arg& arg) {
+          Splider::prefetch(&m_c[arg.m_i]);
+          Splider::prefetch(&m_c[arg.m_i + 3]);
+        });
+    m_instrument.stop(Event::Batch);
+    return out;
+  }
+
+  /**
+   * @brief Get the instrumentation policy.
+   */
+  inline const TInstrument& instrument() const
+  {
+    return m_instrument;
+  }
+
+  /**
+   * @copydoc instrument()
+   */
+  inline TInstrument& instrument()
+  {
+    return m_instrument;
+  }
+
+protected:
+
+  /**
+   * @brief Get the power-basis coefficients of the i-th subinterval, assuming the spline is up to date.
+   */
+  std::array<Value, 4> power_coefficients(Linx::Index i) const
+  {
+    const auto h = m_domain.length(i);
+    const auto c = &m_c[i];
+    return {
+        (c[0] + c[1] * Real(4) + c[2]) / Real(6),
+        (c[2] - c[0]) / (2 * h),
+        (c[0] - c[1] * Real(2) + c[2]) / (2 * h * h),
+        (c[3] - c[0] + (c[1] - c[2]) * Real(3)) / (6 * h * h * h)};
+  }
+
+  /**
+   * @brief Invalidate the coefficients.
+   */
+  inline void invalidate()
+  {
+    if (m_valid) {
+      m_instrument.increment(Event::Invalidation);
+    }
+    m_valid = false;
+  }
+
+  const Domain& m_domain; ///< The knots domain
+  Buffer<Value> m_v; ///< The knot values
+  Buffer<Value> m_c; ///< The B-spline coefficients, with one mirrored coefficient at each end
+  bool m_valid; ///< Validity flag
+  TInstrument m_instrument; ///< The instrumentation policy
+};
+
+/**
+ * @brief Bivariate cubic B-spline over a uniform grid.
+ *
+ * The knot values are prefiltered separably, along the first axis row by row,
+ * and then along the second axis for all the rows at once, which is vectorized.
+ * The spline is evaluated at a position as a 4x4 B-spline kernel.
+ *
+ * Positions are objects on which `operator[]()` is called to get the components, e.g. of a `Trajectory<2>`,
+ * and knot values are iterated with the first axis varying fastest, e.g. from a `Linx::Raster`.
+ */
+template <
+    typename TDomain,
+    typename TValue,
+    BSplineBounds B = BSplineBounds::Mirror,
+    typename TInstrument = NoInstrument>
+class BiBSpline {
+public:
+
+  /**
+   * @brief The dimension.
+   */
+  static constexpr Linx::Index Dimension = 2;
+
+  /**
+   * @brief The knots domain type.
+   */
+  using Domain = TDomain;
+
+  /**
+   * @brief The abscissae floating point type.
+   */
+  using Real = typename Domain::Value;
+
+  /**
+   * @brief The argument type along each axis.
+   */
+  using Arg = BSplineArg<Domain>;
+
+  /**
+   * @brief The knot value type.
+   */
+  using Value = TValue;
+
+  /**
+   * @brief Null knots constructor.
+   * @param resource The memory resource of the coefficients
+   */
+  BiBSpline(const Domain& domain0, const Domain& domain1, Resource* resource = default_resource()) :
+      m_domain0(domain0), m_domain1(domain1), m_row(domain0.ssize() + 2),
+      m_c(m_row * (domain1.ssize() + 2), resource), m_sums(m_row, resource), m_instrument()
+  {}
+
+  /**
+   * @brief Get the knots domain along a given axis.
+   */
+  inline const Domain& domain(Linx::Index axis) const
+  {
+    return axis == 0 ? m_domain0 : m_domain1;
+  }
+
+  /**
+   * @brief Get the memory resource.
+   */
+  inline Resource* resource() const
+  {
+    return m_c.get_allocator().resource();
+  }
+
+  /**
+   * @brief Assign the knot values and prefilter them.
+   */
+  template <typename TIt>
+  void assign(TIt begin, TIt end)
+  {
+    const auto n0 = m_domain0.ssize();
+    const auto n1 = m_domain1.ssize();
+    if (std::distance(begin, end) != n0 * n1) {
+      throw std::runtime_error("Number of knot values does not match the grid.");
+    }
+    m_instrument.start(Event::Solve);
+    for (Linx::Index j = 1; j <= n1; ++j) {
+      auto row = &m_c[j * m_row + 1];
+      for (Linx::Index i = 0; i < n0; ++i, ++begin) {
+        row[i] = *begin;
+      }
+      Internal::bspline_prefilter<Real>(row, n0, 1, 1, m_sums.data());
+      row[-1] = row[std::min<Linx::Index>(1, n0 - 1)];
+      row[n0] = row[std::max<Linx::Index>(n0 - 2, 0)];
+    }
+    Internal::bspline_prefilter<Real>(&m_c[m_row], n1, m_row, m_row, m_sums.data());
+    std::copy_n(&m_c[std::min<Linx::Index>(2, n1) * m_row], m_row, &m_c[0]);
+    std::copy_n(&m_c[std::max<Linx::Index>(n1 - 1, 1) * m_row], m_row, &m_c[(n1 + 1) * m_row]);
+    m_instrument.stop(Event::Solve);
+  }
+
+  /**
+   * @brief Assign the knot values and prefilter them.
+   */
+  template <typename TV, typename std::enable_if_t<Linx::IsRange<TV>::value>* = nullptr>
+  void assign(const TV& v)
+  {
+    assign(std::begin(v), std::end(v));
+  }
+
+  /**
+   * @brief Evaluate the spline at a given position.
+   */
+  Value operator()(Real x0, Real x1)
+  {
+    check_range(m_instrument, m_domain0, x0);
+    check_range(m_instrument, m_domain1, x1);
+    m_instrument.increment(Event::Argument);
+    return operator()(std::array<Arg, Dimension> {Arg(m_domain0, x0), Arg(m_domain1, x1)});
+  }
+
+  /**
+   * @brief Evaluate the spline for given arguments.
+   */
+  Value operator()(const std::array<Arg, Dimension>& x)
+  {
+    m_instrument.increment(Event::Evaluation);
+    const auto& a0 = x[0];
+    const auto& a1 = x[1];
+    auto c = &m_c[a0.m_i + a1.m_i * m_row];
+    Value out {};
+    for (Linx::Index b = 0; b < 4; ++b, c += m_row) {
+      out += (c[0] * a0.m_w[0] + c[1] * a0.m_w[1] + c[2] * a0.m_w[2] + c[3] * a0.m_w[3]) * a1.m_w[b];
+    }
+    return out;
+  }
+
+  /**
+   * @brief Evaluate the spline at multiple positions or arguments into an output iterator.
+   * @return The output iterator past the last written value
+   */
+  template <typename TIt, typename TOut>
+  TOut transform(TIt begin, TIt end, TOut out)
+  {
+    m_instrument.start(Event::Batch);
+    for (; begin != end; ++begin, ++out) {
+      if constexpr (std::is_same<std::decay_t<decltype(*begin)>, std::array<Arg, Dimension>>::value) {
+        *out = operator()(*begin);
+      } else {
+        *out = operator()((*begin)[0], (*begin)[1]);
+      }
+    }
+    m_instrument.stop(Event::Batch);
+    return out;
+  }
+
+  /**
+   * @brief Evaluate the spline at multiple positions or arguments.
+   */
+  template <typename TX, typename std::enable_if_t<Linx::IsRange<TX>::value>* = nullptr>
+  std::vector<Value> operator()(const TX& x)
+  {
+    std::vector<Value> out(std::distance(std::begin(x), std::end(x)));
+    transform(std::begin(x), std::end(x), out.begin());
+    return out;
+  }
+
+  /**
+   * @brief Get the instrumentation policy.
+   */
+  inline const TInstrument& instrument() const
+  {
+    return m_instrument;
+  }
+
+  /**
+   * @copydoc instrument()
+   */
+  inline TInstrument& instrument()
+  {
+    return m_instrument;
+  }
+
+private:
+
+  const Domain& m_domain0; ///< The knots domain along the first axis
+  const Domain& m_domain1; ///< The knots domain along the second axis
+  Linx::Index m_row; ///< The padded row length
+  Buffer<Value> m_c; ///< The B-spline coefficients, with one mirrored coefficient at each end of each axis
+  Buffer<Value> m_sums; ///< The prefilter initialization buffer
+  TInstrument m_instrument; ///< The instrumentation policy
+};
+
+/**
+ * @ingroup builders
+ * @brief Cubic B-splines over uniform grids (\f$C^2\f$).
+ *
+ * This is an interpolating \f$C^2\f$ spline like `C2`, but with mirror boundary conditions,
+ * and computed with a recursive prefilter instead of a tridiagonal solver.
+ * The knots must be uniformly spaced: they are given as a `Linspace`, or as a range which is checked.
+ */
+struct BSpline {
+  /**
+   * @brief The boundary conditions.
+   */
+  using Bounds = BSplineBounds;
+
+  /**
+   * @brief The knots domain type.
+   */
+  template <typename TReal>
+  using Domain = Linspace<TReal>;
+
+  /**
+   * @brief The argument type.
+   */
+  template <typename TDomain>
+  using Arg = BSplineArg<TDomain>;
+
+  /**
+   * @brief The spline evaluator.
+   */
+  template <typename TDomain, typename TValue, BSplineBounds B, typename TInstrument = NoInstrument>
+  using Spline = BSplineSpline<TDomain, TValue, B, TInstrument>;
+
+  /**
+   * @brief The bivariate spline evaluator.
+   */
+  template <typename TDomain, typename TValue, BSplineBounds B, typename TInstrument = NoInstrument>
+  using BiSpline = BiBSpline<TDomain, TValue, B, TInstrument>;
+
+  /**
+   * @brief Make a builder from the first abscissa, the step and the number of knots.
+   */
+  template <BSplineBounds B = BSplineBounds::Mirror, typename TReal>
+  static auto builder(TReal front, TReal step, Linx::Index size)
+  {
+    return Builder<Linspace<TReal>, BSpline, BSplineBounds, B>(front, step, size);
+  }
+
+  /**
+   * @brief Make a builder from uniformly spaced knots.
+   *
+   * The domain holds no buffer, such that the memory resource is ignored.
+   */
+  template <BSplineBounds B = BSplineBounds::Mirror, typename TIt>
+  static auto builder(TIt begin, TIt end, Resource* = default_resource())
+  {
+    const auto domain = Internal::make_linspace(begin, end);
+    return builder<B>(domain.front(), domain.length(0), domain.ssize());
+  }
+
+  /**
+   * @brief Make a builder from uniformly spaced knots.
+   */
+  template <BSplineBounds B = BSplineBounds::Mirror, typename TRange>
+  static auto builder(const TRange& range, Resource* resource = default_resource())
+  {
+    return builder<B>(std::begin(range), std::end(range), resource);
+  }
+};
+
+} // namespace Splider
+
+#endif
@@ -8,8 +8,12 @@
 #include "Linx/Data/Mask.h"
 #include "Linx/Data/Raster.h"
 #include "Linx/Data/Sequence.h"
+#include "Splider/Co.h" // Precomputed
+#include "Splider/Instrument.h"
+#include "Splider/Memory.h"
 
 #include <algorithm>
+#include <iterator>
 #include <stdexcept>
 #include <vector>
 
@@ -41,8 +45,13 @@ using Trajectory = Linx::Sequence<Linx::Vector<T, N>>;
  * 
  * Similarly to `Spline`, the resampler can rely on various caching strategies:
  * see `Caching` documentation for selecting the most appropriate one.
+ *
+ * The optional instrumentation policy counts and times argument constructions and resamplings.
+ *
+ * The arguments and the cached splines are allocated from an optional memory resource.
+ * The knot mask is a `Linx::Mask`, which relies on the default allocator.
  */
-template <typename TSpline>
+template <typename TSpline, typename TInstrument = NoInstrument>
 class BiCospline {
 public:
 
@@ -76,57 +85,155 @@ public:
    */
   using Value = typename Method::Value;
 
+  /**
+   * @brief The instrumentation policy.
+   */
+  using Instrument = TInstrument;
+
   /**
    * @brief Iterator-based constructor.
    */
   template <typename TIt>
-  BiCospline(const Domain& domain0, const Domain& domain1, TIt begin, TIt end) :
-      m_splines0(domain1.size(), Method(domain0)), m_spline1(domain1), m_x(),
-      m_mask(Linx::Position<Dimension>::zero(), {domain0.ssize() - 1, domain1.ssize() - 1}, false)
+  BiCospline(
+      const Domain& domain0,
+      const Domain& domain1,
+      TIt begin,
+      TIt end,
+      Resource* resource = default_resource()) :
+      m_splines0(resource), m_spline1(domain1, resource), m_x(resource),
+      m_mask(Linx::Position<Dimension>::zero(), {domain0.ssize() - 1, domain1.ssize() - 1}, false), m_instrument()
   {
+    init_splines0(domain0);
+    m_instrument.start(Event::Argument);
     for (; begin != end; ++begin) {
+      check_range(m_instrument, domain0, (*begin)[0]);
+      check_range(m_instrument, domain1, (*begin)[1]);
       std::array<Arg, Dimension> xi {Arg(domain0, (*begin)[0]), Arg(domain1, (*begin)[1])};
-      const auto i0 = xi[0].index();
-      const auto i1 = xi[1].index();
-      const auto min0 = std::max(i0 - 1, 0L);
-      const auto max0 = std::min(i0 + 2, domain0.ssize() - 1);
-      const auto min1 = std::max(i1 - 1, 0L);
-      const auto max1 = std::min(i1 + 2, domain1.ssize() - 1);
-      for (auto j1 = min1; j1 <= max1; ++j1) {
-        for (auto j0 = min0; j0 <= max0; ++j0) {
-          m_mask[{j0, j1}] = true;
-        }
-      }
+      mark(xi);
       m_x.push_back(std::move(xi));
     }
+    m_instrument.stop(Event::Argument, m_x.size());
+  }
+
+  /**
+   * @brief Precomputed arguments constructor.
+   *
+   * The arguments must have been computed for the same domains, e.g. by another resampler.
+   * @see `args()`
+   */
+  template <typename TIt>
+  BiCospline(
+      const Domain& domain0,
+      const Domain& domain1,
+      Precomputed,
+      TIt begin,
+      TIt end,
+      Resource* resource = default_resource()) :
+      m_splines0(resource), m_spline1(domain1, resource), m_x(begin, end, resource),
+      m_mask(Linx::Position<Dimension>::zero(), {domain0.ssize() - 1, domain1.ssize() - 1}, false), m_instrument()
+  {
+    init_splines0(domain0);
+    for (const auto& xi : m_x) {
+      mark(xi);
+    }
   }
 
   /**
    * @brief Range-based constructor.
    */
   template <typename TRange>
-  BiCospline(const Domain& domain0, const Domain& domain1, const TRange& x) :
-      BiCospline(domain0, domain1, x.begin(), x.end())
+  BiCospline(
+      const Domain& domain0,
+      const Domain& domain1,
+      const TRange& x,
+      Resource* resource = default_resource()) :
+      BiCospline(domain0, domain1, x.begin(), x.end(), resource)
   {}
 
   /**
    * @brief List-based constructor.
    */
-  BiCospline(const Domain& domain0, const Domain& domain1, std::initializer_list<Value> x) :
-      BiCospline(domain0, domain1, x.begin(), x.end())
+  BiCospline(
+      const Domain& domain0,
+      const Domain& domain1,
+      std::initializer_list<Value> x,
+      Resource* resource = default_resource()) :
+      BiCospline(domain0, domain1, x.begin(), x.end(), resource)
   {}
 
+  /**
+   * @brief Get the knot domain along a given axis.
+   */
+  const Domain& domain(Linx::Index axis) const
+  {
+    return axis == 0 ? m_splines0[0].domain() : m_spline1.domain();
+  }
+
+  /**
+   * @brief Get the memory resource.
+   */
+  Resource* resource() const
+  {
+    return m_x.get_allocator().resource();
+  }
+
+  /**
+   * @brief Get the precomputed arguments.
+   */
+  const Buffer<std::array<Arg, Dimension>>& args() const
+  {
+    return m_x;
+  }
+
+  /**
+   * @brief Get the mask of the knots which are needed to evaluate the arguments.
+   */
+  const Linx::Mask<Dimension>& mask() const
+  {
+    return m_mask;
+  }
+
+  /**
+   * @brief Get the instrumentation policy.
+   */
+  const TInstrument& instrument() const
+  {
+    return m_instrument;
+  }
+
+  /**
+   * @brief Get the instrumentation policy.
+   */
+  TInstrument& instrument()
+  {
+    return m_instrument;
+  }
+
   /**
    * @brief Resample an input raster of knot values.
    */
   template <typename TRaster>
   std::vector<Value> operator()(const TRaster& v)
   {
+    std::vector<Value> y;
+    y.reserve(m_x.size());
+    transform(v, std::back_inserter(y));
+    return y;
+  }
+
+  /**
+   * @brief Resample an input raster of knot values into an output iterator.
+   * @return The output iterator past the last written value
+   *
+   * This method does not allocate once the splines have been solved once.
+   */
+  template <typename TRaster, typename TOut>
+  TOut transform(const TRaster& v, TOut out)
+  {
+    m_instrument.start(Event::Batch);
     for (const auto& p : m_mask) {
       m_splines0[p[1]].set(p[0], v[p]);
     }
-    std::vector<Value> y;
-    y.reserve(m_x.size());
     const auto max1 = m_spline1.domain().ssize() - 1;
     for (const auto& x : m_x) {
       const auto i1 = x[1].index();
@@ -135,17 +242,53 @@ public:
       for (auto i = min; i <= max; ++i) {
         m_spline1.set(i, m_splines0[i](x[0]));
       }
-      y.push_back(m_spline1(x[1]));
+      *out = m_spline1(x[1]);
+      ++out;
     }
-    return y;
+    m_instrument.stop(Event::Batch);
+    return out;
   }
 
 private:
 
-  std::vector<Method> m_splines0; ///< Splines along axis 0
+  /**
+   * @brief Create the splines along axis 0, one per knot along axis 1, in the resource.
+   *
+   * The splines are constructed in place, because copies would not be allocated from the resource.
+   */
+  void init_splines0(const Domain& domain0)
+  {
+    const auto resource = m_x.get_allocator().resource();
+    const auto size = m_spline1.domain().size();
+    m_splines0.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      m_splines0.emplace_back(domain0, resource);
+    }
+  }
+
+  /**
+   * @brief Mark the knots which are needed to evaluate the splines at a given argument.
+   */
+  void mark(const std::array<Arg, Dimension>& xi)
+  {
+    const auto i0 = xi[0].index();
+    const auto i1 = xi[1].index();
+    const auto min0 = std::max(i0 - 1, 0L);
+    const auto max0 = std::min(i0 + 2, domain(0).ssize() - 1);
+    const auto min1 = std::max(i1 - 1, 0L);
+    const auto max1 = std::min(i1 + 2, domain(1).ssize() - 1);
+    for (auto j1 = min1; j1 <= max1; ++j1) {
+      for (auto j0 = min0; j0 <= max0; ++j0) {
+        m_mask[{j0, j1}] = true;
+      }
+    }
+  }
+
+  Buffer<Method> m_splines0; ///< Splines along axis 0
   Method m_spline1; ///< Spline along axis 1
-  std::vector<std::array<Arg, Dimension>> m_x; ///< The arguments
+  Buffer<std::array<Arg, Dimension>> m_x; ///< The arguments
   Linx::Mask<Dimension> m_mask; ///< The neighboring knot abscissae
+  TInstrument m_instrument; ///< The instrumentation policy
 };
 
 } // namespace Splider
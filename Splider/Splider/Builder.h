@@ -10,6 +10,7 @@
 
 #include <initializer_list>
 #include <iterator>
+#include <vector>
 
 /**
  * @brief Spline builder.
@@ -64,7 +65,7 @@ public:
    */
   inline Arg arg(Real x) const
   {
-    return Method::Arg(m_domain, x);
+    return Arg(m_domain, x);
   }
 
   /**
@@ -99,69 +100,114 @@ public:
     return args(x.begin(), x.end());
   }
 
+  /**
+   * @brief Create multiple arguments at given abscissae, allocated from a memory resource.
+   * @param resource The memory resource of the arguments
+   */
+  template <typename TIt>
+  Buffer<Arg> args(TIt begin, TIt end, Resource* resource) const
+  {
+    Buffer<Arg> out(resource);
+    out.reserve(std::distance(begin, end));
+    for (; begin != end; ++begin) {
+      out.emplace_back(m_domain, *begin);
+    }
+    return out;
+  }
+
+  /**
+   * @brief Create multiple arguments at given abscissae, allocated from a memory resource.
+   */
+  template <typename TX, typename std::enable_if_t<Linx::IsRange<TX>::value>* = nullptr>
+  Buffer<Arg> args(const TX& x, Resource* resource) const
+  {
+    return args(std::begin(x), std::end(x), resource);
+  }
+
+  /**
+   * @brief Create multiple arguments at given abscissae, allocated from a memory resource.
+   */
+  template <typename TX>
+  Buffer<Arg> args(std::initializer_list<TX> x, Resource* resource) const
+  {
+    return args(x.begin(), x.end(), resource);
+  }
+
   /**
    * @brief Create a spline with null knots.
+   * @param resource The memory resource of the spline
    */
-  template <typename TV>
-  auto spline() const
+  template <typename TV, typename TInstrument = NoInstrument>
+  auto spline(Resource* resource = default_resource()) const
   {
-    return typename Method::Spline<Domain, TV, B>(m_domain);
+    return typename Method::Spline<Domain, TV, B, TInstrument>(m_domain, resource);
   }
 
   /**
    * @brief Create a spline with given knot values.
+   * @param resource The memory resource of the spline
    */
-  template <typename TIt>
-  auto spline(TIt begin, TIt end) const
+  template <typename TInstrument = NoInstrument, typename TIt>
+  auto spline(TIt begin, TIt end, Resource* resource = default_resource()) const
   {
     using T = typename std::iterator_traits<TIt>::value_type;
     using Value = std::decay_t<T>;
-    return typename Method::Spline<Domain, Value, B>(m_domain, begin, end);
+    return typename Method::Spline<Domain, Value, B, TInstrument>(m_domain, begin, end, resource);
   }
 
   /**
    * @brief Create a spline with given knot values.
    */
-  template <typename TV, typename std::enable_if_t<Linx::IsRange<TV>::value>* = nullptr>
-  auto spline(const TV& v) const
+  template <
+      typename TInstrument = NoInstrument,
+      typename TV,
+      typename std::enable_if_t<Linx::IsRange<TV>::value>* = nullptr>
+  auto spline(const TV& v, Resource* resource = default_resource()) const
   {
-    return spline(std::begin(v), std::end(v));
+    return spline<TInstrument>(std::begin(v), std::end(v), resource);
   }
 
   /**
    * @brief Create a spline with given knot values.
    */
-  template <typename TV>
+  template <typename TInstrument = NoInstrument, typename TV>
   auto spline(std::initializer_list<TV> v) const
   {
-    return spline(v.begin(), v.end());
+    return spline<TInstrument>(v.begin(), v.end());
   }
 
   /**
    * @brief Create a cospline with given arguments.
+   *
+   * Both the cospline and its cached spline are instrumented with `TInstrument`,
+   * and allocated from `resource`.
    */
-  template <typename TV = Real, typename TIt>
-  auto cospline(TIt begin, TIt end) const
+  template <typename TV = Real, typename TInstrument = NoInstrument, typename TIt>
+  auto cospline(TIt begin, TIt end, Resource* resource = default_resource()) const
   {
-    return Co<typename Method::Spline<Domain, TV, B>>(m_domain, begin, end);
+    return Co<typename Method::Spline<Domain, TV, B, TInstrument>, TInstrument>(m_domain, begin, end, resource);
   }
 
   /**
    * @brief Create a cospline with given arguments.
    */
-  template <typename TV = Real, typename TX, typename std::enable_if_t<Linx::IsRange<TX>::value>* = nullptr>
-  auto cospline(const TX& x) const
+  template <
+      typename TV = Real,
+      typename TInstrument = NoInstrument,
+      typename TX,
+      typename std::enable_if_t<Linx::IsRange<TX>::value>* = nullptr>
+  auto cospline(const TX& x, Resource* resource = default_resource()) const
   {
-    return cospline<TV>(std::begin(x), std::end(x));
+    return cospline<TV, TInstrument>(std::begin(x), std::end(x), resource);
   }
 
   /**
    * @brief Create a cospline with given arguments.
    */
-  template <typename TV = Real, typename TX>
-  auto cospline(std::initializer_list<TX> x) const
+  template <typename TV = Real, typename TInstrument = NoInstrument, typename TX>
+  auto cospline(std::initializer_list<TX> x, Resource* resource = default_resource()) const
   {
-    return cospline<TV>(x.begin(), x.end());
+    return cospline<TV, TInstrument>(x.begin(), x.end(), resource);
   }
 
 private:
@@ -22,9 +22,10 @@ enum class C2Bounds {
 /**
  * @brief The \f$C^2\f$ spline evaluator.
  */
-template <typename TDomain, typename TValue, C2Bounds B>
-class C2Spline : public C2SplineMixin<TDomain, TValue, C2Spline<TDomain, TValue, B>> {
-  using Mixin = C2SplineMixin<TDomain, TValue, C2Spline>;
+template <typename TDomain, typename TValue, C2Bounds B, typename TInstrument = NoInstrument>
+class C2Spline :
+    public C2SplineMixin<TDomain, TValue, C2Spline<TDomain, TValue, B, TInstrument>, TInstrument> {
+  using Mixin = C2SplineMixin<TDomain, TValue, C2Spline, TInstrument>;
 
 public:
 
@@ -32,7 +33,7 @@ public:
    * @brief Constructor.
    */
   template <typename... TParams>
-  C2Spline(TParams&&... params) : Mixin(LINX_FORWARD(params)...)
+  C2Spline(TParams&&... params) : Mixin(LINX_FORWARD(params)...), m_diag(this->resource()), m_rhs(this->resource())
   {}
 
   /**
@@ -41,20 +42,22 @@ public:
   void update(Linx::Index)
   {
     if (Mixin::m_valid) {
+      this->m_instrument.increment(Event::Skip);
       return;
     }
+    this->m_instrument.start(Event::Solve);
 
     const Linx::Index n = this->m_6s.size();
-    std::vector<typename Mixin::Real> diag(n);
-    std::vector<typename Mixin::Value> rhs(n);
+    m_diag.resize(n);
+    m_rhs.resize(n);
 
     // Initialize i = 1 for merging initialization and forward pass
     auto h0 = this->m_domain.length(0);
     auto h1 = this->m_domain.length(1);
     auto dv0 = (this->m_v[1] - this->m_v[0]) / h0;
     auto dv1 = (this->m_v[2] - this->m_v[1]) / h1;
-    diag[1] = 2. * (h0 + h1);
-    rhs[1] = dv1 - dv0;
+    m_diag[1] = 2. * (h0 + h1);
+    m_rhs[1] = dv1 - dv0;
 
     // Initialization and forward pass
     for (Linx::Index i = 2; i < n - 1; ++i) {
@@ -62,23 +65,29 @@ public:
       h1 = this->m_domain.length(i);
       dv0 = dv1;
       dv1 = (this->m_v[i + 1] - this->m_v[i]) / h1;
-      const auto w = h1 / diag[i - 1];
-      diag[i] = 2. * (h0 + h1) - w * h1;
-      rhs[i] = dv1 - dv0 - w * rhs[i - 1];
+      const auto w = h0 / m_diag[i - 1];
+      m_diag[i] = 2. * (h0 + h1) - w * h0;
+      m_rhs[i] = dv1 - dv0 - w * m_rhs[i - 1];
     }
 
     this->m_6s[n - 1] = 0;
 
     // Backward pass
-    this->m_6s[n - 2] = rhs[n - 2] / diag[n - 2];
+    this->m_6s[n - 2] = m_rhs[n - 2] / m_diag[n - 2];
     for (auto i = n - 3; i > 0; --i) {
-      this->m_6s[i] = (rhs[i] - this->m_domain.length(i) * this->m_6s[i + 1]) / diag[i];
+      this->m_6s[i] = (m_rhs[i] - this->m_domain.length(i) * this->m_6s[i + 1]) / m_diag[i];
     }
 
     this->m_6s[0] = 0;
 
     this->m_valid = true;
+    this->m_instrument.stop(Event::Solve);
   }
+
+private:
+
+  Buffer<typename Mixin::Real> m_diag; ///< The diagonal workspace, allocated at first solve
+  Buffer<typename Mixin::Value> m_rhs; ///< The right-hand side workspace, allocated at first solve
 };
 
 /**
@@ -91,6 +100,14 @@ struct C2 : BuilderMixin<C2, C2Bounds> {
    */
   using Bounds = C2Bounds;
 
+  /**
+   * @brief The number of knots around an interval which have a noticeable influence on it.
+   *
+   * The influence of a knot decays by a factor \f$2 - \sqrt{3} \approx 0.27\f$ per knot,
+   * i.e. down to \f$3 \cdot 10^{-5}\f$ after 8 knots.
+   */
+  static constexpr Linx::Index HaloRadius = 8;
+
   /**
    * @brief The knots domain type.
    */
@@ -106,8 +123,8 @@ struct C2 : BuilderMixin<C2, C2Bounds> {
   /**
    * @brief The spline evaluator.
    */
-  template <typename TDomain, typename TValue, C2Bounds B>
-  using Spline = C2Spline<TDomain, TValue, B>;
+  template <typename TDomain, typename TValue, C2Bounds B, typename TInstrument = NoInstrument>
+  using Spline = C2Spline<TDomain, TValue, B, TInstrument>;
 
   struct FiniteDiff;
 };
@@ -115,9 +132,10 @@ struct C2 : BuilderMixin<C2, C2Bounds> {
 /**
  * @brief The \f$C^2\f$ spline evaluator.
  */
-template <typename TDomain, typename TValue, C2Bounds B>
-class FiniteDiffC2Spline : public C2SplineMixin<TDomain, TValue, FiniteDiffC2Spline<TDomain, TValue, B>> {
-  using Mixin = C2SplineMixin<TDomain, TValue, FiniteDiffC2Spline>;
+template <typename TDomain, typename TValue, C2Bounds B, typename TInstrument = NoInstrument>
+class FiniteDiffC2Spline :
+    public C2SplineMixin<TDomain, TValue, FiniteDiffC2Spline<TDomain, TValue, B, TInstrument>, TInstrument> {
+  using Mixin = C2SplineMixin<TDomain, TValue, FiniteDiffC2Spline, TInstrument>;
 
 public:
 
@@ -134,8 +152,10 @@ public:
   void update(Linx::Index) // TODO use index
   {
     if (Mixin::m_valid) {
+      this->m_instrument.increment(Event::Skip);
       return;
     }
+    this->m_instrument.start(Event::Solve);
 
     const Linx::Index n = this->m_6s.size();
 
@@ -153,6 +173,7 @@ public:
     this->m_6s[n - 1] = 0;
 
     this->m_valid = true;
+    this->m_instrument.stop(Event::Solve);
   }
 };
 
@@ -169,6 +190,11 @@ struct C2::FiniteDiff : BuilderMixin<C2::FiniteDiff, C2Bounds> {
    */
   using Bounds = C2Bounds;
 
+  /**
+   * @brief The number of knots around an interval which it depends on, i.e. half the sliding window.
+   */
+  static constexpr Linx::Index HaloRadius = 2;
+
   /**
    * @brief The knots domain type.
    */
@@ -184,8 +210,8 @@ struct C2::FiniteDiff : BuilderMixin<C2::FiniteDiff, C2Bounds> {
   /**
    * @brief The spline evaluator.
    */
-  template <typename TDomain, typename TValue, C2Bounds B>
-  using Spline = FiniteDiffC2Spline<TDomain, TValue, B>;
+  template <typename TDomain, typename TValue, C2Bounds B, typename TInstrument = NoInstrument>
+  using Spline = FiniteDiffC2Spline<TDomain, TValue, B, TInstrument>;
 };
 
 } // namespace Splider
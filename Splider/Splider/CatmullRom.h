@@ -27,10 +27,10 @@ enum class CatmullRomBounds {
 /**
  * @brief The Catmull-Rom spline evaluator.
  */
-template <typename TDomain, typename TValue, CatmullRomBounds B>
+template <typename TDomain, typename TValue, CatmullRomBounds B, typename TInstrument = NoInstrument>
 class UniformCatmullRomSpline :
-    public HermiteSplineMixin<TDomain, TValue, UniformCatmullRomSpline<TDomain, TValue, B>> {
-  using Mixin = HermiteSplineMixin<TDomain, TValue, UniformCatmullRomSpline>;
+    public HermiteSplineMixin<TDomain, TValue, UniformCatmullRomSpline<TDomain, TValue, B, TInstrument>, TInstrument> {
+  using Mixin = HermiteSplineMixin<TDomain, TValue, UniformCatmullRomSpline, TInstrument>;
 
 public:
 
@@ -47,8 +47,10 @@ public:
   void update(Linx::Index) // TODO use index
   {
     if (Mixin::m_valid) {
+      this->m_instrument.increment(Event::Skip);
       return;
     }
+    this->m_instrument.start(Event::Solve);
 
     const Linx::Index n = this->m_d.size();
 
@@ -64,6 +66,7 @@ public:
     this->m_d[n - 1] = (this->m_v[n - 1] - this->m_v[n - 1]) / this->m_domain.length(n - 2);
 
     this->m_valid = true;
+    this->m_instrument.stop(Event::Solve);
   }
 };
 
@@ -77,6 +80,11 @@ struct Hermite::CatmullRom::Uniform : BuilderMixin<Hermite::CatmullRom::Uniform,
    */
   using Bounds = CatmullRomBounds;
 
+  /**
+   * @brief The number of knots around an interval which it depends on, i.e. half the sliding window.
+   */
+  static constexpr Linx::Index HaloRadius = 2;
+
   /**
    * @brief The knots domain type.
    */
@@ -92,8 +100,8 @@ struct Hermite::CatmullRom::Uniform : BuilderMixin<Hermite::CatmullRom::Uniform,
   /**
    * @brief The spline evaluator.
    */
-  template <typename TDomain, typename TValue, CatmullRomBounds B>
-  using Spline = UniformCatmullRomSpline<TDomain, TValue, B>;
+  template <typename TDomain, typename TValue, CatmullRomBounds B, typename TInstrument = NoInstrument>
+  using Spline = UniformCatmullRomSpline<TDomain, TValue, B, TInstrument>;
 };
 
 } // namespace Splider
@@ -6,16 +6,53 @@
 #define _SPLIDER_CO_H
 
 #include "Linx/Base/SeqUtils.h" // IsRange
+#include "Linx/Data/Vector.h" // Index
+#include "Splider/Instrument.h"
+#include "Splider/Memory.h"
 
+#include <algorithm>
 #include <initializer_list>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace Splider {
 
+/**
+ * @brief Tag for constructors from precomputed arguments.
+ */
+struct Precomputed {};
+
+/**
+ * @brief The evaluation order of the arguments of a cospline.
+ *
+ * There is no per-interval kernel: in interval-major order, each argument is still evaluated on its own,
+ * and the knot data of an interval are reused from cache by the consecutive arguments.
+ */
+enum class Traversal {
+  Auto = 0, ///< Interval-major if the arguments are unsorted over a large number of knots
+  Sequential, ///< In argument order
+  IntervalMajor ///< Grouped by knot interval, with the results scattered back to the argument positions
+};
+
 /**
  * @brief Cospline.
+ *
+ * The optional instrumentation policy counts and times argument constructions and resamplings,
+ * while the spline instrumentation is accessed through `spline().instrument()`.
+ *
+ * The arguments and the cached spline are allocated from an optional memory resource.
+ *
+ * Arguments can be evaluated in interval-major order (see `Traversal`):
+ * they are then stored grouped by knot interval with a counting sort at assignment,
+ * and the results are scattered to their positions in the output.
+ * The spline still evaluates the arguments one by one, as in argument order, without a per-interval kernel:
+ * the grouping only makes consecutive arguments read the same knot values and coefficients,
+ * which are then hits in cache instead of random gathers.
  */
-template <typename TSpline>
+template <typename TSpline, typename TInstrument = NoInstrument>
 class Co {
 public:
 
@@ -44,11 +81,19 @@ public:
    */
   using Value = typename Method::Value;
 
+  /**
+   * @brief The instrumentation policy.
+   */
+  using Instrument = TInstrument;
+
   /**
    * @brief Iterator-based constructor.
+   * @param resource The memory resource of the arguments and cached spline
    */
   template <typename TIt>
-  explicit Co(const Domain& domain, TIt begin, TIt end) : m_spline(domain), m_args()
+  explicit Co(const Domain& domain, TIt begin, TIt end, Resource* resource = default_resource()) :
+      m_spline(domain, resource), m_args(resource), m_traversal(Traversal::Auto), m_order(resource),
+      m_values(resource), m_instrument()
   {
     assign(begin, end);
   }
@@ -57,16 +102,41 @@ public:
    * @brief Range-based constructor.
    */
   template <typename TX, typename std::enable_if_t<Linx::IsRange<TX>::value>* = nullptr>
-  explicit Co(const Domain& u, const TX& x) : Co(u, std::begin(x), std::end(x))
+  explicit Co(const Domain& u, const TX& x, Resource* resource = default_resource()) :
+      Co(u, std::begin(x), std::end(x), resource)
   {}
 
   /**
    * @brief List-based constructor.
    */
   template <typename TX>
-  explicit Co(const Domain& u, std::initializer_list<TX> x) : Co(u, x.begin(), x.end())
+  explicit Co(const Domain& u, std::initializer_list<TX> x, Resource* resource = default_resource()) :
+      Co(u, x.begin(), x.end(), resource)
   {}
 
+  /**
+   * @brief Precomputed arguments constructor.
+   *
+   * The arguments must have been computed for the same domain, e.g. by another cospline,
+   * and are given in argument order.
+   * @see `args()`
+   */
+  template <typename TIt>
+  explicit Co(const Domain& domain, Precomputed, TIt begin, TIt end, Resource* resource = default_resource()) :
+      m_spline(domain, resource), m_args(begin, end, resource), m_traversal(Traversal::Auto), m_order(resource),
+      m_values(resource), m_instrument()
+  {
+    reorder();
+  }
+
+  /**
+   * @brief The minimum number of knots for `Traversal::Auto` to select the interval-major order.
+   *
+   * Below, the knot arrays mostly fit in the last-level cache, such that random gathers are cheaper
+   * than the scattering of the results, even when there are many more arguments than knots.
+   */
+  static constexpr std::size_t interval_major_knots = std::size_t(1) << 22;
+
   /**
    * @brief Get the knots abscissae.
    */
@@ -75,18 +145,118 @@ public:
     return m_spline.domain();
   }
 
+  /**
+   * @brief Get the memory resource.
+   */
+  Resource* resource() const
+  {
+    return m_args.get_allocator().resource();
+  }
+
+  /**
+   * @brief Get the number of arguments, i.e. of resampled values.
+   */
+  std::size_t size() const
+  {
+    return m_args.size();
+  }
+
+  /**
+   * @brief Get the precomputed arguments, in storage order.
+   *
+   * The storage order is the argument order, unless the traversal is interval-major.
+   * @see `order()`
+   */
+  const Buffer<Arg>& args() const
+  {
+    return m_args;
+  }
+
+  /**
+   * @brief Get the argument position of each stored argument, or an empty buffer in argument order.
+   */
+  const Buffer<Linx::Index>& order() const
+  {
+    return m_order;
+  }
+
+  /**
+   * @brief Get the requested traversal.
+   */
+  Traversal traversal() const
+  {
+    return m_traversal;
+  }
+
+  /**
+   * @brief Set the traversal, and reorder the arguments accordingly.
+   */
+  void traversal(Traversal traversal)
+  {
+    m_traversal = traversal;
+    reorder();
+  }
+
+  /**
+   * @brief Check whether the arguments are evaluated in interval-major order.
+   *
+   * With `Traversal::Auto`, this depends on the last assigned arguments.
+   */
+  bool is_interval_major() const
+  {
+    return not m_order.empty();
+  }
+
+  /**
+   * @brief Get the cached spline.
+   */
+  const Method& spline() const
+  {
+    return m_spline;
+  }
+
+  /**
+   * @brief Set the software prefetching distance of the cached spline, in number of arguments.
+   * @see `PrefetchMixin::prefetch_distance()`
+   */
+  void prefetch_distance(Linx::Index distance)
+  {
+    m_spline.prefetch_distance(distance);
+  }
+
+  /**
+   * @brief Get the instrumentation policy.
+   */
+  const TInstrument& instrument() const
+  {
+    return m_instrument;
+  }
+
+  /**
+   * @brief Get the instrumentation policy.
+   */
+  TInstrument& instrument()
+  {
+    return m_instrument;
+  }
+
   /**
    * @brief Assign arguments from an iterator.
    */
   template <typename TIt>
   void assign(TIt begin, TIt end)
   {
+    m_instrument.start(Event::Argument);
     m_args.clear();
+    m_order.clear();
     m_args.reserve(std::distance(begin, end));
     const auto& d = domain();
     for (; begin != end; ++begin) {
+      check_range(m_instrument, d, *begin);
       m_args.emplace_back(d, *begin);
     }
+    reorder();
+    m_instrument.stop(Event::Argument, m_args.size());
   }
 
   /**
@@ -113,8 +283,9 @@ public:
   template <typename TIt>
   std::vector<Value> operator()(TIt begin, TIt end)
   {
-    m_spline.assign(begin, end);
-    return m_spline(m_args);
+    std::vector<Value> out(m_args.size());
+    transform(begin, end, out.begin());
+    return out;
   }
 
   /**
@@ -135,10 +306,154 @@ public:
     return operator()(v.begin(), v.end());
   }
 
+  /**
+   * @brief Resample a spline defined by an iterator over knot values into an output iterator.
+   * @return The output iterator past the last written value
+   *
+   * This method does not allocate once the knot values have been assigned once.
+   * In interval-major order, non-random-access output iterators go through an intermediate buffer.
+   */
+  template <typename TIt, typename TOut>
+  TOut transform(TIt begin, TIt end, TOut out)
+  {
+    m_instrument.start(Event::Batch);
+    m_spline.assign(begin, end);
+    if (m_order.empty()) {
+      out = m_spline.transform(m_args.begin(), m_args.end(), out);
+    } else {
+      out = scatter(out);
+    }
+    m_instrument.stop(Event::Batch);
+    return out;
+  }
+
 private:
 
+  /**
+   * @brief Output iterator which writes each value at the argument position of the current stored argument.
+   */
+  template <typename TOut>
+  class Scatter {
+  public:
+    /**
+     * @brief Constructor.
+     */
+    Scatter(TOut out, const Linx::Index* order) : m_out(out), m_order(order) {}
+
+    /**
+     * @brief Get the output element of the current argument.
+     */
+    decltype(auto) operator*() const
+    {
+      return m_out[*m_order];
+    }
+
+    /**
+     * @brief Move to the next argument.
+     */
+    Scatter& operator++()
+    {
+      ++m_order;
+      return *this;
+    }
+
+  private:
+    TOut m_out; ///< The output iterator in argument order
+    const Linx::Index* m_order; ///< The argument position of the current argument
+  };
+
+  /**
+   * @brief Evaluate the arguments in storage order and scatter the values to their argument positions.
+   */
+  template <typename TOut>
+  TOut scatter(TOut out)
+  {
+    using Category = typename std::iterator_traits<TOut>::iterator_category;
+    if constexpr (std::is_base_of<std::random_access_iterator_tag, Category>::value) {
+      m_spline.transform(m_args.begin(), m_args.end(), Scatter<TOut>(out, m_order.data()));
+      return out + m_args.size();
+    } else {
+      m_values.resize(m_args.size());
+      m_spline.transform(m_args.begin(), m_args.end(), Scatter<Value*>(m_values.data(), m_order.data()));
+      return std::copy(m_values.begin(), m_values.end(), out);
+    }
+  }
+
+  /**
+   * @brief Check whether the arguments should be evaluated in interval-major order.
+   */
+  bool requires_interval_major() const
+  {
+    if (m_traversal == Traversal::Sequential || m_args.size() < 2) {
+      return false;
+    }
+    if (m_traversal == Traversal::IntervalMajor) {
+      return true;
+    }
+    if (domain().size() < interval_major_knots) {
+      return false;
+    }
+    return not std::is_sorted(m_args.begin(), m_args.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.index() < rhs.index();
+    });
+  }
+
+  /**
+   * @brief Restore the argument order, and then counting-sort the arguments by interval if required.
+   *
+   * Both permutations are applied in place, cycle by cycle, such that the arguments are not copied to a buffer.
+   */
+  void reorder()
+  {
+    if (not m_order.empty()) {
+      for (std::size_t k = 0; k < m_order.size(); ++k) {
+        while (m_order[k] != static_cast<Linx::Index>(k)) {
+          const auto position = m_order[k];
+          std::swap(m_args[k], m_args[position]);
+          std::swap(m_order[k], m_order[position]);
+        }
+      }
+      m_order.clear();
+    }
+    if (not requires_interval_major()) {
+      return;
+    }
+    Buffer<Linx::Index> offsets(domain().size() + 1, 0, resource());
+    for (const auto& arg : m_args) {
+      ++offsets[arg.index() + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    m_order.resize(m_args.size());
+    for (std::size_t k = 0; k < m_args.size(); ++k) {
+      m_order[k] = -1 - offsets[m_args[k].index()]++; // Negative until the argument at k is placed
+    }
+    for (std::size_t k = 0; k < m_order.size(); ++k) {
+      if (m_order[k] >= 0) {
+        continue;
+      }
+      const Linx::Index first = k;
+      auto arg = m_args[first];
+      auto source = first;
+      auto position = -1 - m_order[first];
+      while (true) {
+        const auto next = m_order[position];
+        std::swap(arg, m_args[position]);
+        m_order[position] = source;
+        if (position == first) {
+          break;
+        }
+        source = position;
+        position = -1 - next;
+      }
+    }
+  }
+
   Method m_spline; ///< The cached spline
-  std::vector<Arg> m_args; ///< The resampling abscissae
+  Buffer<Arg> m_args; ///< The resampling abscissae, in storage order
+  Traversal m_traversal; ///< The requested traversal
+  Buffer<Linx::Index> m_order; ///< The argument position of each stored argument, if interval-major
+  Buffer<Value> m_values; ///< The intermediate values for non-random-access outputs
+  TInstrument m_instrument; ///< The instrumentation policy
 };
 
 } // namespace Splider
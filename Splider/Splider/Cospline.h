@@ -51,21 +51,24 @@ public:
    * @brief Iterator-based constructor.
    */
   template <typename TIt>
-  explicit Cospline(const Domain& domain, TIt begin, TIt end) : m_spline(domain), m_args(domain, begin, end)
+  explicit Cospline(const Domain& domain, TIt begin, TIt end, Resource* resource = default_resource()) :
+      m_spline(domain, resource), m_args(domain, begin, end, resource)
   {}
 
   /**
    * @brief Range-based constructor.
    */
   template <typename TRange>
-  explicit Cospline(const Domain& u, const TRange& x) : Cospline(u, x.begin(), x.end())
+  explicit Cospline(const Domain& u, const TRange& x, Resource* resource = default_resource()) :
+      Cospline(u, x.begin(), x.end(), resource)
   {}
 
   /**
    * @brief List-based constructor.
    */
   template <typename TX>
-  explicit Cospline(const Domain& u, std::initializer_list<TX> x) : Cospline(u, x.begin(), x.end())
+  explicit Cospline(const Domain& u, std::initializer_list<TX> x, Resource* resource = default_resource()) :
+      Cospline(u, x.begin(), x.end(), resource)
   {}
 
   /**
@@ -76,13 +79,21 @@ public:
     return m_spline.domain();
   }
 
+  /**
+   * @brief Set the software prefetching distance of the cached spline, in number of arguments.
+   */
+  void prefetch_distance(Linx::Index distance)
+  {
+    m_spline.prefetch_distance(distance);
+  }
+
   /**
    * @brief Assign arguments from an iterator.
    */
   template <typename TIt>
   void assign(TIt begin, TIt end)
   {
-    m_args = Args<Real>(m_spline.domain(), begin, end);
+    m_args = Args<Real>(m_spline.domain(), begin, end, m_args.resource());
   }
 
   /**
@@ -113,6 +124,17 @@ public:
     return m_spline(m_args);
   }
 
+  /**
+   * @brief Resample a spline defined by an iterator over knot values into an output iterator.
+   * @return The output iterator past the last written value
+   */
+  template <typename TIt, typename TOut>
+  TOut transform(TIt begin, TIt end, TOut out)
+  {
+    m_spline.assign(begin, end);
+    return m_spline.transform(m_args, out);
+  }
+
   /**
    * @brief Resample a spline defined by a range of knot values.
    */
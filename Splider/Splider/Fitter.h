@@ -0,0 +1,508 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDER_FITTER_H
+#define _SPLIDER_FITTER_H
+
+#include "Linx/Base/SeqUtils.h" // IsRange
+#include "Splider/BSpline.h"
+#include "Splider/Memory.h"
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace Splider {
+
+/**
+ * @brief Least-squares fitter of a cubic B-spline to scattered samples.
+ *
+ * Each sample \f$(x, y)\f$ is turned into a `BSplineArg`, whose four local weights
+ * are the only nonzero entries of its row of the design matrix,
+ * such that the normal equations are symmetric with half-bandwidth 3.
+ * They are accumulated in one streaming pass, chunk after chunk, e.g. read from disk,
+ * and the design matrix is never stored: the memory footprint is linear in the number of knots only.
+ * Chunks can be accumulated by several threads, which reduce private normal equations,
+ * and fitters of the same domain can be merged, e.g. after distributed accumulations.
+ * A chunk is accumulated entirely or not at all, e.g. if one of its samples is out of the domain.
+ *
+ * The unknowns are the B-spline coefficients with the mirror bounds of `BSpline`,
+ * such that the fitted spline is exactly a `BSplineSpline`,
+ * and the normal equations are solved by an \f$LDL^T\f$ factorization in \f$O(n)\f$.
+ * An optional second-difference penalty on the coefficients (P-spline) regularizes knots with few samples.
+ */
+template <typename TValue = double, typename TReal = double>
+class Fitter {
+public:
+
+  /**
+   * @brief The knots domain type.
+   */
+  using Domain = Linspace<TReal>;
+
+  /**
+   * @brief The abscissae floating point type.
+   */
+  using Real = TReal;
+
+  /**
+   * @brief The argument type.
+   */
+  using Arg = BSplineArg<Domain>;
+
+  /**
+   * @brief The value type.
+   */
+  using Value = TValue;
+
+  /**
+   * @brief The half-bandwidth of the normal equations.
+   */
+  static constexpr Linx::Index Band = 3;
+
+  /**
+   * @brief The type of the fitted spline.
+   */
+  template <typename TInstrument = NoInstrument>
+  using Spline = BSplineSpline<Domain, Value, BSplineBounds::Mirror, TInstrument>;
+
+  /**
+   * @brief Constructor.
+   * @param front The first knot abscissa
+   * @param step The knot spacing
+   * @param size The number of knots
+   * @param resource The memory resource of the normal equations and fitted values
+   */
+  Fitter(Real front, Real step, Linx::Index size, Resource* resource = default_resource()) :
+      m_domain(front, step, checked(size)), m_normal(size, resource), m_partials(resource), m_d(size, resource),
+      m_l(size * Band, resource), m_c(size, resource), m_v(size, resource), m_fitted(false)
+  {}
+
+  /**
+   * @brief Get the knots domain.
+   */
+  inline const Domain& domain() const
+  {
+    return m_domain;
+  }
+
+  /**
+   * @brief Get the memory resource.
+   */
+  inline Resource* resource() const
+  {
+    return m_c.get_allocator().resource();
+  }
+
+  /**
+   * @brief Get the number of accumulated samples.
+   */
+  inline Linx::Index count() const
+  {
+    return m_normal.count;
+  }
+
+  /**
+   * @brief Reset the normal equations.
+   */
+  void clear()
+  {
+    m_normal.clear();
+    m_fitted = false;
+  }
+
+  /**
+   * @brief Accumulate a chunk of samples with unit weights.
+   * @param x The abscissae, which must lie in the knots domain
+   * @param y The values
+   * @param threads The number of threads
+   */
+  template <
+      typename TX,
+      typename TY,
+      typename std::enable_if_t<Linx::IsRange<TX>::value>* = nullptr,
+      typename std::enable_if_t<Linx::IsRange<TY>::value>* = nullptr>
+  void add(const TX& x, const TY& y, Linx::Index threads = 1)
+  {
+    const auto size = check_size(x, y);
+    const auto xit = std::begin(x);
+    const auto yit = std::begin(y);
+    reduce(size, threads, [&](Normal& normal, Linx::Index begin, Linx::Index end) {
+      for (auto k = begin; k < end; ++k) {
+        accumulate(normal, xit[k], yit[k], Real(1));
+      }
+    });
+  }
+
+  /**
+   * @brief Accumulate a chunk of weighted samples, e.g. with inverse variances.
+   */
+  template <
+      typename TX,
+      typename TY,
+      typename TW,
+      typename std::enable_if_t<Linx::IsRange<TX>::value>* = nullptr,
+      typename std::enable_if_t<Linx::IsRange<TY>::value>* = nullptr,
+      typename std::enable_if_t<Linx::IsRange<TW>::value>* = nullptr>
+  void add(const TX& x, const TY& y, const TW& w, Linx::Index threads = 1)
+  {
+    const auto size = check_size(x, y);
+    if (static_cast<Linx::Index>(std::distance(std::begin(w), std::end(w))) != size) {
+      throw std::runtime_error("Numbers of samples and weights differ.");
+    }
+    const auto xit = std::begin(x);
+    const auto yit = std::begin(y);
+    const auto wit = std::begin(w);
+    reduce(size, threads, [&](Normal& normal, Linx::Index begin, Linx::Index end) {
+      for (auto k = begin; k < end; ++k) {
+        accumulate(normal, xit[k], yit[k], wit[k]);
+      }
+    });
+  }
+
+  /**
+   * @brief Add the normal equations of another fitter of the same domain.
+   */
+  void merge(const Fitter& other)
+  {
+    if (other.m_domain.size() != m_domain.size() || other.m_domain.front() != m_domain.front() ||
+        other.m_domain.length(0) != m_domain.length(0)) {
+      throw std::runtime_error("Cannot merge fitters: domain mismatch.");
+    }
+    m_normal += other.m_normal;
+    m_fitted = false;
+  }
+
+  /**
+   * @brief Solve the normal equations.
+   * @param lambda The weight of the second-difference penalty on the coefficients
+   * @return The fitted knot values
+   */
+  const Buffer<Value>& fit(Real lambda = 0)
+  {
+    if (lambda < 0) {
+      throw std::runtime_error("Penalty weight must be non-negative.");
+    }
+    const auto n = m_domain.ssize();
+
+    // LDL^T factorization of the penalized band
+    for (Linx::Index j = 0; j < n; ++j) {
+      std::array<Real, Band + 1> row; // Row j from column j - Band to j
+      for (Linx::Index d = 0; d <= Band; ++d) {
+        row[Band - d] = j >= d ? entry(j - d, j, lambda) : Real(0);
+      }
+      for (Linx::Index d = Band; d > 0; --d) { // Column k = j - d
+        const auto k = j - d;
+        if (k < 0) {
+          continue;
+        }
+        auto s = row[Band - d];
+        for (Linx::Index e = d + 1; e <= Band && k - (e - d) >= 0; ++e) { // Column p = j - e < k
+          const auto p = j - e;
+          s -= lower(k, k - p) * lower(j, e) * m_d[p];
+        }
+        lower(j, d) = s / m_d[k];
+      }
+      auto s = row[Band];
+      for (Linx::Index d = 1; d <= Band && j - d >= 0; ++d) {
+        s -= lower(j, d) * lower(j, d) * m_d[j - d];
+      }
+      if (not(s > std::numeric_limits<Real>::epsilon() * row[Band])) {
+        throw std::runtime_error("Singular normal equations: not enough samples around some knots.");
+      }
+      m_d[j] = s;
+    }
+
+    // Forward and backward substitutions
+    for (Linx::Index j = 0; j < n; ++j) {
+      auto z = m_normal.aty[j];
+      for (Linx::Index d = 1; d <= Band && j - d >= 0; ++d) {
+        z -= m_c[j - d] * lower(j, d);
+      }
+      m_c[j] = z;
+    }
+    for (auto j = n - 1; j >= 0; --j) {
+      auto z = m_c[j] / m_d[j];
+      for (Linx::Index d = 1; d <= Band && j + d < n; ++d) {
+        z -= m_c[j + d] * lower(j + d, d);
+      }
+      m_c[j] = z;
+    }
+
+    // Knot values
+    for (Linx::Index i = 0; i < n; ++i) {
+      const auto& previous = m_c[i > 0 ? i - 1 : std::min<Linx::Index>(1, n - 1)];
+      const auto& next = m_c[i < n - 1 ? i + 1 : std::max<Linx::Index>(n - 2, 0)];
+      m_v[i] = (previous + m_c[i] * Real(4) + next) / Real(6);
+    }
+    m_fitted = true;
+    return m_v;
+  }
+
+  /**
+   * @brief Get the fitted B-spline coefficients.
+   */
+  inline const Buffer<Value>& coefficients() const
+  {
+    return m_c;
+  }
+
+  /**
+   * @brief Get the fitted knot values.
+   */
+  inline const Buffer<Value>& values() const
+  {
+    return m_v;
+  }
+
+  /**
+   * @brief Create the fitted spline.
+   * @param resource The memory resource of the spline
+   *
+   * The spline references the domain of the fitter, which must outlive it.
+   */
+  template <typename TInstrument = NoInstrument>
+  Spline<TInstrument> spline(Resource* resource = default_resource()) const
+  {
+    if (not m_fitted) {
+      throw std::runtime_error("Spline has not been fitted.");
+    }
+    return Spline<TInstrument>(m_domain, m_v.begin(), m_v.end(), resource);
+  }
+
+private:
+
+  /**
+   * @brief Check that there are enough knots before anything is sized.
+   */
+  static Linx::Index checked(Linx::Index size)
+  {
+    if (size < 2) {
+      throw std::runtime_error("Not enough knots (<2).");
+    }
+    return size;
+  }
+
+  /**
+   * @brief The normal equations.
+   */
+  struct Normal {
+    /**
+     * @brief Constructor.
+     */
+    Normal(Linx::Index size, Resource* resource) : ata(size * (Band + 1), resource), aty(size, resource), count(0) {}
+
+    /**
+     * @brief Reset to zero.
+     */
+    void clear()
+    {
+      std::fill(ata.begin(), ata.end(), Real(0));
+      std::fill(aty.begin(), aty.end(), Value());
+      count = 0;
+    }
+
+    /**
+     * @brief Add other normal equations.
+     */
+    Normal& operator+=(const Normal& other)
+    {
+      for (std::size_t k = 0; k < ata.size(); ++k) {
+        ata[k] += other.ata[k];
+      }
+      for (std::size_t k = 0; k < aty.size(); ++k) {
+        aty[k] += other.aty[k];
+      }
+      count += other.count;
+      return *this;
+    }
+
+    Buffer<Real> ata; ///< The upper band of the normal matrix, row-major, `Band + 1` entries per row
+    Buffer<Value> aty; ///< The right-hand side
+    Linx::Index count; ///< The number of samples
+  };
+
+  /**
+   * @brief Check the sizes of a chunk.
+   */
+  template <typename TX, typename TY>
+  static Linx::Index check_size(const TX& x, const TY& y)
+  {
+    const auto size = std::distance(std::begin(x), std::end(x));
+    if (std::distance(std::begin(y), std::end(y)) != size) {
+      throw std::runtime_error("Numbers of abscissae and values differ.");
+    }
+    return size;
+  }
+
+  /**
+   * @brief Accumulate a chunk, possibly in parallel.
+   *
+   * Each thread accumulates a contiguous block of samples into private normal equations,
+   * which are added to the fitter ones only once all threads have succeeded,
+   * such that a chunk which throws leaves the fitter unchanged.
+   * Errors are rethrown after all threads have joined.
+   */
+  template <typename TFunc>
+  void reduce(Linx::Index size, Linx::Index threads, TFunc&& func)
+  {
+    threads = std::max<Linx::Index>(1, std::min(threads, size / 1024));
+    const auto n = m_domain.ssize();
+    while (static_cast<Linx::Index>(m_partials.size()) < threads) {
+      m_partials.emplace_back(n, resource());
+    }
+    const auto block = (size + threads - 1) / threads;
+    auto work = [&](Linx::Index t) {
+      auto& partial = m_partials[t];
+      partial.clear();
+      const auto begin = std::min(size, t * block);
+      const auto end = std::min(size, begin + block);
+      func(partial, begin, end);
+      partial.count = end - begin;
+    };
+    if (threads <= 1) {
+      work(0);
+    } else {
+      std::vector<std::exception_ptr> errors(threads);
+      std::vector<std::thread> pool;
+      for (Linx::Index t = 1; t < threads; ++t) {
+        pool.emplace_back([&, t]() {
+          try {
+            work(t);
+          } catch (...) {
+            errors[t] = std::current_exception();
+          }
+        });
+      }
+      try {
+        work(0);
+      } catch (...) {
+        errors[0] = std::current_exception();
+      }
+      for (auto& thread : pool) {
+        thread.join();
+      }
+      for (const auto& error : errors) {
+        if (error) {
+          std::rethrow_exception(error);
+        }
+      }
+    }
+    for (Linx::Index t = 0; t < threads; ++t) {
+      m_normal += m_partials[t];
+    }
+    m_fitted = false;
+  }
+
+  /**
+   * @brief Accumulate one sample.
+   *
+   * The weights of the mirrored coefficients are folded onto the coefficients they mirror.
+   */
+  void accumulate(Normal& normal, Real x, const Value& y, Real w) const
+  {
+    if (not(x >= m_domain.front() && x <= m_domain.back())) {
+      throw std::runtime_error("Sample abscissa is out of the knots domain.");
+    }
+    const Arg arg(m_domain, x);
+    const auto n = m_domain.ssize();
+    const auto i = arg.index();
+    auto* ata = normal.ata.data();
+    auto* aty = normal.aty.data();
+    if (i >= 1 && i + 2 < n) {
+      const auto* a = arg.m_w.data();
+      auto* row = ata + (i - 1) * (Band + 1);
+      for (Linx::Index p = 0; p < 4; ++p, row += Band + 1) {
+        const auto wa = w * a[p];
+        for (Linx::Index q = p; q < 4; ++q) {
+          row[q - p] += wa * a[q];
+        }
+        aty[i - 1 + p] += y * wa;
+      }
+      return;
+    }
+    std::array<Linx::Index, 4> j;
+    for (Linx::Index p = 0; p < 4; ++p) {
+      j[p] = fold(i - 1 + p, n);
+    }
+    for (Linx::Index p = 0; p < 4; ++p) {
+      const auto wa = w * arg.m_w[p];
+      for (Linx::Index q = 0; q < 4; ++q) {
+        if (j[q] >= j[p]) {
+          ata[j[p] * (Band + 1) + j[q] - j[p]] += wa * arg.m_w[q];
+        }
+      }
+      aty[j[p]] += y * wa;
+    }
+  }
+
+  /**
+   * @brief Map a padded coefficient index to the index of the coefficient it mirrors.
+   */
+  static Linx::Index fold(Linx::Index j, Linx::Index n)
+  {
+    if (j < 0) {
+      return std::min<Linx::Index>(-j, n - 1);
+    }
+    if (j >= n) {
+      return std::max<Linx::Index>(2 * n - 2 - j, 0);
+    }
+    return j;
+  }
+
+  /**
+   * @brief Get an entry of the penalized normal matrix, for `j <= k`.
+   *
+   * The penalty is \f$\lambda D^T D\f$, where \f$D\f$ is the second-difference matrix of the coefficients.
+   */
+  Real entry(Linx::Index j, Linx::Index k, Real lambda) const
+  {
+    auto out = m_normal.ata[j * (Band + 1) + k - j];
+    if (lambda > 0) {
+      // D has rows r = 1..n-2 with entries (1, -2, 1) at columns r - 1, r, r + 1
+      const auto n = m_domain.ssize();
+      Real penalty = 0;
+      for (auto r = std::max<Linx::Index>(1, k - 1); r <= std::min(n - 2, j + 1); ++r) {
+        penalty += difference(r, j) * difference(r, k);
+      }
+      out += lambda * penalty;
+    }
+    return out;
+  }
+
+  /**
+   * @brief Get the coefficient of column `j` in row `r` of the second-difference matrix.
+   */
+  static Real difference(Linx::Index r, Linx::Index j)
+  {
+    const auto d = j - r;
+    return d == 0 ? Real(-2) : (d == 1 || d == -1 ? Real(1) : Real(0));
+  }
+
+  /**
+   * @brief Get the entry `(j, j - d)` of the unit lower factor.
+   */
+  inline Real& lower(Linx::Index j, Linx::Index d)
+  {
+    return m_l[j * Band + d - 1];
+  }
+
+  Domain m_domain; ///< The knots domain
+  Normal m_normal; ///< The accumulated normal equations
+  Buffer<Normal> m_partials; ///< The per-thread normal equations workspace, allocated at first accumulation
+  Buffer<Real> m_d; ///< The diagonal of D
+  Buffer<Real> m_l; ///< The band of the unit lower factor, `Band` entries per row
+  Buffer<Value> m_c; ///< The fitted B-spline coefficients
+  Buffer<Value> m_v; ///< The fitted knot values
+  bool m_fitted; ///< Whether the fitted values are up to date
+};
+
+} // namespace Splider
+
+#endif
@@ -29,10 +29,10 @@ enum class FiniteDiffHermiteBounds {
 /**
  * @brief The Hermite spline evaluator.
  */
-template <typename TDomain, typename TValue, FiniteDiffHermiteBounds B>
+template <typename TDomain, typename TValue, FiniteDiffHermiteBounds B, typename TInstrument = NoInstrument>
 class FiniteDiffHermiteSpline :
-    public HermiteSplineMixin<TDomain, TValue, FiniteDiffHermiteSpline<TDomain, TValue, B>> {
-  using Mixin = HermiteSplineMixin<TDomain, TValue, FiniteDiffHermiteSpline>;
+    public HermiteSplineMixin<TDomain, TValue, FiniteDiffHermiteSpline<TDomain, TValue, B, TInstrument>, TInstrument> {
+  using Mixin = HermiteSplineMixin<TDomain, TValue, FiniteDiffHermiteSpline, TInstrument>;
 
 public:
 
@@ -49,8 +49,10 @@ public:
   void update(Linx::Index) // TODO use index
   {
     if (Mixin::m_valid) {
+      this->m_instrument.increment(Event::Skip);
       return;
     }
+    this->m_instrument.start(Event::Solve);
 
     const Linx::Index n = this->m_d.size();
 
@@ -68,6 +70,7 @@ public:
     this->m_d[n - 1] = (this->m_v[n - 1] - this->m_v[n - 1]) / this->m_domain.length(n - 2);
 
     this->m_valid = true;
+    this->m_instrument.stop(Event::Solve);
   }
 };
 
@@ -81,6 +84,11 @@ struct Hermite::FiniteDiff : BuilderMixin<Hermite::FiniteDiff, FiniteDiffHermite
    */
   using Bounds = FiniteDiffHermiteBounds;
 
+  /**
+   * @brief The number of knots around an interval which it depends on, i.e. half the sliding window.
+   */
+  static constexpr Linx::Index HaloRadius = 2;
+
   /**
    * @brief The knots domain type.
    */
@@ -96,8 +104,8 @@ struct Hermite::FiniteDiff : BuilderMixin<Hermite::FiniteDiff, FiniteDiffHermite
   /**
    * @brief The spline evaluator.
    */
-  template <typename TDomain, typename TValue, FiniteDiffHermiteBounds B>
-  using Spline = FiniteDiffHermiteSpline<TDomain, TValue, B>;
+  template <typename TDomain, typename TValue, FiniteDiffHermiteBounds B, typename TInstrument = NoInstrument>
+  using Spline = FiniteDiffHermiteSpline<TDomain, TValue, B, TInstrument>;
 };
 
 } // namespace Splider
@@ -0,0 +1,368 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDER_HUGEPAGES_H
+#define _SPLIDER_HUGEPAGES_H
+
+#include "Linx/Data/Vector.h" // Index
+#include "Splider/Memory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#ifdef __linux__
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string>
+#endif
+
+namespace Splider {
+
+/**
+ * @brief The huge page policy of large buffers.
+ */
+enum class HugePages {
+  None = 0, ///< Regular pages, from the upstream resource
+  Transparent, ///< Transparent huge pages, requested with `madvise()`
+  Explicit ///< Pages from the hugetlbfs pool, with a fallback to transparent huge pages if the pool is empty
+};
+
+/**
+ * @brief Get the CPUs which the calling thread is allowed to run on, in increasing order.
+ *
+ * On systems without affinity support, an empty list is returned.
+ */
+inline std::vector<int> available_cpus()
+{
+  std::vector<int> out;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &set)) {
+        out.push_back(cpu);
+      }
+    }
+  }
+#endif
+  return out;
+}
+
+/**
+ * @brief Get the NUMA node of a CPU, or 0 if unknown.
+ *
+ * The node is read from the `nodeN` entry of `/sys/devices/system/cpu/cpuM`.
+ */
+inline int cpu_node(int cpu)
+{
+#ifdef __linux__
+  const auto path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+  if (auto dir = ::opendir(path.c_str())) {
+    int node = 0;
+    while (const auto entry = ::readdir(dir)) {
+      if (std::strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9') {
+        node = std::atoi(entry->d_name + 4);
+        break;
+      }
+    }
+    ::closedir(dir);
+    return node;
+  }
+#endif
+  return 0;
+}
+
+/**
+ * @brief Get the CPUs which the threads of `run_pinned()` are pinned to, indexed by rank.
+ *
+ * These are the `available_cpus()`, interleaved across NUMA nodes:
+ * the first CPU of each node, in increasing node order, then the second CPU of each node, and so on.
+ * With the usual numbering, where the CPUs of a node are consecutive,
+ * consecutive ranks therefore run on different sockets,
+ * such that a few threads use the memory bandwidth of all the nodes.
+ * Without NUMA information, this is `available_cpus()`.
+ */
+inline std::vector<int> rank_cpus()
+{
+  std::vector<std::vector<int>> nodes;
+  for (auto cpu : available_cpus()) {
+    const auto node = static_cast<std::size_t>(cpu_node(cpu));
+    if (node >= nodes.size()) {
+      nodes.resize(node + 1);
+    }
+    nodes[node].push_back(cpu);
+  }
+  std::vector<int> out;
+  for (std::size_t i = 0;; ++i) {
+    bool done = true;
+    for (const auto& node : nodes) {
+      if (i < node.size()) {
+        out.push_back(node[i]);
+        done = false;
+      }
+    }
+    if (done) {
+      break;
+    }
+  }
+  return out;
+}
+
+/**
+ * @brief Run a function in `threads` threads, the thread of rank `t` being pinned to the CPU `cpus[t % cpus.size()]`,
+ * where `cpus` is `rank_cpus()`.
+ * @param threads The number of threads
+ * @param func The function, called as `func(t)` in the thread of rank `t`
+ *
+ * The calling thread is not pinned and only waits.
+ * Therefore, two calls from the same thread with the same number of threads
+ * run the threads of the same rank on the same CPU, and thus on the same NUMA node.
+ * This is how `first_touch()` and `BatchResampler` place pages on the node of the thread which processes them.
+ * Pinning is best effort: if it fails, the threads run unpinned.
+ */
+template <typename TFunc>
+void run_pinned(Linx::Index threads, TFunc&& func)
+{
+  const auto cpus = rank_cpus();
+  std::vector<std::thread> pool;
+  for (Linx::Index t = 0; t < threads; ++t) {
+    pool.emplace_back([&, t]() {
+#ifdef __linux__
+      if (not cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpus[t % cpus.size()], &set);
+        ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+      }
+#endif
+      func(t);
+    });
+  }
+  for (auto& thread : pool) {
+    thread.join();
+  }
+}
+
+/**
+ * @brief Touch a buffer from several threads, such that its pages are backed by the threads' NUMA nodes.
+ * @param data The buffer
+ * @param size The buffer size in bytes
+ * @param threads The number of threads
+ * @param block The number of bytes assigned to a thread before switching to the next one,
+ * or 0 for one contiguous slice per thread
+ *
+ * With the Linux first-touch policy, a page is allocated on the NUMA node of the first thread which writes it.
+ * Blocks are zero-filled by the thread of rank `b % threads` for block `b`, pinned by `run_pinned()`,
+ * such that the pages of block `b` are local to the thread of the same rank in a later `run_pinned()` call.
+ * With a single thread, the buffer is zero-filled by the calling thread, unpinned,
+ * such that its pages are local to the node the caller runs on, like those of a single-threaded `BatchResampler`.
+ */
+inline void first_touch(void* data, std::size_t size, Linx::Index threads, std::size_t block = 0)
+{
+  threads = std::max<Linx::Index>(threads, 1);
+  if (block == 0) {
+    block = (size + threads - 1) / threads;
+  }
+  const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  const auto bytes = static_cast<char*>(data);
+  auto touch = [&](Linx::Index t) {
+    for (auto begin = t * block; begin < size; begin += threads * block) {
+      const auto end = std::min(begin + block, size);
+      for (auto i = begin; i < end; i += page) {
+        bytes[i] = 0;
+      }
+      bytes[end - 1] = 0;
+    }
+  };
+  if (threads == 1) {
+    touch(0);
+    return;
+  }
+  run_pinned(threads, touch);
+}
+
+/**
+ * @brief Memory resource which maps large buffers on huge pages.
+ *
+ * Buffers of at least `threshold` bytes, e.g. the arguments of a `Co` or the knots of a large `Partition`,
+ * are mapped with `mmap()` on 2 MiB boundaries, and backed by huge pages according to the policy,
+ * which reduces TLB misses of random gathers.
+ * They are then first-touched (see `first_touch()`) by `threads` pinned threads, or by the caller if `threads` is 1,
+ * such that the threads of a `BatchResampler` with the same number of threads and a matching block size,
+ * which are pinned the same way, read memory from their own NUMA node.
+ * Smaller buffers are allocated from the upstream resource.
+ *
+ * Huge pages are a hint: if the system cannot provide them, regular pages are used silently,
+ * which can be checked with `huge_bytes()`.
+ *
+ * The resource is thread-safe as long as the upstream resource is.
+ */
+class HugePageResource : public Resource {
+public:
+
+  /**
+   * @brief The huge page size, in bytes.
+   */
+  static constexpr std::size_t PageSize = std::size_t(1) << 21;
+
+  /**
+   * @brief Constructor.
+   * @param policy The huge page policy
+   * @param threads The number of threads which first-touch large buffers
+   * @param block The first-touch block size in bytes, or 0 for contiguous slices
+   * @param threshold The minimum size of large buffers in bytes
+   * @param upstream The resource of small buffers
+   */
+  explicit HugePageResource(
+      HugePages policy,
+      Linx::Index threads = 1,
+      std::size_t block = 0,
+      std::size_t threshold = PageSize,
+      Resource* upstream = default_resource()) :
+      m_policy(policy),
+      m_threads(threads), m_block(block), m_threshold(threshold), m_upstream(upstream), m_mapped_bytes(0),
+      m_huge_bytes(0)
+  {
+    if (threads < 1) {
+      throw std::runtime_error("Number of first-touch threads must be positive.");
+    }
+  }
+
+  /**
+   * @brief Get the huge page policy.
+   */
+  HugePages policy() const
+  {
+    return m_policy;
+  }
+
+  /**
+   * @brief Get the number of bytes mapped since construction, whatever the page size.
+   */
+  std::size_t mapped_bytes() const
+  {
+    return m_mapped_bytes;
+  }
+
+  /**
+   * @brief Get the number of bytes mapped since construction with huge pages,
+   * i.e. from the hugetlbfs pool or with a successful `madvise()`.
+   */
+  std::size_t huge_bytes() const
+  {
+    return m_huge_bytes;
+  }
+
+protected:
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    if (not is_large(bytes) || alignment > PageSize) {
+      return m_upstream->allocate(bytes, alignment);
+    }
+    const auto size = round(bytes);
+    void* data = nullptr;
+    bool huge = false;
+    if (m_policy == HugePages::Explicit) {
+      data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (data == MAP_FAILED) {
+        data = nullptr;
+      } else {
+        huge = true;
+      }
+    }
+    if (not data) {
+      data = map_aligned(size);
+#ifdef MADV_HUGEPAGE
+      huge = ::madvise(data, size, MADV_HUGEPAGE) == 0;
+#endif
+    }
+    first_touch(data, size, m_threads, m_block);
+    m_mapped_bytes += size;
+    if (huge) {
+      m_huge_bytes += size;
+    }
+    return data;
+  }
+
+  void do_deallocate(void* data, std::size_t bytes, std::size_t alignment) override
+  {
+    if (not is_large(bytes) || alignment > PageSize) {
+      m_upstream->deallocate(data, bytes, alignment);
+      return;
+    }
+    ::munmap(data, round(bytes));
+  }
+
+  bool do_is_equal(const Resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+
+private:
+
+  /**
+   * @brief Check whether a buffer is large enough to be mapped.
+   */
+  bool is_large(std::size_t bytes) const
+  {
+    return m_policy != HugePages::None && bytes >= m_threshold;
+  }
+
+  /**
+   * @brief Round a size up to a multiple of the huge page size.
+   */
+  static std::size_t round(std::size_t bytes)
+  {
+    return (bytes + PageSize - 1) / PageSize * PageSize;
+  }
+
+  /**
+   * @brief Map anonymous memory aligned on a huge page boundary.
+   *
+   * A larger region is mapped, and the unaligned head and tail are unmapped.
+   */
+  static void* map_aligned(std::size_t size)
+  {
+    const auto padded = size + PageSize;
+    auto data = ::mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    const auto address = reinterpret_cast<std::uintptr_t>(data);
+    const auto aligned = (address + PageSize - 1) / PageSize * PageSize;
+    const auto head = aligned - address;
+    if (head > 0) {
+      ::munmap(data, head);
+    }
+    const auto tail = padded - head - size;
+    if (tail > 0) {
+      ::munmap(reinterpret_cast<char*>(aligned + size), tail);
+    }
+    return reinterpret_cast<void*>(aligned);
+  }
+
+  HugePages m_policy; ///< The huge page policy
+  Linx::Index m_threads; ///< The number of first-touch threads
+  std::size_t m_block; ///< The first-touch block size
+  std::size_t m_threshold; ///< The minimum size of mapped buffers
+  Resource* m_upstream; ///< The resource of small buffers
+  std::atomic<std::size_t> m_mapped_bytes; ///< The cumulative number of mapped bytes
+  std::atomic<std::size_t> m_huge_bytes; ///< The cumulative number of mapped bytes with huge pages
+};
+
+} // namespace Splider
+
+#endif
@@ -0,0 +1,215 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDER_INSTRUMENT_H
+#define _SPLIDER_INSTRUMENT_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace Splider {
+
+/**
+ * @brief The instrumented events.
+ */
+enum class Event : char {
+  Solve = 0, ///< Actual computation of the knot coefficients by `update()` (timed)
+  Skip, ///< Short-circuit of `update()` because the coefficients are valid
+  Evaluation, ///< Evaluation of the spline on a single argument
+  Batch, ///< Evaluation of the spline on multiple arguments, or resampling by a cospline (timed)
+  Invalidation, ///< Invalidation of valid coefficients by `assign()` or `set()`
+  Argument, ///< Construction of arguments (timed by batch)
+  OutOfRange ///< Argument outside of the knot domain
+};
+
+/**
+ * @brief Disabled instrumentation policy.
+ *
+ * This is the default policy of splines and cosplines.
+ * All the methods are empty and are optimized out by the compiler.
+ */
+struct NoInstrument {
+  /**
+   * @brief Declare the policy as disabled.
+   */
+  static constexpr bool Enabled = false;
+
+  /**
+   * @brief Count an untimed event.
+   */
+  inline void increment(Event, std::size_t = 1) {}
+
+  /**
+   * @brief Start timing an event.
+   */
+  inline void start(Event) {}
+
+  /**
+   * @brief Stop timing an event and count it.
+   */
+  inline void stop(Event, std::size_t = 1) {}
+};
+
+/**
+ * @brief Instrumentation policy which counts events and accumulates the time spent in timed events.
+ *
+ * Instrumented objects are instantiated by setting this class as their `TInstrument` template parameter,
+ * and the counters are exposed by their `instrument()` method, e.g.:
+ *
+ * \code
+ * auto cospline = build.cospline<double, Splider::Instrument>(x);
+ * ...
+ * const auto resamplings = cospline.instrument().count(Splider::Event::Batch);
+ * const auto solves = cospline.spline().instrument().count(Splider::Event::Solve);
+ * \endcode
+ */
+class Instrument {
+public:
+
+  /**
+   * @brief The clock.
+   */
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief The duration type.
+   */
+  using Duration = std::chrono::nanoseconds;
+
+  /**
+   * @brief The number of event types.
+   */
+  static constexpr std::size_t EventCount = static_cast<std::size_t>(Event::OutOfRange) + 1;
+
+  /**
+   * @brief Declare the policy as enabled.
+   */
+  static constexpr bool Enabled = true;
+
+  /**
+   * @brief Get the name of an event.
+   */
+  static const char* name(Event event)
+  {
+    static constexpr std::array<const char*, EventCount> names {
+        "solve",
+        "skip",
+        "evaluation",
+        "batch",
+        "invalidation",
+        "argument",
+        "out_of_range"};
+    return names[index(event)];
+  }
+
+  /**
+   * @brief Constructor.
+   */
+  Instrument() : m_counts {}, m_durations {}, m_starts {} {}
+
+  /**
+   * @brief Count an untimed event.
+   */
+  inline void increment(Event event, std::size_t count = 1)
+  {
+    m_counts[index(event)] += count;
+  }
+
+  /**
+   * @brief Start timing an event.
+   */
+  inline void start(Event event)
+  {
+    m_starts[index(event)] = Clock::now();
+  }
+
+  /**
+   * @brief Stop timing an event and count it.
+   */
+  inline void stop(Event event, std::size_t count = 1)
+  {
+    const auto i = index(event);
+    m_durations[i] += std::chrono::duration_cast<Duration>(Clock::now() - m_starts[i]);
+    m_counts[i] += count;
+  }
+
+  /**
+   * @brief Get the number of occurrences of an event.
+   */
+  inline std::size_t count(Event event) const
+  {
+    return m_counts[index(event)];
+  }
+
+  /**
+   * @brief Get the time spent in an event.
+   */
+  inline Duration duration(Event event) const
+  {
+    return m_durations[index(event)];
+  }
+
+  /**
+   * @brief Reset the counters.
+   */
+  void reset()
+  {
+    m_counts.fill(0);
+    m_durations.fill(Duration::zero());
+  }
+
+  /**
+   * @brief Accumulate the counters of another instrument, e.g. for aggregating multiple objects.
+   */
+  Instrument& operator+=(const Instrument& rhs)
+  {
+    for (std::size_t i = 0; i < EventCount; ++i) {
+      m_counts[i] += rhs.m_counts[i];
+      m_durations[i] += rhs.m_durations[i];
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Call a function on each event, e.g. for exporting the counters.
+   *
+   * The function takes as parameters the event name, count and duration.
+   */
+  template <typename TFunc>
+  void visit(TFunc&& func) const
+  {
+    for (std::size_t i = 0; i < EventCount; ++i) {
+      func(name(static_cast<Event>(i)), m_counts[i], m_durations[i]);
+    }
+  }
+
+private:
+
+  static constexpr std::size_t index(Event event)
+  {
+    return static_cast<std::size_t>(event);
+  }
+
+  std::array<std::size_t, EventCount> m_counts; ///< The event counts
+  std::array<Duration, EventCount> m_durations; ///< The accumulated durations
+  std::array<Clock::time_point, EventCount> m_starts; ///< The start time points
+};
+
+/**
+ * @brief Count an out-of-range event if the instrumentation is enabled.
+ */
+template <typename TInstrument, typename TDomain, typename TReal>
+inline void check_range(TInstrument& instrument, const TDomain& domain, TReal x)
+{
+  if constexpr (TInstrument::Enabled) {
+    if (x < domain[0] || x > domain[domain.ssize() - 1]) {
+      instrument.increment(Event::OutOfRange);
+    }
+  }
+}
+
+} // namespace Splider
+
+#endif
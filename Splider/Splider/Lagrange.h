@@ -6,9 +6,18 @@
 #define _SPLIDER_LAGRANGE_H
 
 #include "Linx/Base/SeqUtils.h" // IsRange
+#include "Splider/Instrument.h"
+#include "Splider/Memory.h"
 #include "Splider/Partition.h" // TODO rm
+#include "Splider/Polynomial.h"
+#include "Splider/Prefetch.h"
 #include "Splider/mixins/Builder.h"
 
+#include <algorithm>
+#include <iterator>
+#include <numeric> // inner_product
+#include <stdexcept>
+
 namespace Splider {
 
 /**
@@ -20,7 +29,7 @@ enum class LagrangeBounds {
 
 template <typename TDomain>
 class LagrangeArg {
-  template <typename, typename, LagrangeBounds>
+  template <typename, typename, LagrangeBounds, typename>
   friend class LagrangeSpline;
 
 public:
@@ -72,8 +81,10 @@ private:
 /**
  * @brief The spline evaluator.
  */
-template <typename TDomain, typename T, LagrangeBounds B>
-class LagrangeSpline {
+template <typename TDomain, typename T, LagrangeBounds B, typename TInstrument = NoInstrument>
+class LagrangeSpline : public PowerBasisMixin<LagrangeSpline<TDomain, T, B, TInstrument>>, public PrefetchMixin {
+  friend PowerBasisMixin<LagrangeSpline>;
+
 public:
 
   /**
@@ -98,14 +109,18 @@ public:
 
   /**
    * @brief Null knots constructor.
+   * @param resource The memory resource of the knot values
    */
-  explicit LagrangeSpline(const Domain& u) : m_domain(u), m_v(m_domain.size()) {}
+  explicit LagrangeSpline(const Domain& u, Resource* resource = default_resource()) :
+      m_domain(u), m_v(m_domain.size(), resource), m_instrument()
+  {}
 
   /**
    * @brief Iterator-based constructor.
    */
   template <typename TIt>
-  explicit LagrangeSpline(const Domain& u, TIt begin, TIt end) : m_domain(u), m_v(begin, end)
+  explicit LagrangeSpline(const Domain& u, TIt begin, TIt end, Resource* resource = default_resource()) :
+      m_domain(u), m_v(begin, end, resource), m_instrument()
   {}
 
   /**
@@ -130,6 +145,14 @@ public:
     return m_domain;
   }
 
+  /**
+   * @brief Get the memory resource.
+   */
+  inline Resource* resource() const
+  {
+    return m_v.get_allocator().resource();
+  }
+
   /**
    * @brief Assign the knot values.
    */
@@ -165,11 +188,45 @@ public:
     m_v[i] = v;
   }
 
+  /**
+   * @brief Add a scaled spline of the same type and domain, i.e. compute `this = a * x + this`.
+   * @return This spline
+   *
+   * Since the method is linear in the knot values, a linear combination of splines
+   * is evaluated once instead of once per spline.
+   */
+  LagrangeSpline& axpy(Value a, LagrangeSpline& x)
+  {
+    if (x.domain() != m_domain) {
+      throw std::runtime_error("Cannot combine splines: domain mismatch.");
+    }
+    const auto n = m_v.size();
+    for (std::size_t i = 0; i < n; ++i) {
+      m_v[i] += a * x.m_v[i];
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Scale the spline, i.e. compute `this = a * this`.
+   * @return This spline
+   */
+  LagrangeSpline& scale(Value a)
+  {
+    const auto n = m_v.size();
+    for (std::size_t i = 0; i < n; ++i) {
+      m_v[i] *= a;
+    }
+    return *this;
+  }
+
   /**
    * @brief Evaluate the spline for a given argument.
    */
   inline Value operator()(Real x)
   {
+    check_range(m_instrument, m_domain, x);
+    m_instrument.increment(Event::Argument);
     return operator()(Arg(m_domain, x));
   }
 
@@ -179,6 +236,7 @@ public:
   Value operator()(const Arg& arg)
   {
     const auto i = arg.m_i;
+    m_instrument.increment(Event::Evaluation);
     return std::inner_product(arg.m_l.begin(), arg.m_l.end(), &m_v[i - 1], Value());
   }
 
@@ -190,9 +248,7 @@ public:
   {
     std::vector<Value> out;
     out.reserve(std::distance(begin, end));
-    for (; begin != end; ++begin) {
-      out.push_back(operator()(*begin));
-    }
+    transform(begin, end, std::back_inserter(out));
     return out;
   }
 
@@ -214,10 +270,83 @@ public:
     return operator()(x.begin(), x.end());
   }
 
+  /**
+   * @brief Evaluate the spline for multiple arguments into an output iterator.
+   * @return The output iterator past the last written value
+   *
+   * This method does not allocate, and is the preferred entry point for steady-state evaluation.
+   */
+  template <typename TIt, typename TOut>
+  TOut transform(TIt begin, TIt end, TOut out)
+  {
+    m_instrument.start(Event::Batch);
+    out = prefetch_transform<Arg>(
+        begin,
+        end,
+        out,
+        [&](const auto& x) {
+          return (*this)(x);
+        },
+        [&](const Arg& arg) {
+          const auto i = arg.m_i;
+          Splider::prefetch(&m_v[i - 1]);
+          Splider::prefetch(&m_v[i + 2]);
+        });
+    m_instrument.stop(Event::Batch);
+    return out;
+  }
+
+  /**
+   * @brief Do nothing, since the coefficients are computed on the fly.
+   */
+  inline void update(Linx::Index) {}
+
+  /**
+   * @brief Get the instrumentation policy.
+   */
+  inline const TInstrument& instrument() const
+  {
+    return m_instrument;
+  }
+
+  /**
+   * @copydoc instrument()
+   */
+  inline TInstrument& instrument()
+  {
+    return m_instrument;
+  }
+
 protected:
 
+  /**
+   * @brief Get the power-basis coefficients of the i-th subinterval.
+   *
+   * They are obtained by expanding the Newton form of the polynomial of the 4-knot window around the left knot.
+   */
+  std::array<Value, 4> power_coefficients(Linx::Index i) const
+  {
+    const auto w = std::clamp(i, 1L, m_domain.ssize() - 3) - 1;
+    std::array<Value, 4> f {m_v[w], m_v[w + 1], m_v[w + 2], m_v[w + 3]};
+    for (Linx::Index order = 1; order < 4; ++order) { // Divided differences
+      for (Linx::Index k = 3; k >= order; --k) {
+        f[k] = (f[k] - f[k - 1]) / (m_domain[w + k] - m_domain[w + k - order]);
+      }
+    }
+    std::array<Value, 4> p {f[3], Value(), Value(), Value()};
+    for (Linx::Index k = 2; k >= 0; --k) { // p = p * (s - e) + f[k]
+      const auto e = m_domain[w + k] - m_domain[i];
+      for (Linx::Index d = 3; d > 0; --d) {
+        p[d] = p[d - 1] - p[d] * e;
+      }
+      p[0] = f[k] - p[0] * e;
+    }
+    return p;
+  }
+
   const Domain& m_domain; ///< The knots domain
-  std::vector<Value> m_v; ///< The knot values
+  Buffer<Value> m_v; ///< The knot values
+  TInstrument m_instrument; ///< The instrumentation policy
 };
 
 /**
@@ -231,6 +360,16 @@ protected:
  * and the next and previous ones are used, respectively.
  */
 struct Lagrange : BuilderMixin<Lagrange, LagrangeBounds> {
+  /**
+   * @brief The boundary conditions.
+   */
+  using Bounds = LagrangeBounds;
+
+  /**
+   * @brief The number of knots around an interval which it depends on, i.e. half the sliding window.
+   */
+  static constexpr Linx::Index HaloRadius = 2;
+
   /**
    * @brief The knots domain type.
    */
@@ -246,8 +385,8 @@ struct Lagrange : BuilderMixin<Lagrange, LagrangeBounds> {
   /**
    * @brief The spline evaluator.
    */
-  template <typename TDomain, typename T, LagrangeBounds B>
-  using Spline = LagrangeSpline<TDomain, T, B>;
+  template <typename TDomain, typename T, LagrangeBounds B, typename TInstrument = NoInstrument>
+  using Spline = LagrangeSpline<TDomain, T, B, TInstrument>;
 };
 
 } // namespace Splider
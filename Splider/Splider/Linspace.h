@@ -8,6 +8,7 @@
 #include "Linx/Data/Vector.h" // Index
 #include "Splider/Mode.h"
 
+#include <algorithm>
 #include <stdexcept>
 #include <vector>
 
@@ -88,10 +89,12 @@ public:
 
   /**
    * @brief Get the index of the interval which contains a given abscissa.
+   * 
+   * As for `Partition`, the last knot belongs to the last interval.
    */
   Linx::Index index(Value x) const
   {
-    return Linx::Index((x - m_front) / m_h);
+    return std::min(Linx::Index((x - m_front) / m_h), m_ssize - 2);
   }
 
 private:
@@ -0,0 +1,206 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDER_MAPPEDFILE_H
+#define _SPLIDER_MAPPEDFILE_H
+
+#include <algorithm>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace Splider {
+
+/**
+ * @brief A memory-mapped file.
+ *
+ * Pages are loaded lazily by the kernel, such that files larger than the RAM can be processed,
+ * as long as the working set is kept small, e.g. with `release()`.
+ */
+class MappedFile {
+public:
+
+  /**
+   * @brief The access mode.
+   */
+  enum class Mode {
+    Read = 0, ///< Read-only access to an existing file
+    Write ///< Read-write access to a file created or truncated to a given size
+  };
+
+  /**
+   * @brief Map a file.
+   * @param path The file path
+   * @param mode The access mode
+   * @param size The file size in bytes, used in write mode only
+   */
+  explicit MappedFile(const std::string& path, Mode mode = Mode::Read, std::size_t size = 0) :
+      m_path(path), m_mode(mode), m_fd(-1), m_data(nullptr), m_size(0)
+  {
+    const auto flags = mode == Mode::Read ? O_RDONLY : (O_RDWR | O_CREAT | O_TRUNC);
+    m_fd = ::open(path.c_str(), flags, 0644);
+    if (m_fd < 0) {
+      throw std::runtime_error("Cannot open file: " + path);
+    }
+    if (mode == Mode::Write) {
+      if (::ftruncate(m_fd, size) != 0) {
+        close();
+        throw std::runtime_error("Cannot resize file: " + path);
+      }
+      m_size = size;
+    } else {
+      struct stat status;
+      if (::fstat(m_fd, &status) != 0) {
+        close();
+        throw std::runtime_error("Cannot stat file: " + path);
+      }
+      m_size = status.st_size;
+    }
+    if (m_size == 0) {
+      return;
+    }
+    const auto protection = mode == Mode::Read ? PROT_READ : (PROT_READ | PROT_WRITE);
+    auto data = ::mmap(nullptr, m_size, protection, MAP_SHARED, m_fd, 0);
+    if (data == MAP_FAILED) {
+      close();
+      throw std::runtime_error("Cannot map file: " + path);
+    }
+    m_data = static_cast<char*>(data);
+  }
+
+  /**
+   * @brief Non-copyable.
+   */
+  MappedFile(const MappedFile&) = delete;
+
+  /**
+   * @brief Move constructor.
+   */
+  MappedFile(MappedFile&& other) :
+      m_path(std::move(other.m_path)), m_mode(other.m_mode), m_fd(other.m_fd), m_data(other.m_data),
+      m_size(other.m_size)
+  {
+    other.m_fd = -1;
+    other.m_data = nullptr;
+    other.m_size = 0;
+  }
+
+  /**
+   * @brief Non-copyable.
+   */
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /**
+   * @brief Destructor, which unmaps and closes the file.
+   */
+  ~MappedFile()
+  {
+    close();
+  }
+
+  /**
+   * @brief Get the file path.
+   */
+  const std::string& path() const
+  {
+    return m_path;
+  }
+
+  /**
+   * @brief Get the file size in bytes.
+   */
+  std::size_t size() const
+  {
+    return m_size;
+  }
+
+  /**
+   * @brief Get the mapped bytes.
+   */
+  const char* data() const
+  {
+    return m_data;
+  }
+
+  /**
+   * @copydoc data()
+   */
+  char* data()
+  {
+    return m_data;
+  }
+
+  /**
+   * @brief Hint the kernel that the file will be accessed sequentially.
+   */
+  void advise_sequential()
+  {
+    if (m_data) {
+      ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+    }
+  }
+
+  /**
+   * @brief Write the modified pages back to the file.
+   */
+  void sync()
+  {
+    if (m_data && m_mode == Mode::Write) {
+      ::msync(m_data, m_size, MS_SYNC);
+    }
+  }
+
+  /**
+   * @brief Release the pages which are fully contained in a byte range.
+   *
+   * If the range reaches the end of the file, the last, partial page is released too.
+   * Modified pages are written back first.
+   * Released pages are reloaded from the file if accessed again.
+   */
+  void release(std::size_t offset, std::size_t size)
+  {
+    const std::size_t page = ::sysconf(_SC_PAGESIZE);
+    const auto stop = std::min(offset + size, m_size);
+    const auto begin = (offset + page - 1) / page * page;
+    const auto end = stop == m_size ? (stop + page - 1) / page * page : stop / page * page;
+    if (not m_data || end <= begin) {
+      return;
+    }
+    if (m_mode == Mode::Write) {
+      ::msync(m_data + begin, end - begin, MS_SYNC);
+    }
+    ::madvise(m_data + begin, end - begin, MADV_DONTNEED);
+  }
+
+private:
+
+  /**
+   * @brief Unmap and close the file.
+   */
+  void close()
+  {
+    if (m_data) {
+      ::munmap(m_data, m_size);
+      m_data = nullptr;
+    }
+    if (m_fd >= 0) {
+      ::close(m_fd);
+      m_fd = -1;
+    }
+  }
+
+  std::string m_path; ///< The file path
+  Mode m_mode; ///< The access mode
+  int m_fd; ///< The file descriptor
+  char* m_data; ///< The mapped bytes
+  std::size_t m_size; ///< The file size in bytes
+};
+
+} // namespace Splider
+
+#endif
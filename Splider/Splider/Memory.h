@@ -0,0 +1,42 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDER_MEMORY_H
+#define _SPLIDER_MEMORY_H
+
+#include <memory_resource>
+#include <vector>
+
+namespace Splider {
+
+/**
+ * @brief The memory resource from which domains, splines and cosplines allocate their containers.
+ *
+ * All the containers of an object are allocated from the resource it was constructed with,
+ * such that short-lived objects can live in an arena, e.g. a `std::pmr::monotonic_buffer_resource`,
+ * which is released at once.
+ * The resource must outlive the objects.
+ *
+ * Copies are allocated from the default resource, as usual with `std::pmr` containers,
+ * while moves keep the resource.
+ */
+using Resource = std::pmr::memory_resource;
+
+/**
+ * @brief The container type of domains, splines and cosplines.
+ */
+template <typename T>
+using Buffer = std::pmr::vector<T>;
+
+/**
+ * @brief Get the default memory resource, i.e. `std::pmr::get_default_resource()`.
+ */
+inline Resource* default_resource()
+{
+  return std::pmr::get_default_resource();
+}
+
+} // namespace Splider
+
+#endif
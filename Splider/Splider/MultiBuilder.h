@@ -68,30 +68,34 @@ public:
   /**
    * @brief Create a cospline with given arguments.
    */
-  template <typename TV = Real, typename TIt>
-  auto cospline(TIt begin, TIt end) const
+  template <typename TV = Real, typename TInstrument = NoInstrument, typename TIt>
+  auto cospline(TIt begin, TIt end, Resource* resource = default_resource()) const
   {
     static_assert(Dimension == 2, "Case N != 2 not yet implemented.");
     using Spline = typename Method::Spline<Domain, TV, B>;
-    return BiCospline<Spline>(m_domains[0], m_domains[1], begin, end);
+    return BiCospline<Spline, TInstrument>(m_domains[0], m_domains[1], begin, end, resource);
   }
 
   /**
    * @brief Create a cospline with given arguments.
    */
-  template <typename TV = Real, typename TX, typename std::enable_if_t<Linx::IsRange<TX>::value>* = nullptr>
-  auto cospline(const TX& x) const
+  template <
+      typename TV = Real,
+      typename TInstrument = NoInstrument,
+      typename TX,
+      typename std::enable_if_t<Linx::IsRange<TX>::value>* = nullptr>
+  auto cospline(const TX& x, Resource* resource = default_resource()) const
   {
-    return cospline<TV>(std::begin(x), std::end(x));
+    return cospline<TV, TInstrument>(std::begin(x), std::end(x), resource);
   }
 
   /**
    * @brief Create a cospline with given arguments.
    */
-  template <typename TV = Real, typename TX>
-  auto cospline(std::initializer_list<std::array<TX, Dimension>> x) const
+  template <typename TV = Real, typename TInstrument = NoInstrument, typename TX>
+  auto cospline(std::initializer_list<std::array<TX, Dimension>> x, Resource* resource = default_resource()) const
   {
-    return cospline<TV>(x.begin(), x.end());
+    return cospline<TV, TInstrument>(x.begin(), x.end(), resource);
   }
 
 private:
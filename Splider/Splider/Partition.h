@@ -6,6 +6,7 @@
 #define _SPLIDER_PARTITION_H
 
 #include "Linx/Data/Vector.h" // Index
+#include "Splider/Memory.h"
 #include "Splider/Mode.h"
 
 #include <stdexcept>
@@ -35,9 +36,11 @@ public:
 
   /**
    * @brief Iterator-based constructor.
+   * @param resource The memory resource of the knot containers
    */
   template <typename TIt>
-  explicit Partition(TIt begin, TIt end) : m_u(begin, end), m_h(m_u.size() - 1)
+  explicit Partition(TIt begin, TIt end, Resource* resource = default_resource()) :
+      m_u(begin, end, resource), m_h(m_u.size() - 1, resource)
   {
     const auto size = m_h.size();
     if (size < 2) {
@@ -57,13 +60,24 @@ public:
    * @brief Range-based constructor.
    */
   template <typename TRange>
-  explicit Partition(const TRange& u) : Partition(u.begin(), u.end())
+  explicit Partition(const TRange& u, Resource* resource = default_resource()) :
+      Partition(u.begin(), u.end(), resource)
   {}
 
   /**
    * @brief List-based constructor.
    */
-  Partition(std::initializer_list<Value> u) : Partition(u.begin(), u.end()) {}
+  Partition(std::initializer_list<Value> u, Resource* resource = default_resource()) :
+      Partition(u.begin(), u.end(), resource)
+  {}
+
+  /**
+   * @brief Get the memory resource.
+   */
+  Resource* resource() const
+  {
+    return m_u.get_allocator().resource();
+  }
 
   /**
    * @brief Get the number of knots.
@@ -81,6 +95,22 @@ public:
     return static_cast<Linx::Index>(size());
   }
 
+  /**
+   * @brief Check whether two partitions have the same knots.
+   */
+  bool operator==(const Partition& other) const
+  {
+    return this == &other || m_u == other.m_u;
+  }
+
+  /**
+   * @brief Check whether two partitions have different knots.
+   */
+  bool operator!=(const Partition& other) const
+  {
+    return not(*this == other);
+  }
+
   /**
    * @brief Get the abscissa of the i-th knot.
    */
@@ -117,8 +147,8 @@ public:
 
 private:
 
-  std::vector<Value> m_u; ///< The knot positions
-  std::vector<Value> m_h; ///< The knot spacings
+  Buffer<Value> m_u; ///< The knot positions
+  Buffer<Value> m_h; ///< The knot spacings
 };
 
 } // namespace Splider
@@ -0,0 +1,243 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDER_PIPELINE_H
+#define _SPLIDER_PIPELINE_H
+
+#include "Linx/Data/Vector.h" // Index
+
+#include <condition_variable>
+#include <exception>
+#include <initializer_list>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace Splider {
+
+/**
+ * @brief Bounded FIFO of buffer indices, shared between two threads.
+ *
+ * The storage is allocated once at construction.
+ * Closing the queue wakes up all the waiting threads.
+ */
+class SlotQueue {
+public:
+
+  /**
+   * @brief Constructor.
+   */
+  explicit SlotQueue(Linx::Index capacity) : m_slots(capacity), m_front(0), m_size(0), m_closed(false) {}
+
+  /**
+   * @brief Push a slot index, waiting for room if needed.
+   * @return `false` if the queue was closed
+   */
+  bool push(Linx::Index slot)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_not_full.wait(lock, [&]() {
+      return m_closed || m_size < static_cast<Linx::Index>(m_slots.size());
+    });
+    if (m_closed) {
+      return false;
+    }
+    m_slots[(m_front + m_size) % m_slots.size()] = slot;
+    ++m_size;
+    m_not_empty.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Pop a slot index, waiting for one if needed.
+   * @return `false` if the queue was closed and drained
+   */
+  bool pop(Linx::Index& slot)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_not_empty.wait(lock, [&]() {
+      return m_closed || m_size > 0;
+    });
+    if (m_size == 0) {
+      return false;
+    }
+    slot = m_slots[m_front];
+    m_front = (m_front + 1) % m_slots.size();
+    --m_size;
+    m_not_full.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Close the queue.
+   *
+   * Pending slots can still be popped, but no more slots can be pushed.
+   */
+  void close()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_closed = true;
+    m_not_empty.notify_all();
+    m_not_full.notify_all();
+  }
+
+private:
+
+  std::vector<Linx::Index> m_slots; ///< The ring storage
+  Linx::Index m_front; ///< The position of the oldest slot
+  Linx::Index m_size; ///< The number of queued slots
+  bool m_closed; ///< The closing flag
+  std::mutex m_mutex; ///< The lock
+  std::condition_variable m_not_empty; ///< The notifier for consumers
+  std::condition_variable m_not_full; ///< The notifier for producers
+};
+
+/**
+ * @brief Streaming row-wise resampler around a cospline.
+ *
+ * Rows of knot values are resampled by a three-stage pipeline:
+ * a reader thread fills input buffers, the calling thread resamples them,
+ * and a writer thread consumes the output buffers.
+ * Thus, reading row `k + 1`, resampling row `k` and writing row `k - 1` overlap,
+ * and I/O latency is hidden as long as it is shorter than the resampling.
+ *
+ * Buffers are allocated once, as a ring of `depth` slots, and recycled:
+ * the steady state does not allocate.
+ * When all the slots are in use, the fastest stage blocks, which provides backpressure,
+ * such that the memory footprint is bounded whatever the relative speeds of the stages.
+ *
+ * Rows are written in reading order.
+ *
+ * @tparam TCospline The resampler, e.g. `Co`, which must provide `domain()`, `size()` and `transform()`
+ */
+template <typename TCospline>
+class RowPipeline {
+public:
+
+  /**
+   * @brief The knot value type.
+   */
+  using Value = typename TCospline::Value;
+
+  /**
+   * @brief Constructor.
+   * @param cospline The resampler, which is not copied
+   * @param depth The number of buffer slots, at least 3 for the three stages to overlap
+   */
+  explicit RowPipeline(TCospline& cospline, Linx::Index depth = 3) :
+      m_cospline(cospline), m_depth(check_depth(depth)), m_in_size(cospline.domain().size()),
+      m_out_size(cospline.size()), m_inputs(m_depth * m_in_size), m_outputs(m_depth * m_out_size)
+  {}
+
+  /**
+   * @brief Get the number of buffer slots.
+   */
+  Linx::Index depth() const
+  {
+    return m_depth;
+  }
+
+  /**
+   * @brief Process a stream of rows until the reader signals the end.
+   * @param read The reader, called as `bool read(Value* row)` to fill an input row, which returns `false` at end
+   * @param write The writer, called as `void write(const Value* row)` with each output row
+   * @return The number of processed rows
+   *
+   * If a stage throws, the pipeline is stopped and the exception is rethrown in the calling thread.
+   */
+  template <typename TRead, typename TWrite>
+  Linx::Index run(TRead&& read, TWrite&& write)
+  {
+    SlotQueue free(m_depth);
+    SlotQueue filled(m_depth);
+    SlotQueue done(m_depth);
+    for (Linx::Index i = 0; i < m_depth; ++i) {
+      free.push(i);
+    }
+    std::exception_ptr reader_error;
+    std::exception_ptr writer_error;
+
+    std::thread reader([&]() {
+      try {
+        Linx::Index slot;
+        while (free.pop(slot) && read(m_inputs.data() + slot * m_in_size)) {
+          if (not filled.push(slot)) {
+            break; // Worker stopped
+          }
+        }
+      } catch (...) {
+        reader_error = std::current_exception();
+        done.close(); // Stop the writer early
+      }
+      filled.close();
+    });
+
+    std::thread writer([&]() {
+      try {
+        Linx::Index slot;
+        while (done.pop(slot)) {
+          write(static_cast<const Value*>(m_outputs.data() + slot * m_out_size));
+          free.push(slot);
+        }
+      } catch (...) {
+        writer_error = std::current_exception();
+      }
+      free.close(); // Stop the reader
+      done.close(); // Stop the worker
+    });
+
+    Linx::Index count = 0;
+    std::exception_ptr worker_error;
+    try {
+      Linx::Index slot;
+      while (filled.pop(slot)) {
+        const auto in = m_inputs.data() + slot * m_in_size;
+        m_cospline.transform(in, in + m_in_size, m_outputs.data() + slot * m_out_size);
+        if (not done.push(slot)) {
+          break;
+        }
+        ++count;
+      }
+    } catch (...) {
+      worker_error = std::current_exception();
+    }
+    filled.close(); // Stop the reader
+    done.close();
+    free.close(); // In case the worker stopped first
+    writer.join();
+    reader.join();
+
+    for (const auto& error : {reader_error, worker_error, writer_error}) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+    return count;
+  }
+
+private:
+
+  /**
+   * @brief Check that the depth is positive.
+   */
+  static Linx::Index check_depth(Linx::Index depth)
+  {
+    if (depth < 1) {
+      throw std::runtime_error("Pipeline depth must be positive.");
+    }
+    return depth;
+  }
+
+  TCospline& m_cospline; ///< The resampler
+  Linx::Index m_depth; ///< The number of slots
+  Linx::Index m_in_size; ///< The input row length
+  Linx::Index m_out_size; ///< The output row length
+  std::vector<Value> m_inputs; ///< The input buffers
+  std::vector<Value> m_outputs; ///< The output buffers
+};
+
+} // namespace Splider
+
+#endif
@@ -0,0 +1,530 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDER_POLYNOMIAL_H
+#define _SPLIDER_POLYNOMIAL_H
+
+#include "Linx/Base/SeqUtils.h" // IsRange
+#include "Splider/Instrument.h"
+#include "Splider/Memory.h"
+#include "Splider/Prefetch.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional> // greater
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+namespace Splider {
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief Check that knot values are monotonic.
+ * @return True if increasing, false if decreasing
+ */
+template <typename TValues>
+bool check_monotonic(const TValues& v)
+{
+  if (std::is_sorted(v.begin(), v.end())) {
+    return true;
+  }
+  if (std::is_sorted(v.begin(), v.end(), std::greater<>())) {
+    return false;
+  }
+  throw std::runtime_error("Cannot invert non-monotonic spline.");
+}
+
+/**
+ * @brief Get the index of the subinterval whose knot values bracket a target.
+ * @param hint The subinterval of the previous target
+ *
+ * The hint and the next subinterval are tried first, such that sorted targets are located in constant time,
+ * and a binary search is performed otherwise.
+ */
+template <typename TValues, typename T>
+Linx::Index locate(const TValues& v, T y, bool increasing, Linx::Index hint)
+{
+  const auto last = static_cast<Linx::Index>(v.size()) - 2;
+  const auto front = v[0];
+  const auto back = v[last + 1];
+  if (increasing ? (y < front || y > back) : (y > front || y < back)) {
+    throw std::runtime_error("Target is out of the spline range.");
+  }
+  const auto brackets = [&](Linx::Index i) {
+    return increasing ? (v[i] <= y && y <= v[i + 1]) : (v[i] >= y && y >= v[i + 1]);
+  };
+  if (brackets(hint)) {
+    return hint;
+  }
+  if (hint < last && brackets(hint + 1)) {
+    return hint + 1;
+  }
+  const auto it = increasing ? std::upper_bound(v.begin(), v.end(), y) :
+                               std::upper_bound(v.begin(), v.end(), y, std::greater<>());
+  return std::clamp<Linx::Index>(std::distance(v.begin(), it) - 1, 0, last);
+}
+
+/**
+ * @brief Solve `p(s) = y` over `[lo, hi]` for a cubic polynomial whose values at `lo` and `hi` bracket `y`.
+ *
+ * Newton steps are taken from the secant guess, and replaced with bisection steps whenever they leave the bracket.
+ */
+template <typename T>
+T solve_cubic(const std::array<T, 4>& p, T y, T lo, T hi)
+{
+  const auto f = [&](T s) {
+    return ((p[3] * s + p[2]) * s + p[1]) * s + p[0] - y;
+  };
+  const auto flo = f(lo);
+  const auto fhi = f(hi);
+  if (flo == 0) {
+    return lo;
+  }
+  if (fhi == 0) {
+    return hi;
+  }
+  auto negative = flo < 0 ? lo : hi; // Bound where p(s) < y
+  auto positive = flo < 0 ? hi : lo; // Bound where p(s) > y
+  auto s = lo + (hi - lo) * flo / (flo - fhi);
+  const auto tolerance = 4 * std::numeric_limits<T>::epsilon() * std::max(std::abs(lo), std::abs(hi));
+  for (int k = 0; k < 100; ++k) {
+    const auto fs = f(s);
+    if (fs == 0) {
+      return s;
+    }
+    (fs < 0 ? negative : positive) = s;
+    const auto df = (3 * p[3] * s + 2 * p[2]) * s + p[1];
+    auto next = s - fs / df;
+    if (not(next > std::min(negative, positive) && next < std::max(negative, positive))) {
+      next = (negative + positive) / 2;
+    }
+    if (std::abs(next - s) <= tolerance) {
+      return next;
+    }
+    s = next;
+  }
+  return s;
+}
+
+/**
+ * @brief Find the points of a cubic polynomial where the derivative vanishes and changes sign.
+ * @param p The power-basis coefficients
+ * @param h The subinterval length
+ * @param closed Whether `h` is included in the search range, which is `[0, h)` otherwise
+ * @param s The abscissae of the points, in increasing order
+ * @return The number of points, at most 2
+ *
+ * Points within a few ulps of the bounds are snapped to them, such that a point on a knot,
+ * which is computed independently by the cubics on both sides, is found by exactly one of them:
+ * the right one if `closed` is false.
+ */
+template <typename T>
+int critical_points(const std::array<T, 4>& p, T h, bool closed, std::array<T, 2>& s)
+{
+  const auto a = 3 * p[3];
+  const auto b = 2 * p[2];
+  const auto c = p[1];
+  const auto tolerance = 64 * std::numeric_limits<T>::epsilon() * h;
+  int count = 0;
+  const auto keep = [&](T r) {
+    if (std::abs(r) <= tolerance) {
+      r = 0;
+    } else if (std::abs(r - h) <= tolerance) {
+      r = h;
+    }
+    if (r >= 0 && (r < h || (closed && r == h))) {
+      s[count++] = r;
+    }
+  };
+  if (a == 0) {
+    if (b != 0) {
+      keep(-c / b);
+    }
+    return count;
+  }
+  const auto discriminant = b * b - 4 * a * c;
+  if (discriminant <= 0) { // No sign change
+    return 0;
+  }
+  const auto q = -(b + std::copysign(std::sqrt(discriminant), b)) / 2; // Avoid cancellation
+  const auto r0 = q / a;
+  const auto r1 = c / q;
+  keep(std::min(r0, r1));
+  keep(std::max(r0, r1));
+  return count;
+}
+
+/**
+ * @brief Find the roots of `p(s) = y` for a cubic polynomial.
+ * @param end The exact value at `h`, e.g. the right knot value, which avoids missing or duplicating roots at knots
+ * @param closed Whether `h` is included in the search range, which is `[0, h)` otherwise
+ * @param s The roots, in increasing order
+ * @return The number of roots, at most 3
+ *
+ * The range is split into monotonic segments at the critical points, and each bracketed root is refined.
+ */
+template <typename T>
+int cubic_roots(const std::array<T, 4>& p, T y, T h, T end, bool closed, std::array<T, 3>& s)
+{
+  const auto f = [&](T t) {
+    return t == h ? end - y : ((p[3] * t + p[2]) * t + p[1]) * t + p[0] - y;
+  };
+  std::array<T, 2> critical;
+  const auto critical_count = critical_points(p, h, false, critical);
+  std::array<T, 4> cuts {0};
+  int cut_count = 1;
+  for (int k = 0; k < critical_count; ++k) {
+    if (critical[k] > 0) {
+      cuts[cut_count++] = critical[k];
+    }
+  }
+  cuts[cut_count++] = h;
+  int count = 0;
+  for (int k = 1; k < cut_count; ++k) {
+    const auto lo = cuts[k - 1];
+    const auto hi = cuts[k];
+    const auto flo = f(lo);
+    const auto fhi = f(hi);
+    if (flo == 0) {
+      s[count++] = lo;
+    } else if (fhi != 0 && (flo < 0) != (fhi < 0)) {
+      s[count++] = solve_cubic(p, y, lo, hi);
+    }
+  }
+  if (closed && f(h) == 0) {
+    s[count++] = h;
+  }
+  return count;
+}
+
+/**
+ * @brief Integrate a cubic polynomial in power basis over `[0, s]`.
+ */
+template <typename T, typename TReal>
+T integrate_cubic(const std::array<T, 4>& p, TReal s)
+{
+  return (((p[3] * TReal(0.25) * s + p[2] / TReal(3)) * s + p[1] * TReal(0.5)) * s + p[0]) * s;
+}
+
+} // namespace Internal
+/// @endcond
+
+/**
+ * @brief A local extremum of a spline.
+ */
+template <typename TReal, typename TValue>
+struct Extremum {
+  TReal x; ///< The abscissa
+  TValue value; ///< The spline value
+  bool maximum; ///< Whether this is a local maximum, or else a local minimum
+};
+
+/**
+ * @brief A piecewise polynomial argument.
+ *
+ * Contrary to the spline arguments, it does not depend on the method,
+ * and only holds the subinterval index and the distance to the left knot.
+ */
+template <typename TDomain>
+class PolynomialArg {
+  template <typename, typename, typename>
+  friend class PiecewisePolynomial;
+
+public:
+
+  /**
+   * @brief The knots domain type.
+   */
+  using Domain = TDomain;
+
+  /**
+   * @brief The argument floating point type.
+   */
+  using Real = typename Domain::Value;
+
+  /**
+   * @brief Constructor.
+   */
+  PolynomialArg(const Domain& domain, Real x) : m_i(domain.index(x)), m_s(x - domain[m_i]) {}
+
+  /**
+   * @brief Get the subinterval index.
+   */
+  inline Linx::Index index() const
+  {
+    return m_i;
+  }
+
+  /**
+   * @brief Get the distance to the left knot of the subinterval.
+   */
+  inline Real offset() const
+  {
+    return m_s;
+  }
+
+private:
+
+  Linx::Index m_i; ///< The subinterval index
+  Real m_s; ///< The distance to the left knot of the subinterval
+};
+
+/**
+ * @brief Cubic spline in coefficient form, i.e. power-basis coefficients per subinterval.
+ *
+ * Over subinterval `i`, the spline reads \f$a + b s + c s^2 + d s^3\f$,
+ * where \f$s = x - u_i\f$ and the coefficients `{a, b, c, d}` are stored contiguously.
+ * Evaluation is a Horner scheme of three multiply-adds, and the argument is half the size of the spline arguments.
+ *
+ * This is a frozen form: it does not follow the knot values of the spline it was exported from,
+ * and is therefore suited to splines which are evaluated at far more points than they are updated.
+ * Any spline can be exported with its `polynomial()` method, or through `assign()` to reuse the buffer.
+ */
+template <typename TDomain, typename TValue, typename TInstrument = NoInstrument>
+class PiecewisePolynomial : public PrefetchMixin {
+public:
+
+  /**
+   * @brief The knots domain type.
+   */
+  using Domain = TDomain;
+
+  /**
+   * @brief The abscissae floating point type.
+   */
+  using Real = typename Domain::Value;
+
+  /**
+   * @brief The argument type.
+   */
+  using Arg = PolynomialArg<Domain>;
+
+  /**
+   * @brief The knot value type.
+   */
+  using Value = TValue;
+
+  /**
+   * @brief The power-basis coefficients of a subinterval, by increasing degree.
+   */
+  using Coefficients = std::array<Value, 4>;
+
+  /**
+   * @brief Null polynomials constructor.
+   * @param resource The memory resource of the coefficients
+   */
+  explicit PiecewisePolynomial(const Domain& u, Resource* resource = default_resource()) :
+      m_domain(u), m_coefficients(m_domain.size() - 1, Coefficients {}, resource), m_instrument()
+  {}
+
+  /**
+   * @brief Get the knots domain.
+   */
+  inline const Domain& domain() const
+  {
+    return m_domain;
+  }
+
+  /**
+   * @brief Get the memory resource.
+   */
+  inline Resource* resource() const
+  {
+    return m_coefficients.get_allocator().resource();
+  }
+
+  /**
+   * @brief Get the coefficients of all subintervals.
+   */
+  inline const Buffer<Coefficients>& coefficients() const
+  {
+    return m_coefficients;
+  }
+
+  /**
+   * @brief Get the coefficients of the i-th subinterval.
+   */
+  inline const Coefficients& coefficients(Linx::Index i) const
+  {
+    return m_coefficients[i];
+  }
+
+  /**
+   * @brief Set the coefficients of the i-th subinterval.
+   */
+  inline void set(Linx::Index i, const Coefficients& coefficients)
+  {
+    m_coefficients[i] = coefficients;
+  }
+
+  /**
+   * @brief Export a spline, which must be defined over the same domain.
+   *
+   * The spline must provide a `coefficients(i)` method, and is updated if needed.
+   */
+  template <typename TSpline>
+  void assign(TSpline& spline)
+  {
+    const auto& domain = spline.domain();
+    if (domain.size() != m_domain.size()) {
+      throw std::runtime_error("Cannot export spline: domain size mismatch.");
+    }
+    if (static_cast<const void*>(&domain) != static_cast<const void*>(&m_domain)) {
+      for (Linx::Index i = 0; i < m_domain.ssize(); ++i) {
+        if (domain[i] != m_domain[i]) {
+          throw std::runtime_error("Cannot export spline: knot abscissae mismatch.");
+        }
+      }
+    }
+    const auto n = static_cast<Linx::Index>(m_coefficients.size());
+    for (Linx::Index i = 0; i < n; ++i) {
+      m_coefficients[i] = spline.coefficients(i);
+    }
+  }
+
+  /**
+   * @brief Evaluate the spline for a given argument.
+   */
+  inline Value operator()(Real x)
+  {
+    check_range(m_instrument, m_domain, x);
+    m_instrument.increment(Event::Argument);
+    return operator()(Arg(m_domain, x));
+  }
+
+  /**
+   * @brief Evaluate the spline for a given argument.
+   */
+  inline Value operator()(const Arg& arg)
+  {
+    const auto& p = m_coefficients[arg.m_i];
+    const auto s = arg.m_s;
+    m_instrument.increment(Event::Evaluation);
+    return ((p[3] * s + p[2]) * s + p[1]) * s + p[0];
+  }
+
+  /**
+   * @brief Evaluate the spline for multiple arguments.
+   */
+  template <typename TIt>
+  std::vector<Value> operator()(TIt begin, TIt end)
+  {
+    std::vector<Value> out;
+    out.reserve(std::distance(begin, end));
+    transform(begin, end, std::back_inserter(out));
+    return out;
+  }
+
+  /**
+   * @brief Evaluate the spline for multiple arguments.
+   */
+  template <typename TX, typename std::enable_if_t<Linx::IsRange<TX>::value>* = nullptr>
+  std::vector<Value> operator()(const TX& x)
+  {
+    return operator()(std::begin(x), std::end(x));
+  }
+
+  /**
+   * @brief Evaluate the spline for multiple arguments.
+   */
+  template <typename TX>
+  std::vector<Value> operator()(std::initializer_list<TX> x)
+  {
+    return operator()(x.begin(), x.end());
+  }
+
+  /**
+   * @brief Evaluate the spline for multiple arguments into an output iterator.
+   * @return The output iterator past the last written value
+   *
+   * This method does not allocate.
+   */
+  template <typename TIt, typename TOut>
+  TOut transform(TIt begin, TIt end, TOut out)
+  {
+    m_instrument.start(Event::Batch);
+    out = prefetch_transform<Arg>(
+        begin,
+        end,
+        out,
+        [&](const auto& x) {
+          return (*this)(x);
+        },
+        [&](const Arg& arg) {
+          Splider::prefetch(&m_coefficients[arg.m_i]);
+        });
+    m_instrument.stop(Event::Batch);
+    return out;
+  }
+
+  /**
+   * @brief Get the instrumentation policy.
+   */
+  inline const TInstrument& instrument() const
+  {
+    return m_instrument;
+  }
+
+  /**
+   * @copydoc instrument()
+   */
+  inline TInstrument& instrument()
+  {
+    return m_instrument;
+  }
+
+private:
+
+  const Domain& m_domain; ///< The knots domain
+  Buffer<Coefficients> m_coefficients; ///< The coefficients per subinterval
+  TInstrument m_instrument; ///< The instrumentation policy
+};
+
+/**
+ * @brief Mixin for splines which are polynomials in power basis on each subinterval.
+ *
+ * The derived spline provides `update(i)`, which computes its coefficients if needed,
+ * and `power_coefficients(i)`, which returns the coefficients of the i-th subinterval,
+ * assuming the spline is up to date.
+ */
+template <typename TDerived>
+class PowerBasisMixin {
+public:
+
+  /**
+   * @brief Get the power-basis coefficients of the i-th subinterval.
+   *
+   * The polynomial is \f$\sum_k p_k s^k\f$, where \f$s\f$ is the distance to the left knot,
+   * e.g. \f$a + b s + c s^2 + d s^3\f$ for cubic splines.
+   */
+  auto coefficients(Linx::Index i)
+  {
+    auto& self = static_cast<TDerived&>(*this);
+    self.update(i);
+    return self.power_coefficients(i);
+  }
+
+  /**
+   * @brief Export a cubic spline as a piecewise polynomial.
+   * @see `PiecewisePolynomial`
+   */
+  auto polynomial(Resource* resource = default_resource())
+  {
+    auto& self = static_cast<TDerived&>(*this);
+    using Coefficients = decltype(self.power_coefficients(0));
+    static_assert(std::tuple_size<Coefficients>::value == 4, "Only cubic splines can be exported.");
+    PiecewisePolynomial<typename TDerived::Domain, typename TDerived::Value> out(self.domain(), resource);
+    out.assign(self);
+    return out;
+  }
+};
+
+} // namespace Splider
+
+#endif
@@ -0,0 +1,111 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDER_PREFETCH_H
+#define _SPLIDER_PREFETCH_H
+
+#include "Linx/Data/Vector.h" // Index
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace Splider {
+
+/**
+ * @brief Hint the processor to load the cache line of a given address for reading.
+ *
+ * This is a no-op on compilers which do not provide `__builtin_prefetch()`.
+ */
+inline void prefetch(const void* address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address, 0, 3);
+#else
+  (void)address;
+#endif
+}
+
+/**
+ * @brief Check whether an iterator allows looking ahead at precomputed arguments of a given type.
+ *
+ * Software prefetching requires the intervals of the upcoming arguments to be known,
+ * i.e. random-access iterators over precomputed arguments.
+ */
+template <typename TIt, typename TArg>
+constexpr bool can_prefetch()
+{
+  using Traits = std::iterator_traits<TIt>;
+  return std::is_base_of<std::random_access_iterator_tag, typename Traits::iterator_category>::value &&
+      std::is_same<std::decay_t<typename Traits::value_type>, TArg>::value;
+}
+
+/**
+ * @brief Mixin for splines which prefetch the knots of upcoming arguments in batch evaluation.
+ */
+class PrefetchMixin {
+public:
+
+  /**
+   * @brief Get the software prefetching distance, in number of arguments.
+   */
+  inline Linx::Index prefetch_distance() const
+  {
+    return m_prefetch;
+  }
+
+  /**
+   * @brief Set the software prefetching distance, in number of arguments, or 0 to disable prefetching.
+   *
+   * When evaluating precomputed arguments in batch, the knots of the argument `distance` positions ahead
+   * are prefetched, which hides the latency of the random gathers of unsorted arguments.
+   * The optimal distance depends on the machine and on the number of knots, and can be selected by `Autotuner`.
+   */
+  inline void prefetch_distance(Linx::Index distance)
+  {
+    m_prefetch = std::max<Linx::Index>(distance, 0);
+  }
+
+protected:
+
+  /**
+   * @brief Constructor, with prefetching disabled.
+   */
+  PrefetchMixin() : m_prefetch(0) {}
+
+  /**
+   * @brief Evaluate arguments into an output iterator, prefetching the knots of the arguments ahead.
+   * @param eval The evaluator, called as `eval(arg)`
+   * @param prefetch_knots The knot prefetcher, called as `prefetch_knots(arg)` `prefetch_distance()` arguments ahead
+   * @return The output iterator past the last written value
+   *
+   * Prefetching is skipped unless `can_prefetch<TIt, TArg>()`.
+   */
+  template <typename TArg, typename TIt, typename TOut, typename TEval, typename TPrefetch>
+  TOut prefetch_transform(TIt begin, TIt end, TOut out, TEval&& eval, TPrefetch&& prefetch_knots) const
+  {
+    if constexpr (can_prefetch<TIt, TArg>()) {
+      auto ahead = begin + std::min<std::ptrdiff_t>(m_prefetch, end - begin);
+      if (ahead != begin) {
+        for (; ahead != end; ++begin, ++ahead, ++out) {
+          prefetch_knots(*ahead);
+          *out = eval(*begin);
+        }
+      }
+    }
+    for (; begin != end; ++begin, ++out) {
+      *out = eval(*begin);
+    }
+    return out;
+  }
+
+private:
+
+  Linx::Index m_prefetch; ///< The prefetching distance
+};
+
+} // namespace Splider
+
+#endif
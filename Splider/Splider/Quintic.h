@@ -0,0 +1,549 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDER_QUINTIC_H
+#define _SPLIDER_QUINTIC_H
+
+#include "Linx/Base/SeqUtils.h" // IsRange
+#include "Splider/Instrument.h"
+#include "Splider/Memory.h"
+#include "Splider/Partition.h"
+#include "Splider/Polynomial.h"
+#include "Splider/Prefetch.h"
+#include "Splider/mixins/Builder.h"
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace Splider {
+
+/**
+ * @brief The quintic splines boundary conditions.
+ */
+enum class QuinticBounds {
+  Natural = 0 ///< Null second and fourth derivatives at bounds
+};
+
+/**
+ * @brief The knot abscissae of quintic splines, with the factorization of their interpolation system.
+ *
+ * The \f$C^1\f$ and \f$C^3\f$ continuity conditions at the interior knots form a block-tridiagonal system
+ * with 2x2 blocks in the second and fourth derivatives, which only depends on the knot abscissae.
+ * It is factorized once at construction, such that the splines of the domain solve it in two passes,
+ * without allocating nor inverting anything.
+ */
+template <typename TReal = double>
+class QuinticDomain : public Partition<TReal> {
+public:
+
+  /**
+   * @brief The real number type
+   */
+  using Value = TReal;
+
+  /**
+   * @brief The factorization of the block row of a knot.
+   *
+   * With \f$X_i\f$ the vector of the scaled derivatives at knot \f$i\f$ and \f$\Delta_i\f$ the slope difference there,
+   * the forward pass computes \f$G_i = \Delta_i w_i - P_i G_{i-1}\f$,
+   * and the backward pass \f$X_i = G_i - U_i X_{i+1}\f$.
+   */
+  struct Factor {
+    std::array<Value, 2> w; ///< The first column of the inverse pivot block
+    std::array<Value, 4> p; ///< The inverse pivot block times the lower block, row-major
+    std::array<Value, 4> u; ///< The inverse pivot block times the upper block, row-major
+  };
+
+  /**
+   * @brief Iterator-based constructor.
+   * @param resource The memory resource of the knot containers and factorization
+   */
+  template <typename TIt>
+  explicit QuinticDomain(TIt begin, TIt end, Resource* resource = default_resource()) :
+      Partition<Value>(begin, end, resource), m_factors(this->size(), resource)
+  {
+    factorize();
+  }
+
+  /**
+   * @brief Range-based constructor.
+   */
+  template <typename TRange>
+  explicit QuinticDomain(const TRange& u, Resource* resource = default_resource()) :
+      QuinticDomain(u.begin(), u.end(), resource)
+  {}
+
+  /**
+   * @brief List-based constructor.
+   */
+  QuinticDomain(std::initializer_list<Value> u, Resource* resource = default_resource()) :
+      QuinticDomain(u.begin(), u.end(), resource)
+  {}
+
+  /**
+   * @brief Get the factorization of the block row of the i-th knot.
+   */
+  inline const Factor& factor(Linx::Index i) const
+  {
+    return m_factors[i];
+  }
+
+private:
+
+  /**
+   * @brief Factorize the system with the block Thomas algorithm.
+   *
+   * The unknowns are the second derivatives divided by 6 and the fourth derivatives divided by 360,
+   * and the block row of knot `i` is made of the \f$C^1\f$ and \f$C^3\f$ conditions there.
+   */
+  void factorize()
+  {
+    const auto n = this->ssize();
+    m_factors[0] = {};
+    m_factors[n - 1] = {};
+    std::array<Value, 4> u {}; // U_{i-1}
+    for (Linx::Index i = 1; i < n - 1; ++i) {
+      const auto h0 = this->length(i - 1);
+      const auto h1 = this->length(i);
+      const auto h03 = h0 * h0 * h0;
+      const auto h13 = h1 * h1 * h1;
+      const std::array<Value, 4> a {h0, -7 * h03, 1 / h0, -10 * h0};
+      const std::array<Value, 4> c {h1, -7 * h13, 1 / h1, -10 * h1};
+      std::array<Value, 4> s {2 * (h0 + h1), -8 * (h03 + h13), -(1 / h0 + 1 / h1), -20 * (h0 + h1)};
+      if (i > 1) {
+        s[0] -= a[0] * u[0] + a[1] * u[2];
+        s[1] -= a[0] * u[1] + a[1] * u[3];
+        s[2] -= a[2] * u[0] + a[3] * u[2];
+        s[3] -= a[2] * u[1] + a[3] * u[3];
+      }
+      const auto det = s[0] * s[3] - s[1] * s[2];
+      const std::array<Value, 4> inv {s[3] / det, -s[1] / det, -s[2] / det, s[0] / det};
+      auto& f = m_factors[i];
+      f.w = {inv[0], inv[2]};
+      if (i > 1) {
+        f.p = product(inv, a);
+      } else {
+        f.p = {};
+      }
+      f.u = product(inv, c);
+      u = f.u;
+    }
+  }
+
+  /**
+   * @brief Multiply two 2x2 row-major matrices.
+   */
+  static std::array<Value, 4> product(const std::array<Value, 4>& lhs, const std::array<Value, 4>& rhs)
+  {
+    return {
+        lhs[0] * rhs[0] + lhs[1] * rhs[2],
+        lhs[0] * rhs[1] + lhs[1] * rhs[3],
+        lhs[2] * rhs[0] + lhs[3] * rhs[2],
+        lhs[2] * rhs[1] + lhs[3] * rhs[3]};
+  }
+
+  Buffer<Factor> m_factors; ///< The factorization of the block row of each knot
+};
+
+/**
+ * @brief A quintic spline argument.
+ */
+template <typename TDomain>
+class QuinticArg {
+  template <typename, typename, QuinticBounds, typename>
+  friend class QuinticSpline;
+
+public:
+
+  /**
+   * @brief The knots domain type.
+   */
+  using Domain = TDomain;
+
+  /**
+   * @brief The argument floating point type.
+   */
+  using Real = typename Domain::Value;
+
+  /**
+   * @brief Constructor.
+   */
+  explicit QuinticArg(const Domain& domain, Real x)
+  {
+    m_i = domain.index(x);
+    const auto h = domain.length(m_i);
+    const auto left = x - domain[m_i];
+    const auto right = h - left;
+    m_cv0 = right / h;
+    m_cv1 = 1. - m_cv0;
+    m_cm0 = right * (right * m_cv0 - h);
+    m_cm1 = left * (left * m_cv1 - h);
+    m_cr0 = m_cm0 * (3 * right * right - 7 * h * h);
+    m_cr1 = m_cm1 * (3 * left * left - 7 * h * h);
+  }
+
+  /**
+   * @brief Get the subinterval index.
+   */
+  inline Linx::Index index() const
+  {
+    return m_i;
+  }
+
+private:
+
+  Linx::Index m_i; ///< The subinterval index
+  Real m_cv0; ///< The `m_v[i]` coefficient
+  Real m_cv1; ///< The `m_v[i + 1]` coefficient
+  Real m_cm0; ///< The `m_m[i]` coefficient
+  Real m_cm1; ///< The `m_m[i + 1]` coefficient
+  Real m_cr0; ///< The `m_r[i]` coefficient
+  Real m_cr1; ///< The `m_r[i + 1]` coefficient
+};
+
+/**
+ * @brief The quintic spline evaluator.
+ *
+ * On each subinterval, the spline is the quintic determined by the knot values,
+ * second derivatives and fourth derivatives at both ends,
+ * such that it is \f$C^0\f$, \f$C^2\f$ and \f$C^4\f$ by construction,
+ * and the derivatives are solved for \f$C^1\f$ and \f$C^3\f$ continuity with the factorization of the domain.
+ */
+template <typename TDomain, typename TValue, QuinticBounds B, typename TInstrument = NoInstrument>
+class QuinticSpline : public PowerBasisMixin<QuinticSpline<TDomain, TValue, B, TInstrument>>, public PrefetchMixin {
+  friend PowerBasisMixin<QuinticSpline>;
+
+public:
+
+  /**
+   * @brief The knots domain type.
+   */
+  using Domain = TDomain;
+
+  /**
+   * @brief The abscissae floating point type.
+   */
+  using Real = typename Domain::Value;
+
+  /**
+   * @brief The argument type.
+   */
+  using Arg = QuinticArg<Domain>;
+
+  /**
+   * @brief The knot value type.
+   */
+  using Value = TValue;
+
+  /**
+   * @brief Null knots constructor.
+   * @param resource The memory resource of the knot containers
+   */
+  explicit QuinticSpline(const Domain& u, Resource* resource = default_resource()) :
+      m_domain(u), m_v(m_domain.size(), resource), m_m(m_domain.size(), resource), m_r(m_domain.size(), resource),
+      m_valid(true), m_instrument()
+  {}
+
+  /**
+   * @brief Iterator-based constructor.
+   */
+  template <typename TIt>
+  explicit QuinticSpline(const Domain& u, TIt begin, TIt end, Resource* resource = default_resource()) :
+      m_domain(u), m_v(begin, end, resource), m_m(m_v.size(), resource), m_r(m_v.size(), resource), m_valid(false),
+      m_instrument()
+  {}
+
+  /**
+   * @brief Get the knots domain.
+   */
+  inline const Domain& domain() const
+  {
+    return m_domain;
+  }
+
+  /**
+   * @brief Get the memory resource.
+   */
+  inline Resource* resource() const
+  {
+    return m_v.get_allocator().resource();
+  }
+
+  /**
+   * @brief Assign the knot values.
+   */
+  template <typename TIt>
+  void assign(TIt begin, TIt end)
+  {
+    m_v.assign(begin, end);
+    invalidate();
+  }
+
+  /**
+   * @brief Assign the knot values.
+   */
+  template <typename TV, typename std::enable_if_t<Linx::IsRange<TV>::value>* = nullptr>
+  void assign(const TV& v)
+  {
+    assign(std::begin(v), std::end(v));
+  }
+
+  /**
+   * @brief Assign the knot values.
+   */
+  template <typename TV>
+  void assign(std::initializer_list<TV> v)
+  {
+    assign(v.begin(), v.end());
+  }
+
+  /**
+   * @brief Set a knot value.
+   */
+  void set(Linx::Index i, Value v)
+  {
+    m_v[i] = v;
+    invalidate();
+  }
+
+  /**
+   * @brief Solve the block-tridiagonal system with the factorization of the domain.
+   */
+  void update(Linx::Index)
+  {
+    if (m_valid) {
+      m_instrument.increment(Event::Skip);
+      return;
+    }
+    m_instrument.start(Event::Solve);
+
+    const Linx::Index n = m_v.size();
+    m_m[0] = Value();
+    m_r[0] = Value();
+
+    // Forward pass
+    auto dv1 = (m_v[1] - m_v[0]) / m_domain.length(0);
+    for (Linx::Index i = 1; i < n - 1; ++i) {
+      const auto dv0 = dv1;
+      dv1 = (m_v[i + 1] - m_v[i]) / m_domain.length(i);
+      const auto delta = dv1 - dv0;
+      const auto& f = m_domain.factor(i);
+      const auto m = m_m[i - 1];
+      const auto r = m_r[i - 1];
+      m_m[i] = delta * f.w[0] - (m * f.p[0] + r * f.p[1]);
+      m_r[i] = delta * f.w[1] - (m * f.p[2] + r * f.p[3]);
+    }
+
+    m_m[n - 1] = Value();
+    m_r[n - 1] = Value();
+
+    // Backward pass
+    for (auto i = n - 3; i > 0; --i) {
+      const auto& f = m_domain.factor(i);
+      const auto m = m_m[i + 1];
+      const auto r = m_r[i + 1];
+      m_m[i] -= m * f.u[0] + r * f.u[1];
+      m_r[i] -= m * f.u[2] + r * f.u[3];
+    }
+
+    m_valid = true;
+    m_instrument.stop(Event::Solve);
+  }
+
+  /**
+   * @brief Evaluate the spline for a given argument.
+   */
+  inline Value operator()(Real x)
+  {
+    check_range(m_instrument, m_domain, x);
+    m_instrument.increment(Event::Argument);
+    return operator()(Arg(m_domain, x));
+  }
+
+  /**
+   * @brief Evaluate the spline for a given argument.
+   */
+  Value operator()(const Arg& arg)
+  {
+    const auto i = arg.m_i;
+    update(i);
+    m_instrument.increment(Event::Evaluation);
+    return m_v[i] * arg.m_cv0 + m_v[i + 1] * arg.m_cv1 + m_m[i] * arg.m_cm0 + m_m[i + 1] * arg.m_cm1 +
+        m_r[i] * arg.m_cr0 + m_r[i + 1] * arg.m_cr1;
+  }
+
+  /**
+   * @brief Evaluate the spline for multiple arguments.
+   */
+  template <typename TIt>
+  std::vector<Value> operator()(TIt begin, TIt end)
+  {
+    std::vector<Value> out;
+    out.reserve(std::distance(begin, end));
+    transform(begin, end, std::back_inserter(out));
+    return out;
+  }
+
+  /**
+   * @brief Evaluate the spline for multiple arguments.
+   */
+  template <typename TX, typename std::enable_if_t<Linx::IsRange<TX>::value>* = nullptr>
+  std::vector<Value> operator()(const TX& x)
+  {
+    return operator()(std::begin(x), std::end(x));
+  }
+
+  /**
+   * @brief Evaluate the spline for multiple arguments.
+   */
+  template <typename TX>
+  std::vector<Value> operator()(std::initializer_list<TX> x)
+  {
+    return operator()(x.begin(), x.end());
+  }
+
+  /**
+   * @brief Evaluate the spline for multiple arguments into an output iterator.
+   * @return The output iterator past the last written value
+   *
+   * This method does not allocate, and is the preferred entry point for steady-state evaluation.
+   */
+  template <typename TIt, typename TOut>
+  TOut transform(TIt begin, TIt end, TOut out)
+  {
+    m_instrument.start(Event::Batch);
+    out = prefetch_transform<Arg>(
+        begin,
+        end,
+        out,
+        [&](const auto& x) {
+          return (*this)(x);
+        },
+        [&](const Arg& arg) {
+          prefetch_knots(arg);
+        });
+    m_instrument.stop(Event::Batch);
+    return out;
+  }
+
+  /**
+   * @brief Get the instrumentation policy.
+   */
+  inline const TInstrument& instrument() const
+  {
+    return m_instrument;
+  }
+
+  /**
+   * @copydoc instrument()
+   */
+  inline TInstrument& instrument()
+  {
+    return m_instrument;
+  }
+
+protected:
+
+  /**
+   * @brief Get the power-basis coefficients of the i-th subinterval, assuming the spline is up to date.
+   *
+   * The polynomial is \f$\sum_k p_k s^k\f$, where \f$s\f$ is the distance to the left knot.
+   */
+  std::array<Value, 6> power_coefficients(Linx::Index i) const
+  {
+    const auto h = m_domain.length(i);
+    const auto m0 = m_m[i];
+    const auto m1 = m_m[i + 1];
+    const auto r0 = m_r[i];
+    const auto r1 = m_r[i + 1];
+    return {
+        m_v[i],
+        (m_v[i + 1] - m_v[i]) / h - (m0 * Real(2) + m1) * h + (r0 * Real(8) + r1 * Real(7)) * (h * h * h),
+        m0 * Real(3),
+        (m1 - m0) / h - (r0 * Real(2) + r1) * (10 * h),
+        r0 * Real(15),
+        (r1 - r0) * Real(3) / h};
+  }
+
+  /**
+   * @brief Prefetch the knot values and derivatives needed by an argument.
+   */
+  inline void prefetch_knots(const Arg& arg) const
+  {
+    const auto i = arg.m_i;
+    Splider::prefetch(&m_v[i]);
+    Splider::prefetch(&m_v[i + 1]);
+    Splider::prefetch(&m_m[i]);
+    Splider::prefetch(&m_m[i + 1]);
+    Splider::prefetch(&m_r[i]);
+    Splider::prefetch(&m_r[i + 1]);
+  }
+
+  /**
+   * @brief Mark the derivatives as invalid.
+   */
+  inline void invalidate()
+  {
+    if (m_valid) {
+      m_instrument.increment(Event::Invalidation);
+    }
+    m_valid = false;
+  }
+
+  const Domain& m_domain; ///< The knots domain
+  Buffer<Value> m_v; ///< The knot values
+  Buffer<Value> m_m; ///< The knot second derivatives divided by 6
+  Buffer<Value> m_r; ///< The knot fourth derivatives divided by 360
+  bool m_valid; ///< Validity flag
+  TInstrument m_instrument; ///< The instrumentation policy
+};
+
+/**
+ * @ingroup builders
+ * @brief \f$C^4\f$ quintic spline.
+ *
+ * This is the analogue of `C2` for derivative-sensitive applications:
+ * arguments have six coefficients instead of four,
+ * and the interpolation system is factorized once per domain instead of being solved from scratch.
+ */
+struct Quintic : BuilderMixin<Quintic, QuinticBounds> {
+  /**
+   * @brief The boundary conditions.
+   */
+  using Bounds = QuinticBounds;
+
+  /**
+   * @brief The number of knots around an interval which have a noticeable influence on it.
+   *
+   * The influence of a knot decays slower than with `C2`, by a factor \f$\approx 0.43\f$ per knot,
+   * such that more knots are needed to reach the same \f$3 \cdot 10^{-5}\f$ threshold.
+   */
+  static constexpr Linx::Index HaloRadius = 13;
+
+  /**
+   * @brief The knots domain type.
+   */
+  template <typename TReal>
+  using Domain = QuinticDomain<TReal>;
+
+  /**
+   * @brief The argument type.
+   */
+  template <typename TDomain>
+  using Arg = QuinticArg<TDomain>;
+
+  /**
+   * @brief The spline evaluator.
+   */
+  template <typename TDomain, typename TValue, QuinticBounds B, typename TInstrument = NoInstrument>
+  using Spline = QuinticSpline<TDomain, TValue, B, TInstrument>;
+};
+
+} // namespace Splider
+
+#endif
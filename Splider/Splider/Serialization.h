@@ -0,0 +1,748 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDER_SERIALIZATION_H
+#define _SPLIDER_SERIALIZATION_H
+
+#include "Splider/BiSpline.h"
+#include "Splider/Co.h"
+#include "Splider/Linspace.h"
+#include "Splider/MappedFile.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace Splider {
+
+/**
+ * @brief Compute the 64-bit FNV-1a hash of a byte buffer.
+ * @param data The buffer
+ * @param size The buffer size in bytes
+ * @param hash The initial hash, e.g. the hash of a previous buffer, to chain buffers
+ */
+inline std::uint64_t fnv1a(const void* data, std::size_t size, std::uint64_t hash = 14695981039346656037ULL)
+{
+  const auto bytes = static_cast<const unsigned char*>(data);
+  for (std::size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+/**
+ * @brief Compute the checksum of the knot abscissae of a domain.
+ */
+template <typename TDomain>
+std::uint64_t domain_checksum(const TDomain& domain, std::uint64_t hash = 14695981039346656037ULL)
+{
+  for (Linx::Index i = 0; i < domain.ssize(); ++i) {
+    const typename TDomain::Value u = domain[i];
+    hash = fnv1a(&u, sizeof(u), hash);
+  }
+  return hash;
+}
+
+/**
+ * @brief The header of a serialized resampler.
+ *
+ * The file is made of this header, followed by:
+ * - the knot domains, axis after axis, as encoded by `DomainCodec`;
+ * - for bivariate resamplers, the mask of the knots needed by the arguments, one byte per knot, axis 0 first;
+ * - the arguments, 64-byte aligned.
+ *
+ * Arguments are stored as their in-memory representation,
+ * such that the file can only be read by a program built for the same architecture and method.
+ * This is checked thanks to the type and size fields.
+ * The argument type depends on the domain type, such that the domain encoding is checked too.
+ */
+struct CosplineHeader {
+  char magic[8]; ///< The file signature, `SPLIDER`
+  std::uint32_t version; ///< The format version
+  std::uint32_t dimension; ///< The number of axes
+  std::uint64_t type_hash; ///< The hash of the argument type name
+  std::uint64_t arg_size; ///< The size of an argument in bytes
+  std::uint64_t knot_counts[2]; ///< The number of knots along each axis
+  std::uint64_t arg_count; ///< The number of arguments
+  std::uint64_t domain_checksum; ///< The checksum of the knot abscissae
+  std::uint64_t args_checksum; ///< The checksum of the argument bytes
+  std::uint64_t args_offset; ///< The offset of the arguments in bytes
+  std::uint64_t domains_offset; ///< The offset of the knot domains in bytes
+  std::uint64_t mask_offset; ///< The offset of the knot mask in bytes, or 0 if there is none
+  char reserved[32]; ///< Padding to 128 bytes, zero-filled
+
+  /**
+   * @brief The current format version.
+   */
+  static constexpr std::uint32_t current_version = 2;
+
+  /**
+   * @brief The alignment of the arguments in the file.
+   */
+  static constexpr std::uint64_t args_alignment = 64;
+
+  /**
+   * @brief Create a header for a given argument type.
+   */
+  template <typename TArg>
+  static CosplineHeader make(std::uint32_t dimension)
+  {
+    static_assert(std::is_trivially_copyable<TArg>::value, "Arguments must be trivially copyable.");
+    CosplineHeader out;
+    std::memset(&out, 0, sizeof(out));
+    std::memcpy(out.magic, "SPLIDER", 8);
+    out.version = current_version;
+    out.dimension = dimension;
+    const std::string name = typeid(TArg).name();
+    out.type_hash = fnv1a(name.data(), name.size());
+    out.arg_size = sizeof(TArg);
+    out.args_offset = sizeof(CosplineHeader);
+    out.domains_offset = sizeof(CosplineHeader);
+    return out;
+  }
+
+  /**
+   * @brief Check the compatibility of a header read from a file with the expected header.
+   */
+  void check(const CosplineHeader& expected) const
+  {
+    if (std::memcmp(magic, expected.magic, 8) != 0) {
+      throw std::runtime_error("Not a serialized resampler.");
+    }
+    if (version != expected.version) {
+      throw std::runtime_error("Unsupported serialized resampler version: " + std::to_string(version));
+    }
+    if (dimension != expected.dimension || type_hash != expected.type_hash || arg_size != expected.arg_size) {
+      throw std::runtime_error("Serialized resampler type mismatch.");
+    }
+  }
+};
+
+static_assert(sizeof(CosplineHeader) == 128, "Unexpected header size.");
+
+/**
+ * @brief The serialization of a knot domain.
+ *
+ * A domain is stored as the abscissae of its knots, and rebuilt from them,
+ * such that precomputations, e.g. the interval lengths, are redone in linear time.
+ */
+template <typename TDomain>
+struct DomainCodec {
+  /**
+   * @brief The stored real number type.
+   */
+  using Real = typename TDomain::Value;
+
+  /**
+   * @brief Get the number of stored reals of a domain with a given number of knots.
+   */
+  static std::uint64_t size(std::uint64_t knots)
+  {
+    return knots;
+  }
+
+  /**
+   * @brief Get the reals to be stored.
+   */
+  static std::vector<Real> encode(const TDomain& domain)
+  {
+    std::vector<Real> out(domain.size());
+    for (Linx::Index i = 0; i < domain.ssize(); ++i) {
+      out[i] = domain[i];
+    }
+    return out;
+  }
+
+  /**
+   * @brief Rebuild a domain from the stored reals.
+   */
+  static TDomain decode(const Real* data, std::uint64_t knots, Resource* resource)
+  {
+    return TDomain(data, data + knots, resource);
+  }
+};
+
+/**
+ * @brief The serialization of a regular knot domain.
+ *
+ * The first abscissa and the step are stored, such that the knots are recovered exactly.
+ */
+template <typename TReal>
+struct DomainCodec<Linspace<TReal>> {
+  /**
+   * @copydoc DomainCodec::Real
+   */
+  using Real = TReal;
+
+  /**
+   * @copydoc DomainCodec::size()
+   */
+  static std::uint64_t size(std::uint64_t)
+  {
+    return 2;
+  }
+
+  /**
+   * @copydoc DomainCodec::encode()
+   */
+  static std::vector<Real> encode(const Linspace<TReal>& domain)
+  {
+    return {domain.front(), domain.length(0)};
+  }
+
+  /**
+   * @copydoc DomainCodec::decode()
+   */
+  static Linspace<TReal> decode(const Real* data, std::uint64_t knots, Resource*)
+  {
+    return Linspace<TReal>(data[0], data[1], knots);
+  }
+};
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief Append the serialization of a domain to a byte buffer.
+ */
+template <typename TDomain>
+void append_domain(std::vector<char>& bytes, const TDomain& domain)
+{
+  using Real = typename DomainCodec<TDomain>::Real;
+  const auto reals = DomainCodec<TDomain>::encode(domain);
+  const auto data = reinterpret_cast<const char*>(reals.data());
+  bytes.insert(bytes.end(), data, data + reals.size() * sizeof(Real));
+}
+
+/**
+ * @brief Write a header, the domains and mask sections, and the arguments.
+ * @param sections The bytes to be written between the header and the arguments
+ */
+template <typename TArgs>
+void write_cospline(
+    const std::string& path,
+    CosplineHeader header,
+    const std::vector<char>& sections,
+    const TArgs& args)
+{
+  using TArg = typename TArgs::value_type;
+  static_assert(alignof(TArg) <= CosplineHeader::args_alignment, "Unsupported argument alignment.");
+  const auto alignment = CosplineHeader::args_alignment;
+  header.arg_count = args.size();
+  header.args_checksum = fnv1a(args.data(), args.size() * sizeof(TArg));
+  header.args_offset = (sizeof(header) + sections.size() + alignment - 1) / alignment * alignment;
+  const std::vector<char> padding(header.args_offset - sizeof(header) - sections.size(), 0);
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(sections.data(), sections.size());
+  file.write(padding.data(), padding.size());
+  file.write(reinterpret_cast<const char*>(args.data()), args.size() * sizeof(TArg));
+  if (not file) {
+    throw std::runtime_error("Cannot write serialized resampler: " + path);
+  }
+}
+
+} // namespace Internal
+/// @endcond
+
+/**
+ * @brief Save the knot domain and precomputed arguments of a cospline.
+ *
+ * The arguments are saved in argument order, whatever the traversal of the cospline.
+ */
+template <typename TSpline, typename TInstrument>
+void save(const Co<TSpline, TInstrument>& cospline, const std::string& path)
+{
+  using Arg = typename TSpline::Arg;
+  auto header = CosplineHeader::make<Arg>(1);
+  header.knot_counts[0] = cospline.domain().size();
+  header.domain_checksum = domain_checksum(cospline.domain());
+  std::vector<char> sections;
+  Internal::append_domain(sections, cospline.domain());
+  const auto& order = cospline.order();
+  if (order.empty()) {
+    Internal::write_cospline(path, header, sections, cospline.args());
+    return;
+  }
+  std::vector<Arg> args(cospline.args().begin(), cospline.args().end());
+  for (std::size_t k = 0; k < order.size(); ++k) {
+    args[order[k]] = cospline.args()[k];
+  }
+  Internal::write_cospline(path, header, sections, args);
+}
+
+/**
+ * @brief Save the knot domains, knot mask and precomputed arguments of a bivariate cospline.
+ */
+template <typename TSpline, typename TInstrument>
+void save(const BiCospline<TSpline, TInstrument>& cospline, const std::string& path)
+{
+  using Arg = std::array<typename TSpline::Arg, 2>;
+  auto header = CosplineHeader::make<Arg>(2);
+  const auto n0 = cospline.domain(0).size();
+  const auto n1 = cospline.domain(1).size();
+  header.knot_counts[0] = n0;
+  header.knot_counts[1] = n1;
+  header.domain_checksum = domain_checksum(cospline.domain(1), domain_checksum(cospline.domain(0)));
+  std::vector<char> sections;
+  Internal::append_domain(sections, cospline.domain(0));
+  Internal::append_domain(sections, cospline.domain(1));
+  header.mask_offset = sizeof(header) + sections.size();
+  std::vector<char> mask(n0 * n1, 0);
+  for (const auto& p : cospline.mask()) {
+    mask[p[0] + n0 * p[1]] = 1;
+  }
+  sections.insert(sections.end(), mask.begin(), mask.end());
+  Internal::write_cospline(path, header, sections, cospline.args());
+}
+
+/**
+ * @brief Zero-copy view of serialized arguments.
+ *
+ * The file is memory-mapped, such that opening is independent of the number of arguments:
+ * pages are loaded when the arguments are first accessed.
+ * The offsets and sizes of the header are validated before any section is accessed,
+ * such that a corrupted header throws instead of producing an out-of-bounds or misaligned read.
+ */
+template <typename TArg>
+class MappedArgs {
+public:
+
+  /**
+   * @brief Map a file and check its header.
+   * @param path The file path
+   * @param dimension The number of axes
+   */
+  explicit MappedArgs(const std::string& path, std::uint32_t dimension = 1) : m_file(path), m_header()
+  {
+    if (m_file.size() < sizeof(CosplineHeader)) {
+      throw std::runtime_error("Not a serialized resampler: " + path);
+    }
+    std::memcpy(&m_header, m_file.data(), sizeof(m_header));
+    m_header.check(CosplineHeader::make<TArg>(dimension));
+    section(m_header.args_offset, m_header.arg_count, sizeof(TArg), alignof(TArg));
+  }
+
+  /**
+   * @brief Get the header.
+   */
+  const CosplineHeader& header() const
+  {
+    return m_header;
+  }
+
+  /**
+   * @brief Get the number of arguments.
+   */
+  std::size_t size() const
+  {
+    return m_header.arg_count;
+  }
+
+  /**
+   * @brief Iterator to the first argument.
+   */
+  const TArg* begin() const
+  {
+    return reinterpret_cast<const TArg*>(m_file.data() + m_header.args_offset);
+  }
+
+  /**
+   * @brief Iterator past the last argument.
+   */
+  const TArg* end() const
+  {
+    return begin() + size();
+  }
+
+  /**
+   * @brief Rebuild the knot domain along a given axis.
+   *
+   * This is linear in the number of knots only.
+   */
+  template <typename TDomain>
+  TDomain domain(Linx::Index axis, Resource* resource = default_resource()) const
+  {
+    using Codec = DomainCodec<TDomain>;
+    using Real = typename Codec::Real;
+    if (axis < 0 || axis >= static_cast<Linx::Index>(m_header.dimension)) {
+      throw std::runtime_error("Serialized resampler axis out of bounds.");
+    }
+    auto offset = m_header.domains_offset;
+    for (Linx::Index a = 0; a < axis; ++a) {
+      offset += Codec::size(m_header.knot_counts[a]) * sizeof(Real);
+    }
+    const auto count = Codec::size(m_header.knot_counts[axis]);
+    const auto data = section(offset, count, sizeof(Real), alignof(Real));
+    return Codec::decode(reinterpret_cast<const Real*>(data), m_header.knot_counts[axis], resource);
+  }
+
+  /**
+   * @brief Get the mask of the knots which are needed by the arguments of a bivariate resampler.
+   *
+   * The mask has one byte per knot, axis 0 first.
+   */
+  const unsigned char* mask() const
+  {
+    if (m_header.dimension != 2 || m_header.mask_offset == 0) {
+      throw std::runtime_error("Serialized resampler has no knot mask: " + m_file.path());
+    }
+    const auto n0 = m_header.knot_counts[0];
+    const auto n1 = m_header.knot_counts[1];
+    if (n0 != 0 && n1 > std::numeric_limits<std::uint64_t>::max() / n0) {
+      throw std::runtime_error("Corrupted serialized resampler: " + m_file.path());
+    }
+    return reinterpret_cast<const unsigned char*>(section(m_header.mask_offset, n0 * n1, 1, 1));
+  }
+
+  /**
+   * @brief Check that the arguments were computed for given domains, or throw.
+   *
+   * This is linear in the number of knots only.
+   */
+  template <typename TDomain, typename... TDomains>
+  void check(const TDomain& domain, const TDomains&... domains) const
+  {
+    const auto hash = checksum(14695981039346656037ULL, domain, domains...);
+    if (hash != m_header.domain_checksum) {
+      throw std::runtime_error("Serialized resampler was computed for another domain: " + m_file.path());
+    }
+  }
+
+  /**
+   * @brief Check the integrity of the arguments, or throw.
+   *
+   * This reads the whole file, and is therefore optional.
+   */
+  void verify() const
+  {
+    if (fnv1a(begin(), size() * sizeof(TArg)) != m_header.args_checksum) {
+      throw std::runtime_error("Corrupted serialized resampler: " + m_file.path());
+    }
+  }
+
+private:
+
+  /**
+   * @brief Get a section of the file after the header, or throw if it is out of bounds or misaligned.
+   *
+   * The sizes are checked without overflow.
+   */
+  const char* section(std::uint64_t offset, std::uint64_t count, std::size_t size, std::size_t alignment) const
+  {
+    const std::uint64_t file_size = m_file.size();
+    if (offset < sizeof(CosplineHeader) || offset > file_size || offset % alignment != 0) {
+      throw std::runtime_error("Corrupted serialized resampler: " + m_file.path());
+    }
+    if (count > (file_size - offset) / size) {
+      throw std::runtime_error("Truncated serialized resampler: " + m_file.path());
+    }
+    return m_file.data() + offset;
+  }
+
+  template <typename TDomain, typename... TDomains>
+  static std::uint64_t checksum(std::uint64_t hash, const TDomain& domain, const TDomains&... domains)
+  {
+    hash = domain_checksum(domain, hash);
+    if constexpr (sizeof...(TDomains) > 0) {
+      return checksum(hash, domains...);
+    } else {
+      return hash;
+    }
+  }
+
+  MappedFile m_file; ///< The mapped file
+  CosplineHeader m_header; ///< The header
+};
+
+/**
+ * @brief Cospline which evaluates memory-mapped precomputed arguments.
+ *
+ * Contrary to `Co`, the arguments are not copied, such that construction is independent of their number.
+ */
+template <typename TSpline>
+class MappedCo {
+public:
+
+  /**
+   * @brief The spline type.
+   */
+  using Method = TSpline;
+
+  /**
+   * @brief The knot domain type.
+   */
+  using Domain = typename Method::Domain;
+
+  /**
+   * @brief The argument type.
+   */
+  using Arg = typename Method::Arg;
+
+  /**
+   * @brief The knot value type.
+   */
+  using Value = typename Method::Value;
+
+  /**
+   * @brief Map a file saved by `save()` and check that it matches a domain.
+   */
+  MappedCo(const Domain& domain, const std::string& path) : m_args(path, 1), m_domain(), m_spline(domain)
+  {
+    m_args.check(domain);
+  }
+
+  /**
+   * @brief Map a file saved by `save()` and rebuild its domain.
+   * @param resource The memory resource of the domain and spline
+   */
+  explicit MappedCo(const std::string& path, Resource* resource = default_resource()) :
+      m_args(path, 1), m_domain(std::make_unique<Domain>(m_args.template domain<Domain>(0, resource))),
+      m_spline(*m_domain, resource)
+  {
+    m_args.check(*m_domain);
+  }
+
+  /**
+   * @brief Get the knots abscissae.
+   */
+  const Domain& domain() const
+  {
+    return m_spline.domain();
+  }
+
+  /**
+   * @brief Get the number of arguments.
+   */
+  std::size_t size() const
+  {
+    return m_args.size();
+  }
+
+  /**
+   * @brief Get the mapped arguments.
+   */
+  const MappedArgs<Arg>& args() const
+  {
+    return m_args;
+  }
+
+  /**
+   * @brief Resample a spline defined by an iterator over knot values.
+   */
+  template <typename TIt>
+  std::vector<Value> operator()(TIt begin, TIt end)
+  {
+    std::vector<Value> out;
+    out.reserve(m_args.size());
+    transform(begin, end, std::back_inserter(out));
+    return out;
+  }
+
+  /**
+   * @brief Resample a spline defined by a range of knot values.
+   */
+  template <typename TV, typename std::enable_if_t<Linx::IsRange<TV>::value>* = nullptr>
+  std::vector<Value> operator()(const TV& v)
+  {
+    return operator()(std::begin(v), std::end(v));
+  }
+
+  /**
+   * @brief Resample a spline defined by an iterator over knot values into an output iterator.
+   */
+  template <typename TIt, typename TOut>
+  TOut transform(TIt begin, TIt end, TOut out)
+  {
+    m_spline.assign(begin, end);
+    return m_spline.transform(m_args.begin(), m_args.end(), out);
+  }
+
+private:
+
+  MappedArgs<Arg> m_args; ///< The mapped arguments
+  std::unique_ptr<Domain> m_domain; ///< The domain rebuilt from the file, if not provided
+  Method m_spline; ///< The cached spline
+};
+
+/**
+ * @brief Bivariate cospline which evaluates memory-mapped precomputed arguments.
+ *
+ * Contrary to `BiCospline`, the arguments are not copied and the knot mask is read from the file,
+ * such that construction is independent of the number of arguments.
+ */
+template <typename TSpline>
+class MappedBiCo {
+public:
+
+  /**
+   * @brief The dimension.
+   */
+  static constexpr Linx::Index Dimension = 2;
+
+  /**
+   * @brief The spline type.
+   */
+  using Method = TSpline;
+
+  /**
+   * @brief The knot domain type.
+   */
+  using Domain = typename Method::Domain;
+
+  /**
+   * @brief The argument type.
+   */
+  using Arg = typename Method::Arg;
+
+  /**
+   * @brief The knot value type.
+   */
+  using Value = typename Method::Value;
+
+  /**
+   * @brief Map a file saved by `save()` and check that it matches the domains.
+   */
+  MappedBiCo(
+      const Domain& domain0,
+      const Domain& domain1,
+      const std::string& path,
+      Resource* resource = default_resource()) :
+      m_args(path, 2),
+      m_domain0(), m_domain1(), m_splines0(resource), m_spline1(domain1, resource), m_mask(m_args.mask())
+  {
+    m_args.check(domain0, domain1);
+    init_splines0(domain0, resource);
+  }
+
+  /**
+   * @brief Map a file saved by `save()` and rebuild its domains.
+   * @param resource The memory resource of the domains and splines
+   */
+  explicit MappedBiCo(const std::string& path, Resource* resource = default_resource()) :
+      m_args(path, 2), m_domain0(std::make_unique<Domain>(m_args.template domain<Domain>(0, resource))),
+      m_domain1(std::make_unique<Domain>(m_args.template domain<Domain>(1, resource))), m_splines0(resource),
+      m_spline1(*m_domain1, resource), m_mask(m_args.mask())
+  {
+    m_args.check(*m_domain0, *m_domain1);
+    init_splines0(*m_domain0, resource);
+  }
+
+  /**
+   * @brief Get the knot domain along a given axis.
+   */
+  const Domain& domain(Linx::Index axis) const
+  {
+    return axis == 0 ? m_splines0[0].domain() : m_spline1.domain();
+  }
+
+  /**
+   * @brief Get the number of arguments.
+   */
+  std::size_t size() const
+  {
+    return m_args.size();
+  }
+
+  /**
+   * @brief Get the mapped arguments.
+   */
+  const MappedArgs<std::array<Arg, Dimension>>& args() const
+  {
+    return m_args;
+  }
+
+  /**
+   * @brief Resample an input raster of knot values.
+   */
+  template <typename TRaster>
+  std::vector<Value> operator()(const TRaster& v)
+  {
+    std::vector<Value> y;
+    y.reserve(m_args.size());
+    transform(v, std::back_inserter(y));
+    return y;
+  }
+
+  /**
+   * @brief Resample an input raster of knot values into an output iterator.
+   * @return The output iterator past the last written value
+   */
+  template <typename TRaster, typename TOut>
+  TOut transform(const TRaster& v, TOut out)
+  {
+    const auto n0 = domain(0).ssize();
+    const auto n1 = domain(1).ssize();
+    for (Linx::Index j1 = 0; j1 < n1; ++j1) {
+      const auto row = m_mask + n0 * j1;
+      for (Linx::Index j0 = 0; j0 < n0; ++j0) {
+        if (row[j0]) {
+          m_splines0[j1].set(j0, v[{j0, j1}]);
+        }
+      }
+    }
+    for (const auto& x : m_args) {
+      const auto i1 = x[1].index();
+      const auto min = std::max(i1 - 1, 0L);
+      const auto max = std::min(i1 + 2, n1 - 1);
+      for (auto i = min; i <= max; ++i) {
+        m_spline1.set(i, m_splines0[i](x[0]));
+      }
+      *out = m_spline1(x[1]);
+      ++out;
+    }
+    return out;
+  }
+
+private:
+
+  /**
+   * @brief Create the splines along axis 0, one per knot along axis 1, in the resource.
+   */
+  void init_splines0(const Domain& domain0, Resource* resource)
+  {
+    const auto size = m_spline1.domain().size();
+    m_splines0.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      m_splines0.emplace_back(domain0, resource);
+    }
+  }
+
+  MappedArgs<std::array<Arg, Dimension>> m_args; ///< The mapped arguments
+  std::unique_ptr<Domain> m_domain0; ///< The domain along axis 0 rebuilt from the file, if not provided
+  std::unique_ptr<Domain> m_domain1; ///< The domain along axis 1 rebuilt from the file, if not provided
+  Buffer<Method> m_splines0; ///< Splines along axis 0
+  Method m_spline1; ///< Spline along axis 1
+  const unsigned char* m_mask; ///< The mapped mask of the neighboring knots
+};
+
+/**
+ * @brief Load a bivariate cospline saved by `save()` and check that it matches the domains.
+ *
+ * The arguments are copied, but not recomputed, such that loading is linear in their number.
+ * For a construction which is independent of the number of arguments, use `MappedBiCo`.
+ */
+template <typename TSpline, typename TInstrument = NoInstrument>
+BiCospline<TSpline, TInstrument> load_bicospline(
+    const typename TSpline::Domain& domain0,
+    const typename TSpline::Domain& domain1,
+    const std::string& path)
+{
+  const MappedArgs<std::array<typename TSpline::Arg, 2>> args(path, 2);
+  args.check(domain0, domain1);
+  return BiCospline<TSpline, TInstrument>(domain0, domain1, Precomputed(), args.begin(), args.end());
+}
+
+} // namespace Splider
+
+#endif
@@ -0,0 +1,422 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDER_SMOOTHER_H
+#define _SPLIDER_SMOOTHER_H
+
+#include "Linx/Base/SeqUtils.h" // IsRange
+#include "Splider/C2.h"
+#include "Splider/Memory.h"
+
+#include <complex>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Splider {
+
+/**
+ * @brief Smoothing spline fitter.
+ *
+ * Given knot abscissae \f$u\f$, noisy values \f$y\f$, positive weights \f$w\f$ and a smoothing parameter \f$\lambda\f$,
+ * the fitted values \f$g\f$ minimize \f$\sum_i w_i |y_i - g_i|^2 + \lambda \int g''^2\f$,
+ * and the minimizer is the natural `C2` spline which interpolates them.
+ *
+ * This is Reinsch algorithm: the interior second derivatives \f$\gamma\f$ are solution of
+ * \f$(R + \lambda Q^T W^{-1} Q) \gamma = Q^T y\f$, where \f$Q\f$ is the second-difference matrix
+ * and \f$R\f$ the tridiagonal matrix of the `C2` system, such that the system is symmetric pentadiagonal,
+ * and the fitted values are \f$g = y - \lambda W^{-1} Q \gamma\f$.
+ *
+ * The bands of \f$R\f$, \f$Q^T W^{-1} Q\f$ and \f$Q^T y\f$ are computed once when assigning the data,
+ * such that fitting for a given \f$\lambda\f$, e.g. in a sweep, only costs an \f$LDL^T\f$ factorization and two passes,
+ * and the generalized cross-validation (GCV) score costs one more pass for the trace of the influence matrix,
+ * with the algorithm of Hutchinson and de Hoog.
+ * Nothing is allocated after the data have been assigned.
+ */
+template <typename TValue = double, typename TReal = double>
+class Smoother {
+public:
+
+  /**
+   * @brief The knots domain type.
+   */
+  using Domain = typename C2::Domain<TReal>;
+
+  /**
+   * @brief The abscissae floating point type.
+   */
+  using Real = TReal;
+
+  /**
+   * @brief The value type.
+   */
+  using Value = TValue;
+
+  /**
+   * @brief The type of the fitted spline.
+   */
+  template <typename TInstrument = NoInstrument>
+  using Spline = C2Spline<Domain, Value, C2Bounds::Natural, TInstrument>;
+
+  /**
+   * @brief Iterator-based constructor.
+   * @param resource The memory resource of the domain and workspaces
+   */
+  template <typename TIt>
+  explicit Smoother(TIt begin, TIt end, Resource* resource = default_resource()) :
+      m_domain(checked(begin, end), end, resource), m_r0(resource), m_r1(resource), m_m0(resource), m_m1(resource), m_m2(resource),
+      m_qy(resource), m_y(resource), m_w(resource), m_d(resource), m_a(resource), m_b(resource), m_gamma(resource),
+      m_g(resource), m_lambda(-1), m_trace(0)
+  {
+    const auto n = m_domain.ssize();
+    const auto m = n - 2;
+    m_r0.resize(m);
+    m_r1.resize(m);
+    for (Linx::Index j = 0; j < m; ++j) {
+      m_r0[j] = (m_domain.length(j) + m_domain.length(j + 1)) / 3;
+      m_r1[j] = m_domain.length(j + 1) / 6;
+    }
+    for (auto* band : {&m_m0, &m_m1, &m_m2, &m_d, &m_a, &m_b}) {
+      band->resize(m);
+    }
+    m_qy.resize(m);
+    m_gamma.resize(m);
+    m_g.resize(n);
+  }
+
+  /**
+   * @brief Range-based constructor.
+   */
+  template <typename TU, typename std::enable_if_t<Linx::IsRange<TU>::value>* = nullptr>
+  explicit Smoother(const TU& u, Resource* resource = default_resource()) :
+      Smoother(std::begin(u), std::end(u), resource)
+  {}
+
+  /**
+   * @brief List-based constructor.
+   */
+  Smoother(std::initializer_list<Real> u, Resource* resource = default_resource()) :
+      Smoother(u.begin(), u.end(), resource)
+  {}
+
+  /**
+   * @brief Get the knots domain.
+   */
+  inline const Domain& domain() const
+  {
+    return m_domain;
+  }
+
+  /**
+   * @brief Assign the noisy values with unit weights.
+   */
+  template <typename TV, typename std::enable_if_t<Linx::IsRange<TV>::value>* = nullptr>
+  void assign(const TV& y)
+  {
+    m_w.assign(m_domain.size(), Real(1));
+    assign_values(std::begin(y), std::end(y));
+  }
+
+  /**
+   * @brief Assign the noisy values and their weights, e.g. inverse variances.
+   */
+  template <
+      typename TV,
+      typename TW,
+      typename std::enable_if_t<Linx::IsRange<TV>::value>* = nullptr,
+      typename std::enable_if_t<Linx::IsRange<TW>::value>* = nullptr>
+  void assign(const TV& y, const TW& w)
+  {
+    m_w.assign(std::begin(w), std::end(w));
+    if (m_w.size() != m_domain.size()) {
+      throw std::runtime_error("Number of weights does not match the number of knots.");
+    }
+    for (const auto& e : m_w) {
+      if (not(e > 0)) {
+        throw std::runtime_error("Smoothing weights must be positive.");
+      }
+    }
+    assign_values(std::begin(y), std::end(y));
+  }
+
+  /**
+   * @brief Fit the values for a given smoothing parameter.
+   * @return The fitted values
+   */
+  const Buffer<Value>& fit(Real lambda)
+  {
+    if (m_y.empty()) {
+      throw std::runtime_error("No values to be smoothed.");
+    }
+    if (lambda < 0) {
+      throw std::runtime_error("Smoothing parameter must be non-negative.");
+    }
+    const auto m = m_domain.ssize() - 2;
+
+    // LDL^T factorization of R + lambda M
+    for (Linx::Index j = 0; j < m; ++j) {
+      auto d = m_r0[j] + lambda * m_m0[j];
+      auto e = j + 1 < m ? m_r1[j] + lambda * m_m1[j] : Real(0);
+      if (j > 0) {
+        d -= m_a[j - 1] * m_a[j - 1] * m_d[j - 1];
+        e -= m_a[j - 1] * m_b[j - 1] * m_d[j - 1];
+      }
+      if (j > 1) {
+        d -= m_b[j - 2] * m_b[j - 2] * m_d[j - 2];
+      }
+      m_d[j] = d;
+      m_a[j] = e / d;
+      m_b[j] = j + 2 < m ? lambda * m_m2[j] / d : Real(0);
+    }
+
+    // Forward and backward substitutions
+    for (Linx::Index j = 0; j < m; ++j) {
+      auto z = m_qy[j];
+      if (j > 0) {
+        z -= m_gamma[j - 1] * m_a[j - 1];
+      }
+      if (j > 1) {
+        z -= m_gamma[j - 2] * m_b[j - 2];
+      }
+      m_gamma[j] = z;
+    }
+    for (auto j = m - 1; j >= 0; --j) {
+      auto z = m_gamma[j] / m_d[j];
+      if (j + 1 < m) {
+        z -= m_gamma[j + 1] * m_a[j];
+      }
+      if (j + 2 < m) {
+        z -= m_gamma[j + 2] * m_b[j];
+      }
+      m_gamma[j] = z;
+    }
+
+    // Fitted values
+    const auto n = m_domain.ssize();
+    for (Linx::Index i = 0; i < n; ++i) {
+      const auto g0 = i > 1 ? m_gamma[i - 2] : Value();
+      const auto g1 = i > 0 && i < n - 1 ? m_gamma[i - 1] : Value();
+      const auto g2 = i < n - 2 ? m_gamma[i] : Value();
+      Value qg {};
+      if (i > 0) {
+        qg -= (g1 - g0) / m_domain.length(i - 1);
+      }
+      if (i < n - 1) {
+        qg += (g2 - g1) / m_domain.length(i);
+      }
+      m_g[i] = m_y[i] - qg * (lambda / m_w[i]);
+    }
+    m_lambda = lambda;
+    return m_g;
+  }
+
+  /**
+   * @brief Fit the values for a given smoothing parameter, and compute the GCV score.
+   *
+   * The score is \f$n \sum_i w_i |y_i - g_i|^2 / (n - \mathrm{tr} A)^2\f$,
+   * where \f$A\f$ is the influence matrix, i.e. \f$g = A y\f$.
+   * The trace of \f$I - A = \lambda W^{-1} Q (R + \lambda Q^T W^{-1} Q)^{-1} Q^T\f$
+   * only requires the five central diagonals of the inverse of the pentadiagonal matrix,
+   * which are computed from its \f$LDL^T\f$ factorization in one backward pass.
+   */
+  Real gcv(Real lambda)
+  {
+    fit(lambda);
+    const auto n = m_domain.ssize();
+    const auto m = n - 2;
+
+    // Backward recursion for the central band of the inverse
+    Real s00 = 0; // Sigma(j, j)
+    Real s01 = 0; // Sigma(j, j + 1)
+    Real s11 = 0; // Sigma(j + 1, j + 1)
+    Real s12 = 0; // Sigma(j + 1, j + 2)
+    Real s22 = 0; // Sigma(j + 2, j + 2)
+    Real trace = 0;
+    for (auto j = m - 1; j >= 0; --j) {
+      s22 = s11;
+      s12 = s01;
+      s11 = s00;
+      const auto a = m_a[j];
+      const auto b = m_b[j];
+      const auto s02 = -a * s12 - b * s22;
+      s01 = -a * s11 - b * s12;
+      s00 = 1 / m_d[j] - a * s01 - b * s02;
+      trace += m_m0[j] * s00;
+      if (j + 1 < m) {
+        trace += 2 * m_m1[j] * s01;
+      }
+      if (j + 2 < m) {
+        trace += 2 * m_m2[j] * s02;
+      }
+    }
+    m_trace = n - lambda * trace;
+
+    Real rss = 0;
+    for (Linx::Index i = 0; i < n; ++i) {
+      rss += m_w[i] * norm(m_y[i] - m_g[i]);
+    }
+    const auto dof = n - m_trace;
+    return dof > 0 ? n * rss / (dof * dof) : std::numeric_limits<Real>::infinity();
+  }
+
+  /**
+   * @brief Compute the GCV scores of multiple smoothing parameters into an output iterator.
+   * @return The output iterator past the last written score
+   * @see `gcv()`
+   */
+  template <typename TIt, typename TOut>
+  TOut sweep(TIt begin, TIt end, TOut out)
+  {
+    for (; begin != end; ++begin, ++out) {
+      *out = gcv(*begin);
+    }
+    return out;
+  }
+
+  /**
+   * @brief Select the smoothing parameter with the lowest GCV score, and fit the values with it.
+   * @return The selected smoothing parameter
+   */
+  template <typename TL, typename std::enable_if_t<Linx::IsRange<TL>::value>* = nullptr>
+  Real select(const TL& lambdas)
+  {
+    auto best = std::numeric_limits<Real>::infinity();
+    Real selected = -1;
+    for (const auto& lambda : lambdas) {
+      const auto score = gcv(lambda);
+      if (score < best) {
+        best = score;
+        selected = lambda;
+      }
+    }
+    if (selected < 0) {
+      throw std::runtime_error("No smoothing parameter to select.");
+    }
+    fit(selected);
+    return selected;
+  }
+
+  /**
+   * @brief Get the smoothing parameter of the last fit, or -1 if none.
+   */
+  inline Real lambda() const
+  {
+    return m_lambda;
+  }
+
+  /**
+   * @brief Get the fitted values of the last fit.
+   */
+  inline const Buffer<Value>& values() const
+  {
+    return m_g;
+  }
+
+  /**
+   * @brief Get the trace of the influence matrix, i.e. the equivalent degrees of freedom, of the last GCV score.
+   */
+  inline Real degrees_of_freedom() const
+  {
+    return m_trace;
+  }
+
+  /**
+   * @brief Create a `C2` spline which interpolates the fitted values of the last fit, i.e. the smoothing spline.
+   * @param resource The memory resource of the spline
+   *
+   * The spline references the domain of the smoother, which must outlive it.
+   */
+  template <typename TInstrument = NoInstrument>
+  Spline<TInstrument> spline(Resource* resource = default_resource()) const
+  {
+    if (m_lambda < 0) {
+      throw std::runtime_error("Values have not been fitted.");
+    }
+    return Spline<TInstrument>(m_domain, m_g.begin(), m_g.end(), resource);
+  }
+
+private:
+
+  /**
+   * @brief Check that there are enough knots before anything is sized.
+   */
+  template <typename TIt>
+  static TIt checked(TIt begin, TIt end)
+  {
+    if (std::distance(begin, end) < 3) {
+      throw std::runtime_error("Not enough knots (<3).");
+    }
+    return begin;
+  }
+
+  /**
+   * @brief Squared modulus of a real or complex value.
+   */
+  static Real norm(const Value& value)
+  {
+    if constexpr (std::is_arithmetic<Value>::value) {
+      return value * value;
+    } else {
+      return std::norm(value);
+    }
+  }
+
+  /**
+   * @brief Assign the values, and compute the bands which depend on the data.
+   */
+  template <typename TIt>
+  void assign_values(TIt begin, TIt end)
+  {
+    m_y.assign(begin, end);
+    const auto n = m_domain.ssize();
+    if (static_cast<Linx::Index>(m_y.size()) != n) {
+      throw std::runtime_error("Number of values does not match the number of knots.");
+    }
+    const auto m = n - 2;
+    for (Linx::Index j = 0; j < m; ++j) {
+      // Column j of Q has entries at rows j, j + 1 and j + 2
+      const auto h0 = m_domain.length(j);
+      const auto h1 = m_domain.length(j + 1);
+      const auto a = 1 / h0;
+      const auto c = 1 / h1;
+      const auto b = -a - c;
+      m_m0[j] = a * a / m_w[j] + b * b / m_w[j + 1] + c * c / m_w[j + 2];
+      m_m1[j] = 0;
+      m_m2[j] = 0;
+      if (j + 1 < m) {
+        const auto h2 = m_domain.length(j + 2);
+        m_m1[j] = b * c / m_w[j + 1] + c * (-c - 1 / h2) / m_w[j + 2];
+      }
+      if (j + 2 < m) {
+        m_m2[j] = c / (m_domain.length(j + 2) * m_w[j + 2]);
+      }
+      m_qy[j] = (m_y[j + 2] - m_y[j + 1]) * c - (m_y[j + 1] - m_y[j]) * a;
+    }
+    m_lambda = -1;
+    m_trace = 0;
+  }
+
+  Domain m_domain; ///< The knots domain
+  Buffer<Real> m_r0; ///< The diagonal of R
+  Buffer<Real> m_r1; ///< The first superdiagonal of R
+  Buffer<Real> m_m0; ///< The diagonal of Q^T W^-1 Q
+  Buffer<Real> m_m1; ///< The first superdiagonal of Q^T W^-1 Q
+  Buffer<Real> m_m2; ///< The second superdiagonal of Q^T W^-1 Q
+  Buffer<Value> m_qy; ///< The right-hand side Q^T y
+  Buffer<Value> m_y; ///< The noisy values
+  Buffer<Real> m_w; ///< The weights
+  Buffer<Real> m_d; ///< The diagonal of D
+  Buffer<Real> m_a; ///< The first subdiagonal of L
+  Buffer<Real> m_b; ///< The second subdiagonal of L
+  Buffer<Value> m_gamma; ///< The interior second derivatives
+  Buffer<Value> m_g; ///< The fitted values
+  Real m_lambda; ///< The smoothing parameter of the last fit
+  Real m_trace; ///< The trace of the influence matrix
+};
+
+} // namespace Splider
+
+#endif
@@ -8,7 +8,10 @@
 #include "Splider/Argument.h"
 #include "Splider/Linspace.h"
 #include "Splider/Partition.h"
+#include "Splider/Prefetch.h"
 
+#include <algorithm>
+#include <iterator>
 #include <stdexcept>
 #include <vector>
 
@@ -26,7 +29,7 @@ namespace Splider {
  * For repeated use of a spline over a constant set of arguments and varying values, see `Cospline`.
  */
 template <typename T, typename TDomain = Partition<double>, Mode M = Mode::Solve | Mode::Early>
-class Spline {
+class Spline : public PrefetchMixin {
 public:
 
   /**
@@ -51,14 +54,20 @@ public:
 
   /**
    * @brief Null knots constructor.
+   * @param resource The memory resource of the knot values and solver workspace
    */
-  explicit Spline(const Domain& u) : m_domain(u), m_v(m_domain.size()), m_6s(m_domain.size()), m_valid(true) {}
+  explicit Spline(const Domain& u, Resource* resource = default_resource()) :
+      m_domain(u), m_v(m_domain.size(), resource), m_6s(m_domain.size(), resource), m_valid(true), m_b(resource),
+      m_d(resource)
+  {}
 
   /**
    * @brief Iterator-based constructor.
    */
   template <typename TIt>
-  explicit Spline(const Domain& u, TIt begin, TIt end) : m_domain(u), m_v(begin, end), m_6s(m_v.size()), m_valid(false)
+  explicit Spline(const Domain& u, TIt begin, TIt end, Resource* resource = default_resource()) :
+      m_domain(u), m_v(begin, end, resource), m_6s(m_v.size(), resource), m_valid(false), m_b(resource),
+      m_d(resource)
   {
     early_update();
   }
@@ -67,14 +76,16 @@ public:
    * @brief Range-based constructor.
    */
   template <typename TRange>
-  explicit Spline(const Domain& u, const TRange& v) : Spline(u, v.begin(), v.end())
+  explicit Spline(const Domain& u, const TRange& v, Resource* resource = default_resource()) :
+      Spline(u, v.begin(), v.end(), resource)
   {}
 
   /**
    * @brief List-based constructor.
    */
   template <typename TV>
-  explicit Spline(const Domain& u, std::initializer_list<TV> v) : Spline(u, v.begin(), v.end())
+  explicit Spline(const Domain& u, std::initializer_list<TV> v, Resource* resource = default_resource()) :
+      Spline(u, v.begin(), v.end(), resource)
   {}
 
   /**
@@ -180,18 +191,39 @@ public:
     return m_v[i] * x.m_cv0 + m_v[i + 1] * x.m_cv1 + m_6s[i] * x.m_c6s0 + m_6s[i + 1] * x.m_c6s1;
   }
 
+  /**
+   * @brief Evaluate the spline over precomputed arguments.
+   */
   std::vector<Value> operator()(const Args<Real>& x)
   {
-    lazy_update(0); // TODO i
     std::vector<Value> out;
     out.reserve(x.size());
-    for (const auto& arg : x.m_args) {
-      const auto i = arg.m_index;
-      out.push_back(m_v[i] * arg.m_cv0 + m_v[i + 1] * arg.m_cv1 + m_6s[i] * arg.m_c6s0 + m_6s[i + 1] * arg.m_c6s1);
-    }
+    transform(x, std::back_inserter(out));
     return out;
   }
 
+  /**
+   * @brief Evaluate the spline over precomputed arguments into an output iterator.
+   * @return The output iterator past the last written value
+   */
+  template <typename TOut>
+  TOut transform(const Args<Real>& x, TOut out)
+  {
+    lazy_update(0); // TODO i
+    return prefetch_transform<Arg>(
+        x.m_args.begin(),
+        x.m_args.end(),
+        out,
+        [&](const Arg& arg) {
+          const auto i = arg.m_index;
+          return m_v[i] * arg.m_cv0 + m_v[i + 1] * arg.m_cv1 + m_6s[i] * arg.m_c6s0 + m_6s[i + 1] * arg.m_c6s1;
+        },
+        [&](const Arg& arg) {
+          Splider::prefetch(&m_v[arg.m_index]);
+          Splider::prefetch(&m_6s[arg.m_index]);
+        });
+  }
+
   /**
    * @brief Evaluate the spline over an iterator.
    * @return The vector of interpolated values
@@ -259,8 +291,10 @@ private:
     const Linx::Index n = m_6s.size();
     const auto h = m_domain.length(0);
     const auto g = 1. / h;
-    std::vector<Real> b(n, 4. * h);
-    std::vector<Value> d(n);
+    m_b.assign(n, 4. * h);
+    m_d.resize(n);
+    auto& b = m_b;
+    auto& d = m_d;
 
     for (Linx::Index i = 1; i < n - 1; ++i) {
       d[i] = (m_v[i + 1] - 2 * m_v[i] + m_v[i - 1]) * g;
@@ -289,8 +323,10 @@ private:
   void solve_uneven()
   {
     const Linx::Index n = m_6s.size();
-    std::vector<Real> b(n);
-    std::vector<Value> d(n);
+    m_b.resize(n);
+    m_d.resize(n);
+    auto& b = m_b;
+    auto& d = m_d;
 
     // Initialize i = 1 for merging initialization and forward pass
     auto h0 = m_domain.length(0);
@@ -306,8 +342,8 @@ private:
       h1 = m_domain.length(i);
       dv0 = dv1;
       dv1 = (m_v[i + 1] - m_v[i]) / h1;
-      const auto w = h1 / b[i - 1];
-      b[i] = 2. * (h0 + h1) - w * h1;
+      const auto w = h0 / b[i - 1];
+      b[i] = 2. * (h0 + h1) - w * h0;
       d[i] = dv1 - dv0 - w * d[i - 1];
     }
 
@@ -367,10 +403,12 @@ private:
 private:
 
   const Domain& m_domain; ///< The knots domain
-  std::vector<Value> m_v; ///< The knot values
-  std::vector<Value> m_6s; ///< The knot second derivatives times 6
+  Buffer<Value> m_v; ///< The knot values
+  Buffer<Value> m_6s; ///< The knot second derivatives times 6
   bool m_valid; ///< Validity flags
   // TODO local validity
+  Buffer<Real> m_b; ///< The solver diagonal workspace
+  Buffer<Value> m_d; ///< The solver right-hand side workspace
 };
 
 } // namespace Splider
@@ -0,0 +1,321 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDER_TILING_H
+#define _SPLIDER_TILING_H
+
+#include "Linx/Data/Vector.h"
+#include "Splider/BiSpline.h"
+
+#include <algorithm>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace Splider {
+
+/**
+ * @brief The number of knots to be added around a tile such that the knots it depends on are available.
+ *
+ * This is the `HaloRadius` constant of the method.
+ */
+template <typename TMethod>
+constexpr Linx::Index halo_radius()
+{
+  return TMethod::HaloRadius;
+}
+
+/**
+ * @brief Check whether a method is local, i.e. whether an interval only depends on a 4-knot window.
+ */
+template <typename TMethod>
+constexpr bool is_local()
+{
+  return halo_radius<TMethod>() <= 2;
+}
+
+/**
+ * @brief Zero-copy 2D view of a dense tile buffer, indexed like a `Linx::Raster`.
+ */
+template <typename T>
+class TileView {
+public:
+
+  /**
+   * @brief Constructor.
+   * @param data The first value of the tile
+   * @param width The length of axis 0, which is the fastest
+   */
+  TileView(const T* data, Linx::Index width) : m_data(data), m_width(width) {}
+
+  /**
+   * @brief Access the value at given position.
+   */
+  const T& operator[](const Linx::Position<2>& p) const
+  {
+    return m_data[p[0] + p[1] * m_width];
+  }
+
+private:
+
+  const T* m_data; ///< The values
+  Linx::Index m_width; ///< The length of axis 0
+};
+
+/**
+ * @brief Out-of-core bivariate resampler, which processes the knot raster tile by tile.
+ *
+ * The output trajectory is partitioned according to the knot tiles its points fall in.
+ * Each tile is extended by a halo of knots, loaded once through a reader callback,
+ * and resampled, after which its memory is reused.
+ * Local methods (see `is_local()`) resample the tile with a `BiCospline`,
+ * which only reads the 4-knot window of each argument.
+ * Global methods resample it as the tensor product of 1D splines built on the whole extended tile:
+ * the arguments of a tile are sorted by their first coordinate,
+ * such that the row splines are evaluated and the column spline is solved once per distinct first coordinate.
+ * Tiles are processed in parallel, such that the peak memory is that of one extended tile per thread,
+ * whatever the raster size.
+ *
+ * The reader is called as `read(front, shape, data)` to fill `data`
+ * with the `shape[0] * shape[1]` knot values of the box starting at `front`, axis 0 first, as in a `Linx::Raster`.
+ * It may be called concurrently from several threads.
+ *
+ * With a halo radius of at least `halo_radius<TMethod>()`, the result of local methods is the same as without tiling,
+ * and that of global methods differs by the knot influence which is left out of the halo, which is negligible.
+ * For global methods, a single tile which covers the whole raster gives the exact tensor product.
+ * This differs from a `BiCospline` of the same method, which only refreshes the 4 nearest knots of the column spline.
+ */
+template <typename TMethod, typename TValue = double>
+class TiledBiCospline {
+public:
+
+  /**
+   * @brief The knot value type.
+   */
+  using Value = TValue;
+
+  /**
+   * @brief Constructor.
+   * @param u0 The knot abscissae along axis 0
+   * @param u1 The knot abscissae along axis 1
+   * @param x The trajectory
+   * @param tile The tile shape, in number of knot intervals
+   * @param halo The halo radius, in number of knots
+   */
+  template <typename TX>
+  TiledBiCospline(
+      std::vector<double> u0,
+      std::vector<double> u1,
+      const TX& x,
+      const Linx::Position<2>& tile,
+      Linx::Index halo = halo_radius<TMethod>()) :
+      m_u0(std::move(u0)), m_u1(std::move(u1)), m_size(0), m_tiles()
+  {
+    if (tile[0] < 1 || tile[1] < 1) {
+      throw std::runtime_error("Tile shape must be positive.");
+    }
+    std::map<std::pair<Linx::Index, Linx::Index>, Tile> tiles;
+    for (const auto& xi : x) {
+      const auto t0 = interval(m_u0, xi[0]) / tile[0];
+      const auto t1 = interval(m_u1, xi[1]) / tile[1];
+      auto& t = tiles[{t0, t1}];
+      t.indices.push_back(m_size);
+      t.x.push_back({xi[0], xi[1]});
+      ++m_size;
+    }
+    for (auto& t : tiles) {
+      auto& tl = t.second;
+      const Linx::Index n0 = m_u0.size();
+      const Linx::Index n1 = m_u1.size();
+      tl.front = {std::max(t.first.first * tile[0] - halo, 0L), std::max(t.first.second * tile[1] - halo, 0L)};
+      const Linx::Position<2> back {
+          std::min((t.first.first + 1) * tile[0] + halo, n0 - 1),
+          std::min((t.first.second + 1) * tile[1] + halo, n1 - 1)};
+      tl.shape = {back[0] - tl.front[0] + 1, back[1] - tl.front[1] + 1};
+      if constexpr (not is_local<TMethod>()) {
+        sort_by_first(tl);
+      }
+      m_tiles.push_back(std::move(tl));
+    }
+  }
+
+  /**
+   * @brief Get the number of arguments.
+   */
+  Linx::Index size() const
+  {
+    return m_size;
+  }
+
+  /**
+   * @brief Get the number of non-empty tiles.
+   */
+  Linx::Index tile_count() const
+  {
+    return m_tiles.size();
+  }
+
+  /**
+   * @brief Get the maximum number of knots of an extended tile, i.e. the buffer size per thread.
+   */
+  Linx::Index max_tile_size() const
+  {
+    Linx::Index out = 0;
+    for (const auto& t : m_tiles) {
+      out = std::max(out, t.shape[0] * t.shape[1]);
+    }
+    return out;
+  }
+
+  /**
+   * @brief Resample the knot values provided by a reader.
+   */
+  template <typename TRead>
+  std::vector<Value> operator()(TRead&& read, Linx::Index threads = 1) const
+  {
+    std::vector<Value> y(m_size);
+    transform(read, y.begin(), threads);
+    return y;
+  }
+
+  /**
+   * @brief Resample the knot values provided by a reader into a random-access output iterator.
+   */
+  template <typename TRead, typename TOut>
+  void transform(TRead&& read, TOut out, Linx::Index threads = 1) const
+  {
+    const Linx::Index count = m_tiles.size();
+    threads = std::max<Linx::Index>(std::min(threads, count), 1);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto work = [&](Linx::Index t) {
+      try {
+        std::vector<Value> buffer(max_tile_size());
+        std::vector<Value> y;
+        for (auto i = t; i < count; i += threads) {
+          const auto& tile = m_tiles[i];
+          read(tile.front, tile.shape, buffer.data());
+          const std::vector<double> u0(m_u0.begin() + tile.front[0], m_u0.begin() + tile.front[0] + tile.shape[0]);
+          const std::vector<double> u1(m_u1.begin() + tile.front[1], m_u1.begin() + tile.front[1] + tile.shape[1]);
+          if constexpr (is_local<TMethod>()) {
+            const auto build = TMethod::Multi::builder(u0, u1);
+            auto cospline = build.template cospline<Value>(tile.x);
+            y.resize(tile.indices.size());
+            cospline.transform(TileView<Value>(buffer.data(), tile.shape[0]), y.begin());
+            for (std::size_t k = 0; k < y.size(); ++k) {
+              out[tile.indices[k]] = y[k];
+            }
+          } else {
+            resample_global(tile, u0, u1, buffer.data(), out);
+          }
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (not error) {
+          error = std::current_exception();
+        }
+      }
+    };
+    std::vector<std::thread> pool;
+    for (Linx::Index t = 1; t < threads; ++t) {
+      pool.emplace_back(work, t);
+    }
+    work(0);
+    for (auto& thread : pool) {
+      thread.join();
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+private:
+
+  /**
+   * @brief A knot tile and the arguments which fall in it.
+   */
+  struct Tile {
+    Linx::Position<2> front; ///< The first knot of the extended tile
+    Linx::Position<2> shape; ///< The number of knots of the extended tile
+    std::vector<Linx::Index> indices; ///< The indices of the arguments in the trajectory
+    std::vector<Linx::Vector<double, 2>> x; ///< The arguments
+  };
+
+  /**
+   * @brief Sort the arguments of a tile by their first coordinate.
+   */
+  static void sort_by_first(Tile& tile)
+  {
+    std::vector<std::size_t> order(tile.x.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](auto a, auto b) {
+      return tile.x[a][0] < tile.x[b][0];
+    });
+    Tile sorted {tile.front, tile.shape, {}, {}};
+    sorted.indices.reserve(order.size());
+    sorted.x.reserve(order.size());
+    for (auto k : order) {
+      sorted.indices.push_back(tile.indices[k]);
+      sorted.x.push_back(tile.x[k]);
+    }
+    tile = std::move(sorted);
+  }
+
+  /**
+   * @brief Resample a tile of a global method as the tensor product of 1D splines.
+   *
+   * The arguments are sorted by their first coordinate,
+   * such that the row splines are only evaluated, and the column spline only solved,
+   * when the first coordinate changes.
+   */
+  template <typename TOut>
+  static void resample_global(
+      const Tile& tile,
+      const std::vector<double>& u0,
+      const std::vector<double>& u1,
+      const Value* data,
+      TOut& out)
+  {
+    const auto build0 = TMethod::builder(u0);
+    const auto build1 = TMethod::builder(u1);
+    std::vector<decltype(build0.template spline<Value>())> rows;
+    rows.reserve(tile.shape[1]);
+    for (Linx::Index j = 0; j < tile.shape[1]; ++j) {
+      const auto row = data + j * tile.shape[0];
+      rows.push_back(build0.spline(row, row + tile.shape[0]));
+    }
+    auto column = build1.template spline<Value>();
+    for (std::size_t k = 0; k < tile.indices.size(); ++k) {
+      if (k == 0 || tile.x[k][0] != tile.x[k - 1][0]) {
+        const auto x0 = build0.arg(tile.x[k][0]);
+        for (Linx::Index j = 0; j < tile.shape[1]; ++j) {
+          column.set(j, rows[j](x0));
+        }
+      }
+      out[tile.indices[k]] = column(build1.arg(tile.x[k][1]));
+    }
+  }
+
+  /**
+   * @brief Get the index of the knot interval which contains an abscissa, clamped to valid intervals.
+   */
+  static Linx::Index interval(const std::vector<double>& u, double x)
+  {
+    const Linx::Index i = std::upper_bound(u.begin(), u.end(), x) - u.begin() - 1;
+    return std::clamp<Linx::Index>(i, 0, u.size() - 2);
+  }
+
+  std::vector<double> m_u0; ///< The knot abscissae along axis 0
+  std::vector<double> m_u1; ///< The knot abscissae along axis 1
+  Linx::Index m_size; ///< The number of arguments
+  std::vector<Tile> m_tiles; ///< The non-empty tiles
+};
+
+} // namespace Splider
+
+#endif
@@ -60,23 +60,24 @@ struct BuilderMixin {
 
   /**
    * @brief Make a builder.
+   * @param resource The memory resource of the knot domain
    */
   template <TBounds B = static_cast<TBounds>(0), typename TIt>
-  static auto builder(TIt begin, TIt end)
+  static auto builder(TIt begin, TIt end, Resource* resource = default_resource())
   {
     using T = typename std::iterator_traits<TIt>::value_type;
     using Real = std::decay_t<T>;
     using Domain = typename TDerived::Domain<Real>;
-    return Builder<Domain, TDerived, TBounds, B>(begin, end);
+    return Builder<Domain, TDerived, TBounds, B>(begin, end, resource);
   }
 
   /**
    * @brief Make a builder.
    */
   template <TBounds B = static_cast<TBounds>(0), typename TRange>
-  static auto builder(const TRange& range)
+  static auto builder(const TRange& range, Resource* resource = default_resource())
   {
-    return builder<B>(std::begin(range), std::end(range));
+    return builder<B>(std::begin(range), std::end(range), resource);
   }
 
   /**
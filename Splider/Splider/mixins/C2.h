@@ -5,11 +5,12 @@
 #ifndef _SPLIDER_MIXINS_C2_H
 #define _SPLIDER_MIXINS_C2_H
 
-#include "Linx/Base/SeqUtils.h" // IsRange
+#include "Splider/Instrument.h"
+#include "Splider/Memory.h"
 #include "Splider/Partition.h" // TODO rm
+#include "Splider/Polynomial.h"
 #include "Splider/mixins/Builder.h"
-
-#include <initializer_list>
+#include "Splider/mixins/PiecewiseCubic.h"
 
 namespace Splider {
 
@@ -21,7 +22,7 @@ using C2Domain = Partition<TReal>; // TODO
  */
 template <typename TDomain>
 class C2Arg {
-  template <typename, typename, typename>
+  template <typename, typename, typename, typename>
   friend class C2SplineMixin;
 
 public:
@@ -71,8 +72,11 @@ private:
 /**
  * @brief \f$C^2\f$ spline parameters.
  */
-template <typename TDomain, typename TValue, typename TDerived>
-class C2SplineMixin { // FIXME Upper mixin
+template <typename TDomain, typename TValue, typename TDerived, typename TInstrument = NoInstrument>
+class C2SplineMixin : public PiecewiseCubicMixin<TDomain, TValue, C2Arg<TDomain>, TDerived, TInstrument> {
+  using Base = PiecewiseCubicMixin<TDomain, TValue, C2Arg<TDomain>, TDerived, TInstrument>;
+  friend Base;
+  friend PowerBasisMixin<TDerived>;
 
 public:
 
@@ -98,69 +102,21 @@ public:
 
   /**
    * @brief Null knots constructor.
+   * @param resource The memory resource of the knot containers
    */
-  explicit C2SplineMixin(const Domain& u) : m_domain(u), m_v(m_domain.size()), m_6s(m_domain.size()), m_valid(true) {}
+  explicit C2SplineMixin(const Domain& u, Resource* resource = default_resource()) :
+      Base(u, resource), m_6s(u.size(), resource)
+  {}
 
   /**
    * @brief Iterator-based constructor.
    */
   template <typename TIt>
-  explicit C2SplineMixin(const Domain& u, TIt begin, TIt end) :
-      m_domain(u), m_v(begin, end), m_6s(m_v.size()), m_valid(false)
+  explicit C2SplineMixin(const Domain& u, TIt begin, TIt end, Resource* resource = default_resource()) :
+      Base(u, begin, end, resource), m_6s(this->m_v.size(), resource)
   {}
 
-  /**
-   * @brief Get the knots domain.
-   */
-  inline const Domain& domain() const
-  {
-    return m_domain;
-  }
-
-  /**
-   * @brief Assign the knot values.
-   */
-  template <typename TIt>
-  void assign(TIt begin, TIt end)
-  {
-    m_v.assign(begin, end);
-    m_valid = false; // FIXME TDerived::invalidate()
-  }
-
-  /**
-   * @brief Assign the knot values.
-   */
-  template <typename TV, typename std::enable_if_t<Linx::IsRange<TV>::value>* = nullptr>
-  void assign(const TV& v)
-  {
-    assign(std::begin(v), std::end(v));
-  }
-
-  /**
-   * @brief Assign the knot values.
-   */
-  template <typename TV>
-  void assign(std::initializer_list<TV> v)
-  {
-    assign(v.begin(), v.end());
-  }
-
-  /**
-   * @brief Set a knot value.
-   */
-  void set(Linx::Index i, Value v)
-  {
-    m_v[i] = v;
-    m_valid = false; // FIXME TDerived::invalidate(i)
-  }
-
-  /**
-   * @brief Evaluate the spline for a given argument.
-   */
-  inline Value operator()(Real x)
-  {
-    return operator()(Arg(m_domain, x));
-  }
+  using Base::operator();
 
   /**
    * @brief Evaluate the spline for a given argument.
@@ -169,47 +125,44 @@ public:
   {
     const auto i = arg.m_i;
     static_cast<TDerived&>(*this).update(i);
+    m_instrument.increment(Event::Evaluation);
     return m_v[i] * arg.m_cv0 + m_v[i + 1] * arg.m_cv1 + m_6s[i] * arg.m_c6s0 + m_6s[i + 1] * arg.m_c6s1;
   }
 
+protected:
+
+  using Base::m_domain;
+  using Base::m_v;
+  using Base::m_instrument;
+
   /**
-   * @brief Evaluate the spline for multiple arguments.
+   * @brief Get the power-basis coefficients of the i-th subinterval, assuming the spline is up to date.
    */
-  template <typename TIt>
-  std::vector<Value> operator()(TIt begin, TIt end)
+  std::array<Value, 4> power_coefficients(Linx::Index i) const
   {
-    std::vector<Value> out;
-    out.reserve(std::distance(begin, end));
-    for (; begin != end; ++begin) {
-      out.push_back(operator()(*begin));
-    }
-    return out;
+    const auto h = m_domain.length(i);
+    const auto s0 = m_6s[i];
+    const auto s1 = m_6s[i + 1];
+    return {m_v[i], (m_v[i + 1] - m_v[i]) / h - h * (s0 + s0 + s1), s0 * Real(3), (s1 - s0) / h};
   }
 
   /**
-   * @brief Evaluate the spline for multiple arguments.
+   * @brief Get the cached derivatives.
    */
-  template <typename TX, typename std::enable_if_t<Linx::IsRange<TX>::value>* = nullptr>
-  std::vector<Value> operator()(const TX& x)
+  inline const Buffer<Value>& knot_derivatives() const
   {
-    return operator()(std::begin(x), std::end(x));
+    return m_6s;
   }
 
   /**
-   * @brief Evaluate the spline for multiple arguments.
+   * @copydoc knot_derivatives()
    */
-  template <typename TX>
-  std::vector<Value> operator()(std::initializer_list<TX> x)
+  inline Buffer<Value>& knot_derivatives()
   {
-    return operator()(x.begin(), x.end());
+    return m_6s;
   }
 
-protected:
-
-  const Domain& m_domain; ///< The knots domain
-  std::vector<Value> m_v; ///< The knot values
-  std::vector<Value> m_6s; ///< The knot second derivatives times 6
-  bool m_valid; ///< Validity flag // FIXME to TDerived
+  Buffer<Value> m_6s; ///< The knot second derivatives times 6
 };
 
 } // namespace Splider
@@ -5,10 +5,12 @@
 #ifndef _SPLIDER_MIXINS_HERMITE_H
 #define _SPLIDER_MIXINS_HERMITE_H
 
+#include "Splider/Instrument.h"
+#include "Splider/Memory.h"
 #include "Splider/Partition.h" // TODO rm
+#include "Splider/Polynomial.h"
 #include "Splider/mixins/Builder.h"
-
-#include <initializer_list>
+#include "Splider/mixins/PiecewiseCubic.h"
 
 namespace Splider {
 
@@ -23,7 +25,7 @@ using HermiteDomain = Partition<TReal>; // TODO
  */
 template <typename TDomain>
 class HermiteArg {
-  template <typename, typename, typename>
+  template <typename, typename, typename, typename>
   friend class HermiteSplineMixin;
 
 public:
@@ -75,8 +77,11 @@ private:
  * 
  * Hermite splines are C1.
  */
-template <typename TDomain, typename TValue, typename TDerived>
-class HermiteSplineMixin { // FIXME Upper mixin
+template <typename TDomain, typename TValue, typename TDerived, typename TInstrument = NoInstrument>
+class HermiteSplineMixin : public PiecewiseCubicMixin<TDomain, TValue, HermiteArg<TDomain>, TDerived, TInstrument> {
+  using Base = PiecewiseCubicMixin<TDomain, TValue, HermiteArg<TDomain>, TDerived, TInstrument>;
+  friend Base;
+  friend PowerBasisMixin<TDerived>;
 
 public:
 
@@ -102,70 +107,21 @@ public:
 
   /**
    * @brief Null knots constructor.
+   * @param resource The memory resource of the knot containers
    */
-  explicit HermiteSplineMixin(const Domain& u) : m_domain(u), m_v(m_domain.size()), m_d(m_domain.size()), m_valid(true)
+  explicit HermiteSplineMixin(const Domain& u, Resource* resource = default_resource()) :
+      Base(u, resource), m_d(u.size(), resource)
   {}
 
   /**
    * @brief Iterator-based constructor.
    */
   template <typename TIt>
-  explicit HermiteSplineMixin(const Domain& u, TIt begin, TIt end) :
-      m_domain(u), m_v(begin, end), m_d(m_v.size()), m_valid(false)
+  explicit HermiteSplineMixin(const Domain& u, TIt begin, TIt end, Resource* resource = default_resource()) :
+      Base(u, begin, end, resource), m_d(this->m_v.size(), resource)
   {}
 
-  /**
-   * @brief Get the knots domain.
-   */
-  inline const Domain& domain() const
-  {
-    return m_domain;
-  }
-
-  /**
-   * @brief Assign the knot values.
-   */
-  template <typename TIt>
-  void assign(TIt begin, TIt end)
-  {
-    m_v.assign(begin, end);
-    m_valid = false; // FIXME TDerived::invalidate()
-  }
-
-  /**
-   * @brief Assign the knot values.
-   */
-  template <typename TV, typename std::enable_if_t<Linx::IsRange<TV>::value>* = nullptr>
-  void assign(const TV& v)
-  {
-    assign(std::begin(v), std::end(v));
-  }
-
-  /**
-   * @brief Assign the knot values.
-   */
-  template <typename TV>
-  void assign(std::initializer_list<TV> v)
-  {
-    assign(v.begin(), v.end());
-  }
-
-  /**
-   * @brief Set a knot value.
-   */
-  void set(Linx::Index i, Value v)
-  {
-    m_v[i] = v;
-    m_valid = false; // FIXME TDerived::invalidate(i)
-  }
-
-  /**
-   * @brief Evaluate the spline for a given argument.
-   */
-  inline Value operator()(Real x)
-  {
-    return operator()(Arg(m_domain, x));
-  }
+  using Base::operator();
 
   /**
    * @brief Evaluate the spline for a given argument.
@@ -174,47 +130,45 @@ public:
   {
     const auto i = arg.m_i;
     static_cast<TDerived&>(*this).update(i);
+    m_instrument.increment(Event::Evaluation);
     return m_v[i] * arg.m_cv0 + m_v[i + 1] * arg.m_cv1 + m_d[i] * arg.m_cd0 + m_d[i + 1] * arg.m_cd1;
   }
 
+protected:
+
+  using Base::m_domain;
+  using Base::m_v;
+  using Base::m_instrument;
+
   /**
-   * @brief Evaluate the spline for multiple arguments.
+   * @brief Get the power-basis coefficients of the i-th subinterval, assuming the spline is up to date.
    */
-  template <typename TIt>
-  std::vector<Value> operator()(TIt begin, TIt end)
+  std::array<Value, 4> power_coefficients(Linx::Index i) const
   {
-    std::vector<Value> out;
-    out.reserve(std::distance(begin, end));
-    for (; begin != end; ++begin) {
-      out.push_back(operator()(*begin));
-    }
-    return out;
+    const auto h = m_domain.length(i);
+    const auto slope = (m_v[i + 1] - m_v[i]) / h;
+    const auto d0 = m_d[i];
+    const auto d1 = m_d[i + 1];
+    return {m_v[i], d0, (slope * Real(3) - d0 - d0 - d1) / h, (d0 + d1 - slope * Real(2)) / (h * h)};
   }
 
   /**
-   * @brief Evaluate the spline for multiple arguments.
+   * @brief Get the cached derivatives.
    */
-  template <typename TX, typename std::enable_if_t<Linx::IsRange<TX>::value>* = nullptr>
-  std::vector<Value> operator()(const TX& x)
+  inline const Buffer<Value>& knot_derivatives() const
   {
-    return operator()(std::begin(x), std::end(x));
+    return m_d;
   }
 
   /**
-   * @brief Evaluate the spline for multiple arguments.
+   * @copydoc knot_derivatives()
    */
-  template <typename TX>
-  std::vector<Value> operator()(std::initializer_list<TX> x)
+  inline Buffer<Value>& knot_derivatives()
   {
-    return operator()(x.begin(), x.end());
+    return m_d;
   }
 
-protected:
-
-  const Domain& m_domain; ///< The knots domain
-  std::vector<Value> m_v; ///< The knot values
-  std::vector<Value> m_d; ///< The knot derivatives
-  bool m_valid; ///< Validity flag // FIXME to TDerived
+  Buffer<Value> m_d; ///< The knot derivatives
 };
 
 } // namespace Splider
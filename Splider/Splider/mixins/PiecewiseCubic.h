@@ -0,0 +1,508 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDER_MIXINS_PIECEWISECUBIC_H
+#define _SPLIDER_MIXINS_PIECEWISECUBIC_H
+
+#include "Linx/Base/SeqUtils.h" // IsRange
+#include "Splider/Instrument.h"
+#include "Splider/Memory.h"
+#include "Splider/Polynomial.h"
+#include "Splider/Prefetch.h"
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace Splider {
+
+/**
+ * @brief Mixin for splines which are defined by the knot values and one cached derivative per knot.
+ *
+ * The derived spline provides:
+ * - `update(i)`, which computes the cached derivatives if needed;
+ * - `operator()(const Arg&)`, which evaluates the spline at a precomputed argument;
+ * - `power_coefficients(i)`, which returns the coefficients of the i-th cubic, assuming the spline is up to date;
+ * - `knot_derivatives()`, which returns the buffer of cached derivatives.
+ *
+ * The services which only depend on these kernels are implemented once here,
+ * and `coefficients()` and `polynomial()` are inherited from `PowerBasisMixin`.
+ */
+template <typename TDomain, typename TValue, typename TArg, typename TDerived, typename TInstrument = NoInstrument>
+class PiecewiseCubicMixin : public PowerBasisMixin<TDerived>, public PrefetchMixin {
+
+public:
+
+  /**
+   * @brief The knots domain type.
+   */
+  using Domain = TDomain;
+
+  /**
+   * @brief The abscissae floating point type.
+   */
+  using Real = typename Domain::Value;
+
+  /**
+   * @brief The argument type.
+   */
+  using Arg = TArg;
+
+  /**
+   * @brief The knot value type.
+   */
+  using Value = TValue;
+
+  /**
+   * @brief Null knots constructor.
+   * @param resource The memory resource of the knot containers
+   */
+  explicit PiecewiseCubicMixin(const Domain& u, Resource* resource = default_resource()) :
+      m_domain(u), m_v(m_domain.size(), resource), m_valid(true), m_instrument(), m_prefix(resource),
+      m_integrated(0)
+  {}
+
+  /**
+   * @brief Iterator-based constructor.
+   */
+  template <typename TIt>
+  explicit PiecewiseCubicMixin(const Domain& u, TIt begin, TIt end, Resource* resource = default_resource()) :
+      m_domain(u), m_v(begin, end, resource), m_valid(false), m_instrument(), m_prefix(resource),
+      m_integrated(0)
+  {}
+
+  /**
+   * @brief Get the knots domain.
+   */
+  inline const Domain& domain() const
+  {
+    return m_domain;
+  }
+
+  /**
+   * @brief Get the memory resource.
+   */
+  inline Resource* resource() const
+  {
+    return m_v.get_allocator().resource();
+  }
+
+  /**
+   * @brief Assign the knot values.
+   */
+  template <typename TIt>
+  void assign(TIt begin, TIt end)
+  {
+    m_v.assign(begin, end);
+    invalidate();
+  }
+
+  /**
+   * @brief Assign the knot values.
+   */
+  template <typename TV, typename std::enable_if_t<Linx::IsRange<TV>::value>* = nullptr>
+  void assign(const TV& v)
+  {
+    assign(std::begin(v), std::end(v));
+  }
+
+  /**
+   * @brief Assign the knot values.
+   */
+  template <typename TV>
+  void assign(std::initializer_list<TV> v)
+  {
+    assign(v.begin(), v.end());
+  }
+
+  /**
+   * @brief Set a knot value.
+   */
+  void set(Linx::Index i, Value v)
+  {
+    m_v[i] = v;
+    invalidate(); // FIXME TDerived::invalidate(i)
+  }
+
+  /**
+   * @brief Add a scaled spline of the same type and domain, i.e. compute `this = a * x + this`.
+   * @return This spline
+   *
+   * Since the method is linear in the knot values, the knot values and the cached derivatives
+   * are combined directly in one pass, without solving again,
+   * such that a linear combination of splines is evaluated once instead of once per spline.
+   * If neither spline is up to date, only the knot values are combined, and the result is solved once when needed.
+   */
+  TDerived& axpy(Value a, TDerived& x)
+  {
+    if (x.domain() != m_domain) {
+      throw std::runtime_error("Cannot combine splines: domain mismatch.");
+    }
+    auto& self = static_cast<TDerived&>(*this);
+    const auto n = m_v.size();
+    if (not m_valid && not x.m_valid) {
+      for (std::size_t i = 0; i < n; ++i) {
+        m_v[i] += a * x.m_v[i];
+      }
+      return self;
+    }
+    self.update(0);
+    x.update(0);
+    m_integrated = 0;
+    auto& k = self.knot_derivatives();
+    const auto& xk = x.knot_derivatives();
+    for (std::size_t i = 0; i < n; ++i) {
+      m_v[i] += a * x.m_v[i];
+      k[i] += a * xk[i];
+    }
+    return self;
+  }
+
+  /**
+   * @brief Scale the spline, i.e. compute `this = a * this`.
+   * @return This spline
+   */
+  TDerived& scale(Value a)
+  {
+    auto& self = static_cast<TDerived&>(*this);
+    m_integrated = 0;
+    const auto n = m_v.size();
+    for (std::size_t i = 0; i < n; ++i) {
+      m_v[i] *= a;
+    }
+    if (m_valid) {
+      auto& k = self.knot_derivatives();
+      for (std::size_t i = 0; i < n; ++i) {
+        k[i] *= a;
+      }
+    }
+    return self;
+  }
+
+  /**
+   * @brief Evaluate the spline for a given argument.
+   */
+  inline Value operator()(Real x)
+  {
+    check_range(m_instrument, m_domain, x);
+    m_instrument.increment(Event::Argument);
+    return static_cast<TDerived&>(*this)(Arg(m_domain, x));
+  }
+
+  /**
+   * @brief Evaluate the spline for multiple arguments.
+   */
+  template <typename TIt>
+  std::vector<Value> operator()(TIt begin, TIt end)
+  {
+    std::vector<Value> out;
+    out.reserve(std::distance(begin, end));
+    transform(begin, end, std::back_inserter(out));
+    return out;
+  }
+
+  /**
+   * @brief Evaluate the spline for multiple arguments.
+   */
+  template <typename TX, typename std::enable_if_t<Linx::IsRange<TX>::value>* = nullptr>
+  std::vector<Value> operator()(const TX& x)
+  {
+    return operator()(std::begin(x), std::end(x));
+  }
+
+  /**
+   * @brief Evaluate the spline for multiple arguments.
+   */
+  template <typename TX>
+  std::vector<Value> operator()(std::initializer_list<TX> x)
+  {
+    return operator()(x.begin(), x.end());
+  }
+
+  /**
+   * @brief Evaluate the spline for multiple arguments into an output iterator.
+   * @return The output iterator past the last written value
+   *
+   * This method does not allocate, and is the preferred entry point for steady-state evaluation.
+   */
+  template <typename TIt, typename TOut>
+  TOut transform(TIt begin, TIt end, TOut out)
+  {
+    auto& self = static_cast<TDerived&>(*this);
+    m_instrument.start(Event::Batch);
+    out = prefetch_transform<Arg>(
+        begin,
+        end,
+        out,
+        [&](const auto& x) {
+          return self(x);
+        },
+        [&](const Arg& arg) {
+          prefetch_knots(arg);
+        });
+    m_instrument.stop(Event::Batch);
+    return out;
+  }
+
+  /**
+   * @brief Solve `spline(x) = y` for a given target.
+   *
+   * The knot values are assumed to be monotonic, which is checked by the batch overloads only.
+   * @see `inverse(TIt, TIt, TOut)`
+   */
+  Real inverse(Value y)
+  {
+    auto& self = static_cast<TDerived&>(*this);
+    self.update(0);
+    const auto increasing = m_v.front() <= m_v.back();
+    const auto i = Internal::locate(m_v, y, increasing, 0);
+    return m_domain[i] + Internal::solve_cubic<Real>(self.power_coefficients(i), y, 0, m_domain.length(i));
+  }
+
+  /**
+   * @brief Solve `spline(x) = y` for multiple targets into an output iterator.
+   * @return The output iterator past the last written abscissa
+   *
+   * The knot values must be monotonic, and the targets within their range, otherwise an exception is thrown.
+   * Each target is located by a search over the knot values, which takes constant time for sorted targets,
+   * and the cubic of its subinterval is solved in power basis by a bracketed Newton method,
+   * without evaluating the spline through `operator()`.
+   * If the spline is not monotonic within a subinterval, any of its roots there may be returned.
+   */
+  template <typename TIt, typename TOut>
+  TOut inverse(TIt begin, TIt end, TOut out)
+  {
+    static_assert(std::is_floating_point<Value>::value, "Only real splines can be inverted.");
+    auto& self = static_cast<TDerived&>(*this);
+    self.update(0);
+    const auto increasing = Internal::check_monotonic(m_v);
+    Linx::Index i = 0;
+    for (; begin != end; ++begin, ++out) {
+      const Value y = *begin;
+      i = Internal::locate(m_v, y, increasing, i);
+      *out = m_domain[i] + Internal::solve_cubic<Real>(self.power_coefficients(i), y, 0, m_domain.length(i));
+    }
+    return out;
+  }
+
+  /**
+   * @brief Solve `spline(x) = y` for multiple targets.
+   */
+  template <typename TY, typename std::enable_if_t<Linx::IsRange<TY>::value>* = nullptr>
+  std::vector<Real> inverse(const TY& y)
+  {
+    std::vector<Real> out(std::distance(std::begin(y), std::end(y)));
+    inverse(std::begin(y), std::end(y), out.begin());
+    return out;
+  }
+
+  /**
+   * @brief Integrate the spline from the first knot to a given abscissa.
+   */
+  Value primitive(Real x)
+  {
+    return primitive(PolynomialArg<Domain>(m_domain, x));
+  }
+
+  /**
+   * @brief Integrate the spline from the first knot to a given precomputed abscissa.
+   *
+   * The integrals from the first knot to each knot are cached in a prefix-sum table,
+   * which is built lazily up to the requested subinterval, and invalidated with the cached derivatives,
+   * such that a query costs a table lookup and the integral of a cubic over a fraction of a subinterval.
+   */
+  Value primitive(const PolynomialArg<Domain>& arg)
+  {
+    const auto i = arg.index();
+    integrate(i);
+    const auto p = static_cast<const TDerived&>(*this).power_coefficients(i);
+    return m_prefix[i] + Internal::integrate_cubic(p, arg.offset());
+  }
+
+  /**
+   * @brief Evaluate the primitive for multiple abscissae or precomputed abscissae into an output iterator.
+   * @return The output iterator past the last written value
+   */
+  template <typename TIt, typename TOut>
+  TOut primitive(TIt begin, TIt end, TOut out)
+  {
+    for (; begin != end; ++begin, ++out) {
+      *out = primitive(*begin);
+    }
+    return out;
+  }
+
+  /**
+   * @brief Integrate the spline over `[a, b]`.
+   */
+  Value integral(Real a, Real b)
+  {
+    return primitive(b) - primitive(a);
+  }
+
+  /**
+   * @brief Integrate the spline between two precomputed abscissae.
+   */
+  Value integral(const PolynomialArg<Domain>& a, const PolynomialArg<Domain>& b)
+  {
+    return primitive(b) - primitive(a);
+  }
+
+  /**
+   * @brief Find the local extrema of the spline into an output iterator of `Extremum`.
+   * @return The output iterator past the last written extremum
+   *
+   * The extrema are computed in one pass over the subintervals, as the roots of the derivative of each cubic,
+   * and are therefore exact, contrary to a dense sampling.
+   * Only the interior points where the derivative changes sign are reported, in increasing order:
+   * the bounds of the domain are excluded, and a point on an interior knot is reported once.
+   */
+  template <typename TOut>
+  TOut extrema(TOut out)
+  {
+    static_assert(std::is_floating_point<Value>::value, "Only real splines have extrema.");
+    auto& self = static_cast<TDerived&>(*this);
+    self.update(0);
+    const auto last = m_domain.ssize() - 2;
+    std::array<Real, 2> s;
+    for (Linx::Index i = 0; i <= last; ++i) {
+      const auto p = self.power_coefficients(i);
+      const auto count = Internal::critical_points<Real>(p, m_domain.length(i), false, s);
+      for (int k = 0; k < count; ++k) {
+        if (i == 0 && s[k] == 0) { // Left bound
+          continue;
+        }
+        const auto value = ((p[3] * s[k] + p[2]) * s[k] + p[1]) * s[k] + p[0];
+        *out = Extremum<Real, Value> {m_domain[i] + s[k], value, p[2] + 3 * p[3] * s[k] < 0};
+        ++out;
+      }
+    }
+    return out;
+  }
+
+  /**
+   * @brief Find the local extrema of the spline.
+   */
+  std::vector<Extremum<Real, Value>> extrema()
+  {
+    std::vector<Extremum<Real, Value>> out;
+    extrema(std::back_inserter(out));
+    return out;
+  }
+
+  /**
+   * @brief Find the abscissae where the spline equals a given value into an output iterator.
+   * @return The output iterator past the last written abscissa
+   *
+   * Each cubic is split into monotonic pieces at its critical points,
+   * and the pieces which cross the value are solved by a bracketed Newton method.
+   * The roots are written in increasing order, including tangent ones.
+   */
+  template <typename TOut>
+  TOut roots(Value y, TOut out)
+  {
+    static_assert(std::is_floating_point<Value>::value, "Only real splines have roots.");
+    auto& self = static_cast<TDerived&>(*this);
+    self.update(0);
+    const auto last = m_domain.ssize() - 2;
+    std::array<Real, 3> s;
+    for (Linx::Index i = 0; i <= last; ++i) {
+      const auto h = m_domain.length(i);
+      const auto count = Internal::cubic_roots<Real>(self.power_coefficients(i), y, h, m_v[i + 1], i == last, s);
+      for (int k = 0; k < count; ++k, ++out) {
+        *out = m_domain[i] + s[k];
+      }
+    }
+    return out;
+  }
+
+  /**
+   * @brief Find the abscissae where the spline equals a given value, zero by default.
+   */
+  std::vector<Real> roots(Value y = Value())
+  {
+    std::vector<Real> out;
+    roots(y, std::back_inserter(out));
+    return out;
+  }
+
+  /**
+   * @brief Get the instrumentation policy.
+   */
+  inline const TInstrument& instrument() const
+  {
+    return m_instrument;
+  }
+
+  /**
+   * @copydoc instrument()
+   */
+  inline TInstrument& instrument()
+  {
+    return m_instrument;
+  }
+
+protected:
+
+  /**
+   * @brief Extend the prefix-sum table of integrals up to the i-th knot.
+   */
+  void integrate(Linx::Index i)
+  {
+    auto& self = static_cast<TDerived&>(*this);
+    self.update(i);
+    if (m_integrated > i) {
+      return;
+    }
+    if (m_integrated == 0) {
+      m_prefix.resize(m_v.size());
+      m_prefix[0] = Value();
+      m_integrated = 1;
+    }
+    for (auto k = m_integrated; k <= i; ++k) {
+      m_prefix[k] = m_prefix[k - 1] + Internal::integrate_cubic(self.power_coefficients(k - 1), m_domain.length(k - 1));
+    }
+    m_integrated = i + 1;
+  }
+
+  /**
+   * @brief Prefetch the knot values and derivatives needed by an argument.
+   */
+  inline void prefetch_knots(const Arg& arg) const
+  {
+    const auto i = arg.index();
+    const auto& k = static_cast<const TDerived&>(*this).knot_derivatives();
+    Splider::prefetch(&m_v[i]);
+    Splider::prefetch(&m_v[i + 1]);
+    Splider::prefetch(&k[i]);
+    Splider::prefetch(&k[i + 1]);
+  }
+
+  /**
+   * @brief Mark the coefficients as invalid.
+   */
+  inline void invalidate()
+  {
+    if (m_valid) {
+      m_instrument.increment(Event::Invalidation);
+    }
+    m_valid = false;
+    m_integrated = 0;
+  }
+
+  const Domain& m_domain; ///< The knots domain
+  Buffer<Value> m_v; ///< The knot values
+  bool m_valid; ///< Validity flag // FIXME to TDerived
+  TInstrument m_instrument; ///< The instrumentation policy
+  Buffer<Value> m_prefix; ///< The integrals from the first knot to each knot
+  Linx::Index m_integrated; ///< The number of valid integrals in `m_prefix`
+};
+
+} // namespace Splider
+
+#endif
@@ -0,0 +1,383 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Linx/Data/Raster.h"
+#include "Splider/BiSpline.h"
+#include "Splider/C2.h"
+#include "Splider/CatmullRom.h"
+#include "Splider/Cospline.h"
+#include "Splider/Hermite.h"
+#include "Splider/Lagrange.h"
+#include "Splider/Spline.h"
+
+#include <boost/mpl/list.hpp>
+#include <array>
+#include <boost/test/unit_test.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <numeric>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief Global allocation counters, fed by the replaced `operator new`.
+ */
+struct AllocationCounters {
+  static inline std::size_t count = 0; ///< The number of allocations
+  static inline std::size_t bytes = 0; ///< The number of allocated bytes
+};
+
+/**
+ * @brief The allocations performed by a function call.
+ */
+struct Allocations {
+  std::size_t count; ///< The number of allocations
+  std::size_t bytes; ///< The number of allocated bytes
+};
+
+/**
+ * @brief Count and perform an allocation.
+ *
+ * The replaced operators forward to this non-inline function,
+ * such that the compiler does not pair their `std::malloc()` or `std::free()` with the call sites.
+ */
+[[gnu::noinline]] void* counted_allocate(std::size_t size, std::size_t alignment) noexcept
+{
+  ++AllocationCounters::count;
+  AllocationCounters::bytes += size;
+  size = size ? size : 1;
+  if (alignment <= alignof(std::max_align_t)) {
+    return std::malloc(size);
+  }
+  return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+/**
+ * @brief Release an allocation performed by `counted_allocate()`.
+ */
+[[gnu::noinline]] void counted_free(void* p) noexcept
+{
+  std::free(p);
+}
+
+/**
+ * @brief Count and perform an allocation, or throw.
+ */
+void* counted_allocate_or_throw(std::size_t size, std::size_t alignment)
+{
+  if (auto p = counted_allocate(size, alignment)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size)
+{
+  return counted_allocate_or_throw(size, 0);
+}
+
+void* operator new[](std::size_t size)
+{
+  return counted_allocate_or_throw(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+  return counted_allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+  return counted_allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  return counted_allocate(size, 0);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return counted_allocate(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  return counted_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  return counted_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept
+{
+  counted_free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+  counted_free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  counted_free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+  counted_free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+  counted_free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+  counted_free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+  counted_free(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+  counted_free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+  counted_free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+  counted_free(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+  counted_free(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+  counted_free(p);
+}
+
+/**
+ * @brief Count the allocations performed by a function call.
+ *
+ * The checks must be performed outside of the call, because the test framework allocates.
+ * The returned value is a snapshot, which is not affected by subsequent allocations.
+ */
+template <typename TFunc>
+Allocations profile(TFunc&& func)
+{
+  const auto count = AllocationCounters::count;
+  const auto bytes = AllocationCounters::bytes;
+  func();
+  return {AllocationCounters::count - count, AllocationCounters::bytes - bytes};
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Allocation_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(profile_snapshot_test)
+{
+  std::unique_ptr<int> first;
+  std::unique_ptr<double> second;
+  const auto one = profile([&]() {
+    first = std::make_unique<int>(1);
+  });
+  const auto none = profile([]() {});
+  second = std::make_unique<double>(2); // Must not affect the snapshots
+  BOOST_TEST(one.count == 1);
+  BOOST_TEST(one.bytes == sizeof(int));
+  BOOST_TEST(none.count == 0);
+  BOOST_TEST(none.bytes == 0);
+}
+
+using Methods = boost::mpl::list<
+    Splider::C2,
+    Splider::C2::FiniteDiff,
+    Splider::Hermite::FiniteDiff,
+    Splider::Hermite::CatmullRom::Uniform,
+    Splider::Lagrange>;
+
+struct AllocationFixture {
+  std::vector<double> u {0, 1, 2, 3, 4, 5, 6, 7};
+  std::vector<double> x {0.5, 1.5, 2.5, 3.1, 4.9, 6.5};
+  std::vector<double> v {0, 1, 4, 9, 16, 25, 36, 49};
+  std::vector<double> w {1, 0, 1, 0, 1, 0, 1, 0};
+  std::vector<double> y = std::vector<double>(x.size());
+};
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(scalar_evaluation_budget_test, TMethod, Methods, AllocationFixture)
+{
+  const auto build = TMethod::builder(u);
+  auto spline = build.spline(v);
+  const auto arg = build.arg(x[0]);
+  spline(arg); // Warm-up: workspace allocation
+  const auto allocations = profile([&]() {
+    spline.assign(w);
+    y[0] = spline(arg);
+    y[1] = spline(x[1]);
+  });
+  BOOST_TEST(allocations.count == 0); // Including the update
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(batch_evaluation_budget_test, TMethod, Methods, AllocationFixture)
+{
+  const auto build = TMethod::builder(u);
+  auto spline = build.spline(v);
+  const auto args = build.args(x);
+  spline(args);
+  const auto vector_allocations = profile([&]() {
+    spline.assign(w);
+    y = spline(args);
+  });
+  BOOST_TEST(vector_allocations.count == 1); // Output vector
+  BOOST_TEST(vector_allocations.bytes == x.size() * sizeof(double));
+  const auto allocations = profile([&]() {
+    spline.assign(v);
+    spline.transform(args.begin(), args.end(), y.begin());
+  });
+  BOOST_TEST(allocations.count == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(cospline_budget_test, TMethod, Methods, AllocationFixture)
+{
+  const auto build = TMethod::builder(u);
+  auto cospline = build.cospline(x);
+  cospline(v);
+  const auto vector_allocations = profile([&]() {
+    y = cospline(w);
+  });
+  BOOST_TEST(vector_allocations.count == 1); // Output vector
+  const auto allocations = profile([&]() {
+    cospline.transform(v.begin(), v.end(), y.begin());
+  });
+  BOOST_TEST(allocations.count == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(bicospline_budget_test, TMethod, Methods, AllocationFixture)
+{
+  const auto build = TMethod::Multi::builder(u, u);
+  Splider::Trajectory<2> trajectory {{0.5, 1.5}, {2.5, 3.1}, {4.9, 6.5}};
+  Linx::Raster<double> raster({8, 8});
+  auto cospline = build.cospline(trajectory);
+  cospline(raster);
+  const auto vector_allocations = profile([&]() {
+    y = cospline(raster);
+  });
+  BOOST_TEST(vector_allocations.count == 1); // Output vector
+  const auto allocations = profile([&]() {
+    cospline.transform(raster, y.begin());
+  });
+  BOOST_TEST(allocations.count == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(arena_cospline_test, TMethod, Methods, AllocationFixture)
+{
+  const auto reference_build = TMethod::builder(u);
+  auto reference = reference_build.cospline(x);
+  const auto expected = reference(v);
+
+  std::array<std::byte, 4096> storage;
+  std::pmr::monotonic_buffer_resource arena(storage.data(), storage.size(), std::pmr::null_memory_resource());
+  const auto allocations = profile([&]() {
+    const auto build = TMethod::builder(u, &arena);
+    auto cospline = build.cospline(x, &arena);
+    cospline.transform(v.begin(), v.end(), y.begin());
+  });
+  BOOST_TEST(allocations.count == 0); // Domain, arguments, spline and solver workspace
+  BOOST_TEST(y == expected, boost::test_tools::per_element());
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(arena_args_test, TMethod, Methods, AllocationFixture)
+{
+  const auto build = TMethod::builder(u);
+  const std::vector<typename decltype(build)::Arg> expected = build.args(x); // Unchanged signature
+
+  std::array<std::byte, 4096> storage;
+  std::pmr::monotonic_buffer_resource arena(storage.data(), storage.size(), std::pmr::null_memory_resource());
+  Splider::Resource* resource = nullptr;
+  std::size_t size = 0;
+  const auto allocations = profile([&]() {
+    const auto args = build.args(x, &arena);
+    resource = args.get_allocator().resource();
+    size = args.size();
+  });
+  BOOST_TEST(allocations.count == 0);
+  BOOST_TEST(resource == &arena);
+  BOOST_TEST(size == expected.size());
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(arena_bicospline_test, TMethod, Methods, AllocationFixture)
+{
+  Splider::Trajectory<2> trajectory {{0.5, 1.5}, {2.5, 3.1}, {4.9, 6.5}};
+  Linx::Raster<double> raster({8, 8});
+  std::iota(raster.begin(), raster.end(), 0.);
+  const auto build = TMethod::Multi::builder(u, u);
+  auto reference = build.cospline(trajectory);
+  const auto expected = reference(raster);
+
+  std::array<std::byte, 16384> storage;
+  std::pmr::monotonic_buffer_resource arena(storage.data(), storage.size(), std::pmr::null_memory_resource());
+  auto cospline = build.cospline(trajectory, &arena);
+  BOOST_TEST(cospline.resource() == &arena);
+  y.resize(trajectory.size());
+  cospline.transform(raster, y.begin());
+  BOOST_TEST(y == expected, boost::test_tools::per_element());
+}
+
+BOOST_FIXTURE_TEST_CASE(legacy_spline_budget_test, AllocationFixture)
+{
+  const Splider::Partition<double> domain(u);
+  const Splider::Args<double> args(domain, x);
+  Splider::Spline<double> spline(domain, v);
+  const auto vector_allocations = profile([&]() {
+    spline.assign(w);
+    y = spline(args);
+  });
+  BOOST_TEST(vector_allocations.count == 1); // Output vector
+  const auto allocations = profile([&]() {
+    spline.assign(v);
+    spline.transform(args, y.begin());
+  });
+  BOOST_TEST(allocations.count == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(legacy_cospline_budget_test, AllocationFixture)
+{
+  const Splider::Partition<double> domain(u);
+  Splider::Cospline<double> cospline(domain, x);
+  cospline(v);
+  const auto vector_allocations = profile([&]() {
+    y = cospline(w);
+  });
+  BOOST_TEST(vector_allocations.count == 1); // Output vector
+  const auto allocations = profile([&]() {
+    cospline.transform(v.begin(), v.end(), y.begin());
+  });
+  BOOST_TEST(allocations.count == 0);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,91 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Splider/C2.h"
+#include "Splider/CatmullRom.h"
+#include "Splider/Hermite.h"
+#include "Splider/Lagrange.h"
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Arithmetic_test)
+
+//-----------------------------------------------------------------------------
+
+using Methods = boost::mpl::list<
+    Splider::C2,
+    Splider::C2::FiniteDiff,
+    Splider::Hermite::FiniteDiff,
+    Splider::Hermite::CatmullRom::Uniform,
+    Splider::Lagrange>;
+
+struct TemplatesFixture {
+  std::vector<double> u {0, 1, 2, 3, 4, 5, 6, 7};
+  std::vector<double> background {1, 2, 1, 2, 1, 2, 1, 2};
+  std::vector<double> signal {0, 1, 4, 9, 16, 25, 36, 49};
+  std::vector<double> x {0, 0.5, 1.5, 2.5, 3.1, 4.9, 6.5, 7};
+};
+
+template <typename TSpline>
+void check_combination(TSpline& spline, const std::vector<double>& x, const std::vector<double>& expected)
+{
+  const auto y = spline(x);
+  for (std::size_t k = 0; k < x.size(); ++k) {
+    BOOST_TEST(y[k] == expected[k], boost::test_tools::tolerance(1e-12));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(axpy_test, TMethod, Methods, TemplatesFixture)
+{
+  const auto build = TMethod::builder(u);
+  auto b = build.spline(background);
+  auto s = build.spline(signal);
+  const auto yb = b(x);
+  const auto ys = s(x);
+  std::vector<double> expected(x.size());
+  for (std::size_t k = 0; k < x.size(); ++k) {
+    expected[k] = ys[k] - 0.5 * yb[k];
+  }
+  s.axpy(-0.5, b);
+  check_combination(s, x, expected);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(lazy_axpy_test, TMethod, Methods, TemplatesFixture)
+{
+  const auto build = TMethod::builder(u);
+  auto b = build.spline(background);
+  auto s = build.spline(signal);
+  const auto expected = [&]() {
+    auto b2 = build.spline(background);
+    auto s2 = build.spline(signal);
+    const auto yb = b2(x);
+    const auto ys = s2(x);
+    std::vector<double> out(x.size());
+    for (std::size_t k = 0; k < x.size(); ++k) {
+      out[k] = 3 * (ys[k] + 2 * yb[k]);
+    }
+    return out;
+  }();
+  s.axpy(2, b).scale(3); // Not solved yet
+  check_combination(s, x, expected);
+}
+
+BOOST_FIXTURE_TEST_CASE(domain_mismatch_test, TemplatesFixture)
+{
+  const auto build = Splider::C2::builder(u);
+  const auto other = Splider::C2::builder(std::vector<double> {0, 1, 2, 3, 4, 5, 6, 8});
+  const auto same = Splider::C2::builder(u);
+  auto s = build.spline(signal);
+  auto b = other.spline(background);
+  auto c = same.spline(background);
+  BOOST_CHECK_THROW(s.axpy(1, b), std::runtime_error);
+  BOOST_CHECK_NO_THROW(s.axpy(1, c));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,91 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Linx/Data/Sequence.h"
+#include "Splider/Autotuner.h"
+
+#include <boost/test/unit_test.hpp>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Autotuner_test)
+
+//-----------------------------------------------------------------------------
+
+struct SinFixture {
+  Linx::Sequence<double> u = Linx::Sequence<double>(64).linspace(0, 10);
+  Linx::Sequence<double> x = Linx::Sequence<double>(1000).linspace(0, 10);
+  std::vector<double> v;
+
+  SinFixture() : v(u.size())
+  {
+    std::transform(u.begin(), u.end(), v.begin(), [](double e) {
+      return std::sin(e);
+    });
+  }
+};
+
+BOOST_AUTO_TEST_CASE(serialization_test)
+{
+  Splider::Tuning tuning;
+  tuning.method = "Lagrange";
+  tuning.domain = "linspace";
+  tuning.layout = "spline";
+  tuning.batch = 256;
+  tuning.threads = 4;
+  tuning.prefetch = 16;
+  tuning.error = 1.e-5;
+  tuning.ns_per_element = 3.5;
+  const auto parsed = Splider::Tuning::parse(tuning.serialize());
+  BOOST_TEST(parsed.method == tuning.method);
+  BOOST_TEST(parsed.domain == tuning.domain);
+  BOOST_TEST(parsed.layout == tuning.layout);
+  BOOST_TEST(parsed.batch == tuning.batch);
+  BOOST_TEST(parsed.threads == tuning.threads);
+  BOOST_TEST(parsed.prefetch == tuning.prefetch);
+  BOOST_TEST(parsed.error == tuning.error);
+  BOOST_TEST(parsed.ns_per_element == tuning.ns_per_element);
+  BOOST_CHECK_THROW(Splider::Tuning::parse("speed=max"), std::runtime_error);
+}
+
+BOOST_FIXTURE_TEST_CASE(tuned_resampler_test, SinFixture)
+{
+  const auto expected = Splider::C2::builder(u).cospline(x)(v);
+  Splider::Tuning tuning;
+  for (const auto& domain : {"partition", "linspace"}) {
+    for (const auto& layout : {"cospline", "spline"}) {
+      for (auto threads : {1, 3}) {
+        for (auto prefetch : {0, 4}) {
+          tuning.domain = domain;
+          tuning.layout = layout;
+          tuning.batch = 100;
+          tuning.threads = threads;
+          tuning.prefetch = prefetch;
+          const auto y = Splider::TunedResampler<double>(tuning, u, x)(v);
+          BOOST_TEST(y == expected, boost::test_tools::tolerance(1.e-9) << boost::test_tools::per_element());
+        }
+      }
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(tune_test, SinFixture)
+{
+  Splider::Autotuner<double> tuner(u, v, x);
+  tuner.batches({0, 100});
+  tuner.threads({1, 2});
+  tuner.prefetches({0, 8});
+  tuner.repetitions(1);
+  BOOST_TEST(tuner.is_even());
+  const double tolerance = 1.e-3;
+  const auto tuning = tuner.tune(tolerance);
+  BOOST_TEST(tuning.error <= tolerance);
+  BOOST_TEST(tuning.ns_per_element > 0);
+  BOOST_TEST(tuning.method != "HermiteFD"); // Inaccurate
+  BOOST_CHECK_THROW(tuner.tune(0), std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
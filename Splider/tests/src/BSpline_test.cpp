@@ -0,0 +1,117 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Splider/BSpline.h"
+#include "Splider/C2.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(BSpline_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(interpolation_test)
+{
+  for (Linx::Index n : {2, 3, 4, 10, 100}) {
+    const auto build = Splider::BSpline::builder(-1., 0.5, n);
+    std::vector<double> v(n);
+    std::mt19937 generator(n);
+    std::uniform_real_distribution<double> distribution(-1, 1);
+    for (auto& e : v) {
+      e = distribution(generator);
+    }
+    auto spline = build.spline(v);
+    for (Linx::Index i = 0; i < n; ++i) {
+      BOOST_TEST(spline(-1. + 0.5 * i) == v[i], boost::test_tools::tolerance(1e-12));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(smooth_function_test)
+{
+  const Linx::Index n = 200;
+  const double step = 0.05;
+  const auto build = Splider::BSpline::builder(0., step, n);
+  std::vector<double> u(n);
+  std::vector<double> v(n);
+  for (Linx::Index i = 0; i < n; ++i) {
+    u[i] = step * i;
+    v[i] = std::sin(u[i]);
+  }
+  auto spline = build.spline(v);
+  const auto c2_build = Splider::C2::builder(u);
+  auto c2 = c2_build.spline(v);
+  for (double x = 1; x < 9; x += 0.0137) {
+    BOOST_TEST(spline(x) == std::sin(x), boost::test_tools::tolerance(1e-6));
+    BOOST_TEST(spline(x) == c2(x), boost::test_tools::tolerance(1e-6));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_test)
+{
+  const auto build = Splider::BSpline::builder(0., 1., 10);
+  std::vector<double> v {1, 2, 0, -1, 3, 4, 2, 2, 0, 1};
+  auto spline = build.spline(v);
+  auto polynomial = spline.polynomial();
+  for (double x = 0; x < 9; x += 0.1) {
+    BOOST_TEST(std::abs(polynomial(x) - spline(x)) < 1e-12);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(cospline_test)
+{
+  std::vector<double> u {0, 1, 2, 3, 4, 5};
+  std::vector<double> v {0, 1, 4, 9, 16, 25};
+  std::vector<double> x {0.5, 2.25, 4.9, 5};
+  const auto build = Splider::BSpline::builder(u);
+  auto spline = build.spline(v);
+  auto cospline = build.cospline(x);
+  const auto y = cospline(v);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    BOOST_TEST(y[i] == spline(x[i]));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(nonuniform_test)
+{
+  std::vector<double> u {0, 1, 2.5, 3};
+  BOOST_CHECK_THROW(Splider::BSpline::builder(u), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(bispline_test)
+{
+  const Linx::Index n0 = 7;
+  const Linx::Index n1 = 5;
+  const Splider::Linspace<double> u0(0, 1, n0);
+  const Splider::Linspace<double> u1(-2, 0.5, n1);
+  std::vector<double> v(n0 * n1);
+  for (Linx::Index j = 0; j < n1; ++j) {
+    for (Linx::Index i = 0; i < n0; ++i) {
+      v[i + j * n0] = std::cos(0.4 * i) * std::sin(1.3 * j) + i * j;
+    }
+  }
+  Splider::BiBSpline<Splider::Linspace<double>, double> spline(u0, u1);
+  spline.assign(v);
+  for (Linx::Index j = 0; j < n1; ++j) {
+    for (Linx::Index i = 0; i < n0; ++i) {
+      BOOST_TEST(spline(u0[i], u1[j]) == v[i + j * n0], boost::test_tools::tolerance(1e-12));
+    }
+  }
+
+  // Separability: along the knots of an axis, the bivariate spline is the univariate spline
+  std::vector<double> row(v.begin() + 2 * n0, v.begin() + 3 * n0);
+  const auto line_build = Splider::BSpline::builder(0., 1., n0);
+  auto line = line_build.spline(row);
+  for (double x = 0; x < n0 - 1; x += 0.21) {
+    BOOST_TEST(spline(x, u1[2]) == line(x), boost::test_tools::tolerance(1e-12));
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
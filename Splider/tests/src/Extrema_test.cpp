@@ -0,0 +1,134 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Splider/C2.h"
+#include "Splider/CatmullRom.h"
+#include "Splider/Hermite.h"
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Extrema_test)
+
+//-----------------------------------------------------------------------------
+
+using Methods = boost::mpl::
+    list<Splider::C2, Splider::C2::FiniteDiff, Splider::Hermite::FiniteDiff, Splider::Hermite::CatmullRom::Uniform>;
+
+struct SineFixture {
+  static constexpr double pi = 3.14159265358979323846;
+  std::vector<double> u;
+  std::vector<double> v;
+
+  SineFixture() : u(41), v(41)
+  {
+    for (std::size_t i = 0; i < u.size(); ++i) {
+      u[i] = 0.1 + 0.3 * i;
+      v[i] = std::sin(u[i]);
+    }
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(extrema_test, TMethod, Methods, SineFixture)
+{
+  const auto build = TMethod::builder(u);
+  auto spline = build.spline(v);
+  const auto extrema = spline.extrema();
+  BOOST_TEST(extrema.size() == 4); // pi/2, 3pi/2, 5pi/2, 7pi/2 within [0.1, 12.1]
+  const double delta = 1e-4;
+  for (std::size_t k = 0; k < extrema.size(); ++k) {
+    const auto& e = extrema[k];
+    BOOST_TEST(e.x == pi / 2 + k * pi, boost::test_tools::tolerance(1e-2));
+    BOOST_TEST(e.maximum == (k % 2 == 0));
+    BOOST_TEST(e.value == spline(e.x), boost::test_tools::tolerance(1e-12));
+    const auto left = spline(e.x - delta);
+    const auto right = spline(e.x + delta);
+    if (e.maximum) {
+      BOOST_TEST(e.value >= std::max(left, right));
+    } else {
+      BOOST_TEST(e.value <= std::min(left, right));
+    }
+    BOOST_TEST(left - right == 0, boost::test_tools::tolerance(1e-6)); // Symmetric at first order
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(roots_test, TMethod, Methods, SineFixture)
+{
+  const auto build = TMethod::builder(u);
+  auto spline = build.spline(v);
+  const auto zeros = spline.roots();
+  BOOST_TEST(zeros.size() == 3); // pi, 2pi, 3pi
+  for (std::size_t k = 0; k < zeros.size(); ++k) {
+    BOOST_TEST(zeros[k] == (k + 1) * pi, boost::test_tools::tolerance(1e-2));
+    BOOST_TEST(spline(zeros[k]) == 0, boost::test_tools::tolerance(1e-12));
+  }
+  const auto halves = spline.roots(0.5);
+  BOOST_TEST(halves.size() == 4);
+  for (std::size_t k = 1; k < halves.size(); ++k) {
+    BOOST_TEST(halves[k - 1] < halves[k]);
+  }
+  for (auto x : halves) {
+    BOOST_TEST(spline(x) == 0.5, boost::test_tools::tolerance(1e-12));
+  }
+}
+
+/**
+ * @brief The methods which are at least C1, such that the derivative vanishes at an extremum on a knot.
+ *
+ * `C2::FiniteDiff` is not: an extremum on a knot is a corner.
+ */
+using C1Methods = boost::mpl::list<Splider::C2, Splider::Hermite::FiniteDiff, Splider::Hermite::CatmullRom::Uniform>;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(knot_extremum_test, TMethod, C1Methods)
+{
+  const std::vector<double> v {0, 1, 3, 4, 3, 1, 0}; // Symmetric about knot 3
+  for (double front : {0.1, 0.3, 1.7, -2.2}) {
+    for (double step : {0.01, 0.1, 0.3, 0.7, 1.1}) { // Inexact abscissae
+      std::vector<double> u(v.size());
+      for (std::size_t i = 0; i < u.size(); ++i) {
+        u[i] = front + step * i;
+      }
+      const auto build = TMethod::builder(u);
+      auto spline = build.spline(v);
+      const auto extrema = spline.extrema();
+      BOOST_TEST(extrema.size() == 1); // Neither missed nor duplicated by the intervals on both sides
+      if (extrema.size() == 1) {
+        BOOST_TEST(extrema[0].x == u[3], boost::test_tools::tolerance(1e-9));
+        BOOST_TEST(extrema[0].maximum);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(bound_extremum_test)
+{
+  const std::vector<double> u {0, 1, 2, 3, 4};
+  const std::vector<double> v {1, 1, 0, -1, -2}; // Null finite difference at the left bound
+  const auto build = Splider::Hermite::FiniteDiff::builder(u);
+  auto spline = build.spline(v);
+  const auto extrema = spline.extrema();
+  for (const auto& e : extrema) {
+    BOOST_TEST(e.x > u.front()); // Bounds are not interior
+    BOOST_TEST(e.x < u.back());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(knot_roots_test)
+{
+  const std::vector<double> u {0, 1, 2, 3, 4};
+  const std::vector<double> v {1, 0, -1, 0, 1};
+  const auto build = Splider::C2::builder(u);
+  auto spline = build.spline(v);
+  const auto zeros = spline.roots();
+  BOOST_TEST(zeros == std::vector<double>({1, 3}), boost::test_tools::per_element());
+  const auto ones = spline.roots(1);
+  BOOST_TEST(ones.front() == 0);
+  BOOST_TEST(ones.back() == 4);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
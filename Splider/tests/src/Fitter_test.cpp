@@ -0,0 +1,173 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Splider/Fitter.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Fitter_test)
+
+//-----------------------------------------------------------------------------
+
+struct SampleFixture {
+  std::vector<double> v; // Knot values
+  std::vector<double> x;
+  std::vector<double> y;
+
+  SampleFixture() : v(12), x(5000), y(5000)
+  {
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> value(-1, 1);
+    std::uniform_real_distribution<double> abscissa(0, 11);
+    for (auto& e : v) {
+      e = value(generator);
+    }
+    for (auto& e : x) {
+      e = abscissa(generator);
+    }
+    x.front() = 0;
+    x.back() = 11;
+    const auto builder = Splider::BSpline::builder(0., 1., 12);
+    auto spline = builder.spline(v);
+    for (std::size_t k = 0; k < x.size(); ++k) {
+      y[k] = spline(x[k]);
+    }
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(exact_samples_test, SampleFixture)
+{
+  Splider::Fitter<> fitter(0, 1, 12);
+  fitter.add(x, y);
+  BOOST_TEST(fitter.count() == x.size());
+  const auto& fitted = fitter.fit();
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    BOOST_TEST(fitted[i] == v[i], boost::test_tools::tolerance(1e-9));
+  }
+  auto spline = fitter.spline();
+  const auto builder = Splider::BSpline::builder(0., 1., 12);
+  auto expected = builder.spline(v);
+  for (double u = 0; u <= 11; u += 0.37) {
+    BOOST_TEST(std::abs(spline(u) - expected(u)) < 1e-9);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(streaming_threads_merge_test, SampleFixture)
+{
+  Splider::Fitter<> reference(0, 1, 12);
+  reference.add(x, y);
+  const auto& expected = reference.fit(0.1);
+
+  const auto half = x.size() / 2;
+  const std::vector<double> x0(x.begin(), x.begin() + half);
+  const std::vector<double> y0(y.begin(), y.begin() + half);
+  const std::vector<double> x1(x.begin() + half, x.end());
+  const std::vector<double> y1(y.begin() + half, y.end());
+
+  Splider::Fitter<> streamed(0, 1, 12);
+  streamed.add(x0, y0, 3);
+  streamed.add(x1, y1, 2);
+  const auto& parallel = streamed.fit(0.1);
+
+  Splider::Fitter<> merged(0, 1, 12);
+  Splider::Fitter<> other(0, 1, 12);
+  merged.add(x1, y1);
+  other.add(x0, y0);
+  merged.merge(other);
+  const auto& reduced = merged.fit(0.1);
+
+  BOOST_TEST(streamed.count() == x.size());
+  BOOST_TEST(merged.count() == x.size());
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    BOOST_TEST(parallel[i] == expected[i], boost::test_tools::tolerance(1e-12));
+    BOOST_TEST(reduced[i] == expected[i], boost::test_tools::tolerance(1e-12));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(noisy_weighted_samples_test)
+{
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> abscissa(0, 2 * M_PI);
+  std::normal_distribution<double> noise(0, 1);
+  std::uniform_real_distribution<double> sigma(0.01, 0.1);
+  std::vector<double> x(100000);
+  std::vector<double> y(x.size());
+  std::vector<double> w(x.size());
+  for (std::size_t k = 0; k < x.size(); ++k) {
+    const auto s = sigma(generator);
+    x[k] = abscissa(generator);
+    y[k] = std::cos(x[k]) + s * noise(generator);
+    w[k] = 1 / (s * s);
+  }
+  const double step = 2 * M_PI / 19;
+  Splider::Fitter<> fitter(0, step, 20);
+  fitter.add(x, y, w, 4);
+  fitter.fit();
+  auto spline = fitter.spline();
+  for (double u = 0; u <= 2 * M_PI; u += 0.1) {
+    BOOST_TEST(std::abs(spline(u) - std::cos(u)) < 1e-3);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(penalty_test)
+{
+  // Samples in the first and last subintervals only
+  const std::vector<double> x {0, 0.2, 0.5, 0.8, 9.2, 9.5, 9.8, 10};
+  const std::vector<double> y(x.size(), 3);
+  Splider::Fitter<> fitter(0, 1, 11);
+  fitter.add(x, y);
+  BOOST_CHECK_THROW(fitter.fit(), std::runtime_error);
+  BOOST_CHECK_THROW(fitter.spline(), std::runtime_error);
+  const auto& fitted = fitter.fit(1e-3);
+  for (const auto& e : fitted) {
+    BOOST_TEST(e == 3, boost::test_tools::tolerance(1e-9)); // Constants are not penalized
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(failed_chunk_test, SampleFixture)
+{
+  Splider::Fitter<> fitter(0, 1, 12);
+  fitter.add(x, y);
+  const auto count = fitter.count();
+  const std::vector<double> expected(fitter.fit().begin(), fitter.fit().end());
+  for (Linx::Index threads : {1, 4}) {
+    for (std::size_t k : {std::size_t(1000), x.size() - 1}) {
+      auto bad = x;
+      bad[k] = 12;
+      BOOST_CHECK_THROW(fitter.add(bad, y, threads), std::runtime_error);
+      BOOST_TEST(fitter.count() == count);
+      const auto& fitted = fitter.fit();
+      for (std::size_t i = 0; i < expected.size(); ++i) {
+        BOOST_TEST(fitted[i] == expected[i]);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(invalid_input_test)
+{
+  BOOST_CHECK_THROW(Splider::Fitter<>(0, 1, 1), std::runtime_error);
+  BOOST_CHECK_THROW(Splider::Fitter<>(0, 1, -1), std::runtime_error);
+  Splider::Fitter<> fitter(0, 1, 5);
+  const std::vector<double> x {0, 1, 2};
+  const std::vector<double> y {0, 1};
+  BOOST_CHECK_THROW(fitter.add(x, y), std::runtime_error);
+  const std::vector<double> out {0, 5};
+  BOOST_CHECK_THROW(fitter.add(out, y), std::runtime_error);
+  std::vector<double> many(10000, 1);
+  many.back() = 5;
+  BOOST_CHECK_THROW(fitter.add(many, many, 4), std::runtime_error);
+  BOOST_CHECK_THROW(fitter.add(x, x, y), std::runtime_error);
+  BOOST_CHECK_THROW(fitter.fit(-1), std::runtime_error);
+  Splider::Fitter<> other(0, 2, 5);
+  BOOST_CHECK_THROW(fitter.merge(other), std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
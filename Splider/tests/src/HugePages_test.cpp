@@ -0,0 +1,120 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Splider/C2.h"
+#include "Splider/HugePages.h"
+
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(HugePages_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(small_buffer_upstream_test)
+{
+  Splider::HugePageResource resource(Splider::HugePages::Transparent);
+  auto data = resource.allocate(1024);
+  BOOST_TEST(resource.mapped_bytes() == 0);
+  resource.deallocate(data, 1024);
+}
+
+BOOST_AUTO_TEST_CASE(large_buffer_alignment_test)
+{
+  for (auto policy : {Splider::HugePages::Transparent, Splider::HugePages::Explicit}) {
+    Splider::HugePageResource resource(policy, 2);
+    const std::size_t size = 3 << 20;
+    auto data = static_cast<char*>(resource.allocate(size));
+    BOOST_TEST(reinterpret_cast<std::uintptr_t>(data) % Splider::HugePageResource::PageSize == 0);
+    BOOST_TEST(resource.mapped_bytes() == 2 * Splider::HugePageResource::PageSize);
+    BOOST_TEST(data[0] == 0); // First-touched
+    BOOST_TEST(data[size - 1] == 0);
+    data[size - 1] = 1;
+    resource.deallocate(data, size);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(none_policy_test)
+{
+  Splider::HugePageResource resource(Splider::HugePages::None);
+  const std::size_t size = 3 << 20;
+  auto data = resource.allocate(size);
+  BOOST_TEST(resource.mapped_bytes() == 0);
+  resource.deallocate(data, size);
+}
+
+BOOST_AUTO_TEST_CASE(first_touch_blocks_test)
+{
+  const std::size_t size = 100000;
+  const std::size_t block = 7000;
+  std::vector<char> data(size, 1);
+  Splider::first_touch(data.data(), size, 3, block);
+  for (std::size_t begin = 0; begin < size; begin += block) {
+    BOOST_TEST(data[begin] == 0);
+    BOOST_TEST(data[std::min(begin + block, size) - 1] == 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(first_touch_single_thread_test)
+{
+  const std::size_t size = 100000;
+  std::vector<char> data(size, 1);
+  Splider::first_touch(data.data(), size, 1);
+  BOOST_TEST(data.front() == 0);
+  BOOST_TEST(data.back() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(rank_cpus_test)
+{
+  auto cpus = Splider::rank_cpus();
+  std::sort(cpus.begin(), cpus.end());
+  BOOST_TEST(cpus == Splider::available_cpus()); // Permutation
+}
+
+BOOST_AUTO_TEST_CASE(run_pinned_test)
+{
+  const auto available = Splider::available_cpus();
+  const auto cpus = Splider::rank_cpus();
+  const Linx::Index threads = 5;
+  std::vector<std::vector<int>> pinned(threads);
+  Splider::run_pinned(threads, [&](Linx::Index t) {
+    pinned[t] = Splider::available_cpus();
+  });
+  BOOST_TEST(Splider::available_cpus() == available); // Calling thread not pinned
+  for (Linx::Index t = 0; t < threads; ++t) {
+    if (cpus.empty()) {
+      BOOST_TEST(pinned[t].empty());
+    } else {
+      BOOST_TEST(pinned[t] == std::vector<int> {cpus[t % cpus.size()]}); // Same rank, same CPU
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(cospline_test)
+{
+  const std::vector<double> u {0, 1, 2, 3, 4, 5, 6, 7};
+  const std::vector<double> v {0, 1, 4, 9, 16, 25, 36, 49};
+  std::vector<double> x(100000);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    x[i] = 7. * i / (x.size() - 1);
+  }
+  const auto build = Splider::C2::builder(u);
+  auto reference = build.cospline(x);
+  Splider::HugePageResource resource(Splider::HugePages::Transparent, 4);
+  auto cospline = build.cospline(x, &resource);
+  BOOST_TEST(resource.mapped_bytes() > 0);
+  BOOST_TEST(cospline(v) == reference(v), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(bad_threads_test)
+{
+  BOOST_CHECK_THROW(Splider::HugePageResource(Splider::HugePages::Transparent, 0), std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
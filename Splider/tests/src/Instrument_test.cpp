@@ -0,0 +1,110 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Splider/C2.h"
+#include "Splider/Instrument.h"
+#include "Splider/Lagrange.h"
+
+#include <boost/test/unit_test.hpp>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Instrument_test)
+
+//-----------------------------------------------------------------------------
+
+using Splider::Event;
+
+struct InstrumentFixture {
+  std::vector<double> u {1, 2, 3, 4};
+  std::vector<double> x {1.1, 2.5, 3.9};
+  std::vector<double> v {10, 20, 30, 40};
+};
+
+BOOST_AUTO_TEST_CASE(instrument_test)
+{
+  Splider::Instrument instrument;
+  instrument.increment(Event::Skip, 2);
+  instrument.start(Event::Solve);
+  instrument.stop(Event::Solve);
+  BOOST_TEST(instrument.count(Event::Skip) == 2);
+  BOOST_TEST(instrument.count(Event::Solve) == 1);
+  BOOST_TEST(instrument.count(Event::Evaluation) == 0);
+  BOOST_TEST(instrument.duration(Event::Skip).count() == 0);
+  Splider::Instrument sum;
+  sum += instrument;
+  sum += instrument;
+  BOOST_TEST(sum.count(Event::Skip) == 4);
+  std::size_t visited = 0;
+  sum.visit([&](const char*, std::size_t, Splider::Instrument::Duration) {
+    ++visited;
+  });
+  BOOST_TEST(visited == Splider::Instrument::EventCount);
+  sum.reset();
+  BOOST_TEST(sum.count(Event::Skip) == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(c2_spline_counts_test, InstrumentFixture)
+{
+  const auto build = Splider::C2::builder(u);
+  auto spline = build.spline<double, Splider::Instrument>();
+  spline.assign(v);
+  spline(x);
+  spline(x);
+  spline.set(1, 0.);
+  spline(x[0]);
+  const auto& instrument = spline.instrument();
+  BOOST_TEST(instrument.count(Event::Solve) == 2);
+  BOOST_TEST(instrument.count(Event::Invalidation) == 2); // Null knots are valid
+  BOOST_TEST(instrument.count(Event::Batch) == 2);
+  BOOST_TEST(instrument.count(Event::Evaluation) == 7);
+  BOOST_TEST(instrument.count(Event::Argument) == 7);
+}
+
+BOOST_FIXTURE_TEST_CASE(valued_spline_counts_test, InstrumentFixture)
+{
+  const auto build = Splider::C2::builder(u);
+  auto spline = build.spline<Splider::Instrument>(v.begin(), v.end(), Splider::default_resource());
+  spline(x);
+  auto ranged = build.spline<Splider::Instrument>(v);
+  ranged(x[0]);
+  BOOST_TEST(spline.instrument().count(Event::Solve) == 1);
+  BOOST_TEST(spline.instrument().count(Event::Evaluation) == 3);
+  BOOST_TEST(ranged.instrument().count(Event::Evaluation) == 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(c2_cospline_counts_test, InstrumentFixture)
+{
+  const auto build = Splider::C2::builder(u);
+  auto cospline = build.cospline<double, Splider::Instrument>(x);
+  cospline(v);
+  cospline(v);
+  BOOST_TEST(cospline.instrument().count(Event::Argument) == x.size());
+  BOOST_TEST(cospline.instrument().count(Event::Batch) == 2);
+  BOOST_TEST(cospline.spline().instrument().count(Event::Solve) == 2);
+  BOOST_TEST(cospline.spline().instrument().count(Event::Evaluation) == 2 * x.size());
+}
+
+BOOST_FIXTURE_TEST_CASE(lagrange_cospline_counts_test, InstrumentFixture)
+{
+  const auto build = Splider::Lagrange::builder(u);
+  auto cospline = build.cospline<double, Splider::Instrument>(x);
+  const auto out = cospline(v);
+  BOOST_TEST(out.size() == x.size());
+  BOOST_TEST(cospline.instrument().count(Event::Batch) == 1);
+  BOOST_TEST(cospline.spline().instrument().count(Event::Evaluation) == x.size());
+}
+
+BOOST_FIXTURE_TEST_CASE(disabled_instrument_test, InstrumentFixture)
+{
+  const auto build = Splider::C2::builder(u);
+  auto instrumented = build.cospline<double, Splider::Instrument>(x);
+  auto cospline = build.cospline(x);
+  BOOST_TEST(not decltype(cospline)::Instrument::Enabled);
+  BOOST_TEST(cospline(v) == instrumented(v));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,99 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Splider/C2.h"
+#include "Splider/CatmullRom.h"
+#include "Splider/Hermite.h"
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+#include <random>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Integral_test)
+
+//-----------------------------------------------------------------------------
+
+using Methods = boost::mpl::
+    list<Splider::C2, Splider::C2::FiniteDiff, Splider::Hermite::FiniteDiff, Splider::Hermite::CatmullRom::Uniform>;
+
+struct SpectrumFixture {
+  std::vector<double> u {0, 1, 2, 3, 4, 5, 6, 7, 8};
+  std::vector<double> v {1, 3, 2, 5, 4, 4, 0, 1, 2};
+  std::vector<std::pair<double, double>> bounds {{0, 8}, {0.5, 1.5}, {2.25, 2.75}, {7.5, 0.1}, {3, 3}, {1, 6}};
+};
+
+/**
+ * @brief Integrate a spline with Simpson's rule over each piece, which is exact for cubics.
+ */
+template <typename TSpline>
+double simpson(TSpline& spline, const std::vector<double>& u, double a, double b)
+{
+  if (a > b) {
+    return -simpson(spline, u, b, a);
+  }
+  std::vector<double> cuts {a};
+  for (auto e : u) {
+    if (e > a && e < b) {
+      cuts.push_back(e);
+    }
+  }
+  cuts.push_back(b);
+  double out = 0;
+  for (std::size_t k = 1; k < cuts.size(); ++k) {
+    const auto l = cuts[k - 1];
+    const auto r = cuts[k];
+    out += (r - l) / 6 * (spline(l) + 4 * spline((l + r) / 2) + spline(r));
+  }
+  return out;
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(integral_test, TMethod, Methods, SpectrumFixture)
+{
+  const auto build = TMethod::builder(u);
+  auto spline = build.spline(v);
+  for (const auto& ab : bounds) {
+    BOOST_TEST(
+        spline.integral(ab.first, ab.second) == simpson(spline, u, ab.first, ab.second),
+        boost::test_tools::tolerance(1e-12));
+  }
+  BOOST_TEST(spline.primitive(0.) == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(precomputed_primitive_test, TMethod, Methods, SpectrumFixture)
+{
+  const auto build = TMethod::builder(u);
+  auto spline = build.spline(v);
+  std::vector<double> x {7.9, 0.2, 3.5, 8};
+  std::vector<Splider::PolynomialArg<Splider::Partition<double>>> args;
+  for (auto e : x) {
+    args.emplace_back(spline.domain(), e);
+  }
+  std::vector<double> expected(x.size());
+  spline.primitive(x.begin(), x.end(), expected.begin());
+  std::vector<double> y(x.size());
+  spline.primitive(args.begin(), args.end(), y.begin());
+  BOOST_TEST(y == expected, boost::test_tools::per_element());
+  BOOST_TEST(spline.integral(args[1], args[0]) == expected[0] - expected[1]);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(invalidation_test, TMethod, Methods, SpectrumFixture)
+{
+  const auto build = TMethod::builder(u);
+  auto spline = build.spline(v);
+  auto background = build.spline(std::vector<double>(v.size(), 1.));
+  spline.integral(0, 8); // Fill the table
+  spline.set(5, 10);
+  BOOST_TEST(spline.integral(0, 8) == simpson(spline, u, 0, 8), boost::test_tools::tolerance(1e-12));
+  const auto before = spline.integral(0.5, 7.5);
+  spline.axpy(-1, background);
+  BOOST_TEST(spline.integral(0.5, 7.5) == before - 7, boost::test_tools::tolerance(1e-12));
+  spline.scale(2);
+  BOOST_TEST(spline.integral(0.5, 7.5) == 2 * (before - 7), boost::test_tools::tolerance(1e-12));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,96 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Splider/C2.h"
+#include "Splider/CatmullRom.h"
+#include "Splider/Hermite.h"
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+#include <random>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Inverse_test)
+
+//-----------------------------------------------------------------------------
+
+using Methods = boost::mpl::
+    list<Splider::C2, Splider::C2::FiniteDiff, Splider::Hermite::FiniteDiff, Splider::Hermite::CatmullRom::Uniform>;
+
+struct CalibrationFixture {
+  std::vector<double> u;
+  std::vector<double> v;
+  std::vector<double> y;
+
+  CalibrationFixture() : u(21), v(21), y(1000)
+  {
+    for (std::size_t i = 0; i < u.size(); ++i) {
+      u[i] = i;
+      v[i] = 400 + 2 * u[i] + 0.3 * std::sin(u[i]);
+    }
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> distribution(v.front(), v.back());
+    for (auto& e : y) {
+      e = distribution(generator);
+    }
+    y.push_back(v.front());
+    y.push_back(v.back());
+    y.push_back(v[7]);
+  }
+};
+
+template <typename TSpline>
+void check_inverse(TSpline& spline, const std::vector<double>& y)
+{
+  const auto x = spline.inverse(y);
+  BOOST_TEST(x.size() == y.size());
+  const auto z = spline(x);
+  for (std::size_t k = 0; k < y.size(); ++k) {
+    BOOST_TEST(z[k] == y[k], boost::test_tools::tolerance(1e-12));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(increasing_test, TMethod, Methods, CalibrationFixture)
+{
+  const auto build = TMethod::builder(u);
+  auto spline = build.spline(v);
+  check_inverse(spline, y);
+  std::sort(y.begin(), y.end());
+  check_inverse(spline, y);
+  BOOST_TEST(spline(spline.inverse(y[10])) == y[10], boost::test_tools::tolerance(1e-12));
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(decreasing_test, TMethod, Methods, CalibrationFixture)
+{
+  for (auto& e : v) {
+    e = -e;
+  }
+  for (auto& e : y) {
+    e = -e;
+  }
+  const auto build = TMethod::builder(u);
+  auto spline = build.spline(v);
+  check_inverse(spline, y);
+}
+
+BOOST_FIXTURE_TEST_CASE(out_of_range_test, CalibrationFixture)
+{
+  const auto build = Splider::C2::builder(u);
+  auto spline = build.spline(v);
+  BOOST_CHECK_THROW(spline.inverse(std::vector<double> {v.back() + 1}), std::runtime_error);
+  BOOST_CHECK_THROW(spline.inverse(v.front() - 1), std::runtime_error);
+}
+
+BOOST_FIXTURE_TEST_CASE(non_monotonic_test, CalibrationFixture)
+{
+  std::swap(v[3], v[4]);
+  const auto build = Splider::C2::builder(u);
+  auto spline = build.spline(v);
+  BOOST_CHECK_THROW(spline.inverse(y), std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,39 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Splider/C2.h"
+#include "Splider/Linspace.h"
+
+#include <boost/test/unit_test.hpp>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Linspace_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(index_test)
+{
+  const Splider::Linspace<double> u(1, 0.5, 5);
+  for (Linx::Index i = 0; i < u.ssize() - 1; ++i) {
+    BOOST_TEST(u.index(u[i]) == i);
+    BOOST_TEST(u.index(u[i] + 0.25) == i);
+  }
+  BOOST_TEST(u.index(u.back()) == u.ssize() - 2); // Last knot belongs to the last interval, as for Partition
+}
+
+BOOST_AUTO_TEST_CASE(back_evaluation_test)
+{
+  const std::vector<double> v {1, -2, 3, 0, 5};
+  const Splider::Builder<Splider::Linspace<double>, Splider::C2, Splider::C2Bounds, Splider::C2Bounds::Natural>
+      build(1., 0.5, 5);
+  auto spline = build.spline(v);
+  const auto& u = build.domain();
+  BOOST_TEST(spline(u.back()) == v.back(), boost::test_tools::tolerance(1e-12));
+  BOOST_TEST(spline(u.front()) == v.front(), boost::test_tools::tolerance(1e-12));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
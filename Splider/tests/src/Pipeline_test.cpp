@@ -0,0 +1,170 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Splider/C2.h"
+#include "Splider/Pipeline.h"
+
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Pipeline_test)
+
+//-----------------------------------------------------------------------------
+
+struct RowFixture {
+  std::vector<double> u {0, 1, 2, 3, 4, 5, 6, 7};
+  std::vector<double> x {0.5, 1.5, 2.5, 3.1, 4.9, 6.5};
+  Linx::Index rows = 50;
+
+  void fill(Linx::Index r, double* row) const
+  {
+    for (std::size_t i = 0; i < u.size(); ++i) {
+      row[i] = std::sin(u[i] + r);
+    }
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(ordered_output_test, RowFixture)
+{
+  const auto build = Splider::C2::builder(u);
+  auto cospline = build.cospline(x);
+  auto reference = build.cospline(x);
+  Splider::RowPipeline<decltype(cospline)> pipeline(cospline);
+
+  Linx::Index read_count = 0;
+  std::vector<std::vector<double>> outputs;
+  const auto count = pipeline.run(
+      [&](double* row) {
+        if (read_count == rows) {
+          return false;
+        }
+        fill(read_count, row);
+        ++read_count;
+        return true;
+      },
+      [&](const double* row) {
+        outputs.emplace_back(row, row + x.size()); // No assertion in the writer thread
+      });
+  BOOST_TEST(count == rows);
+  BOOST_TEST(outputs.size() == static_cast<std::size_t>(rows));
+  std::vector<double> v(u.size());
+  for (std::size_t r = 0; r < outputs.size(); ++r) {
+    fill(r, v.data());
+    const auto expected = reference(v);
+    BOOST_TEST(outputs[r] == expected, boost::test_tools::per_element());
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(backpressure_test, RowFixture)
+{
+  const auto build = Splider::C2::builder(u);
+  auto cospline = build.cospline(x);
+  Splider::RowPipeline<decltype(cospline)> pipeline(cospline, 3);
+
+  std::atomic<Linx::Index> read_count(0);
+  std::atomic<Linx::Index> write_count(0);
+  Linx::Index max_ahead = 0;
+  pipeline.run(
+      [&](double* row) {
+        max_ahead = std::max(max_ahead, read_count - write_count);
+        if (read_count == rows) {
+          return false;
+        }
+        fill(read_count, row);
+        ++read_count;
+        return true;
+      },
+      [&](const double*) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100)); // Slow writer
+        ++write_count;
+      });
+  BOOST_TEST(max_ahead <= pipeline.depth());
+}
+
+BOOST_FIXTURE_TEST_CASE(exception_test, RowFixture)
+{
+  const auto build = Splider::C2::builder(u);
+  auto cospline = build.cospline(x);
+  Splider::RowPipeline<decltype(cospline)> pipeline(cospline, 2);
+
+  std::atomic<Linx::Index> read_count(0);
+  const auto read = [&](double* row) {
+    fill(read_count, row);
+    ++read_count;
+    return true; // Endless
+  };
+  BOOST_CHECK_THROW(
+      pipeline.run(
+          read,
+          [&](const double*) {
+            if (read_count > 10) {
+              throw std::runtime_error("Disk full");
+            }
+          }),
+      std::runtime_error);
+  BOOST_CHECK_THROW(
+      pipeline.run(
+          [&](double*) -> bool {
+            throw std::runtime_error("Broken pipe");
+          },
+          [&](const double*) {}),
+      std::runtime_error);
+}
+
+/**
+ * @brief A resampler which fails after some rows.
+ */
+struct FailingCospline {
+  using Value = double;
+  std::vector<double> u;
+  Linx::Index failure;
+
+  const std::vector<double>& domain() const
+  {
+    return u;
+  }
+
+  std::size_t size() const
+  {
+    return 1;
+  }
+
+  void transform(const double*, const double*, double* out)
+  {
+    if (--failure < 0) {
+      throw std::runtime_error("Resampling failed");
+    }
+    *out = 0;
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(worker_exception_test, RowFixture)
+{
+  FailingCospline cospline {u, 5};
+  Splider::RowPipeline<FailingCospline> pipeline(cospline, 3);
+  std::atomic<Linx::Index> read_count(0);
+  Linx::Index write_count = 0;
+  BOOST_CHECK_THROW(
+      pipeline.run(
+          [&](double* row) {
+            fill(read_count, row);
+            ++read_count;
+            return true; // Endless
+          },
+          [&](const double*) {
+            ++write_count;
+          }),
+      std::runtime_error);
+  BOOST_TEST(write_count <= 5);
+  BOOST_TEST(read_count <= 6 + pipeline.depth()); // The reader stopped with the worker
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,122 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Splider/C2.h"
+#include "Splider/CatmullRom.h"
+#include "Splider/Hermite.h"
+#include "Splider/Lagrange.h"
+#include "Splider/Polynomial.h"
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+#include <random>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Polynomial_test)
+
+//-----------------------------------------------------------------------------
+
+using Methods = boost::mpl::list<
+    Splider::C2,
+    Splider::C2::FiniteDiff,
+    Splider::Hermite::FiniteDiff,
+    Splider::Hermite::CatmullRom::Uniform,
+    Splider::Lagrange>;
+
+/**
+ * @brief Uneven knots and arguments in every piece, on every knot and at the bounds,
+ * where the pieces of the export meet.
+ */
+struct PiecewiseFixture {
+  std::vector<double> u;
+  std::vector<double> v;
+  std::vector<double> x;
+
+  PiecewiseFixture() : u(50), v(50), x(1000)
+  {
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> step(0.5, 1.5);
+    u[0] = 0;
+    for (std::size_t i = 1; i < u.size(); ++i) {
+      u[i] = u[i - 1] + step(generator);
+    }
+    for (std::size_t i = 0; i < u.size(); ++i) {
+      v[i] = std::sin(0.3 * u[i]);
+    }
+    std::uniform_real_distribution<double> distribution(u.front(), u.back());
+    for (auto& e : x) {
+      e = distribution(generator);
+    }
+    x.insert(x.end(), u.begin(), u.end());
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(export_test, TMethod, Methods, PiecewiseFixture)
+{
+  const auto build = TMethod::builder(u);
+  auto spline = build.spline(v);
+  auto polynomial = spline.polynomial();
+  const auto expected = spline(x);
+  const auto y = polynomial(x);
+  BOOST_TEST(y.size() == expected.size());
+  for (std::size_t k = 0; k < y.size(); ++k) {
+    BOOST_TEST(y[k] == expected[k], boost::test_tools::tolerance(1e-9));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(precomputed_args_test, TMethod, Methods, PiecewiseFixture)
+{
+  const auto build = TMethod::builder(u);
+  auto spline = build.spline(v);
+  auto polynomial = spline.polynomial();
+  using Arg = typename decltype(polynomial)::Arg;
+  BOOST_TEST(sizeof(Arg) < sizeof(typename decltype(spline)::Arg));
+  std::vector<Arg> args;
+  for (auto e : x) {
+    args.emplace_back(spline.domain(), e);
+  }
+  polynomial.prefetch_distance(8);
+  std::vector<double> y(args.size());
+  polynomial.transform(args.begin(), args.end(), y.begin());
+  BOOST_TEST(y == polynomial(x), boost::test_tools::per_element());
+}
+
+BOOST_FIXTURE_TEST_CASE(reassign_test, PiecewiseFixture)
+{
+  const auto build = Splider::C2::builder(u);
+  auto spline = build.spline(v);
+  auto polynomial = spline.polynomial();
+  for (auto& e : v) {
+    e *= 2;
+  }
+  spline.assign(v);
+  polynomial.assign(spline);
+  const auto expected = spline(x);
+  const auto y = polynomial(x);
+  for (std::size_t k = 0; k < y.size(); ++k) {
+    BOOST_TEST(y[k] == expected[k], boost::test_tools::tolerance(1e-9));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(domain_mismatch_test, PiecewiseFixture)
+{
+  const auto build = Splider::C2::builder(u);
+  auto spline = build.spline(v);
+  const Splider::Partition<double> other {0, 1, 2};
+  Splider::PiecewisePolynomial<Splider::Partition<double>, double> polynomial(other);
+  BOOST_CHECK_THROW(polynomial.assign(spline), std::runtime_error);
+  auto shifted = u;
+  shifted[1] += 0.1; // Same knot count, different partition
+  const Splider::Partition<double> same_size(shifted);
+  Splider::PiecewisePolynomial<Splider::Partition<double>, double> other_polynomial(same_size);
+  BOOST_CHECK_THROW(other_polynomial.assign(spline), std::runtime_error);
+  const Splider::Partition<double> copy(u); // Same knots, other object
+  Splider::PiecewisePolynomial<Splider::Partition<double>, double> copy_polynomial(copy);
+  BOOST_CHECK_NO_THROW(copy_polynomial.assign(spline));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
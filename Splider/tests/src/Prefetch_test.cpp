@@ -0,0 +1,89 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Splider/C2.h"
+#include "Splider/CatmullRom.h"
+#include "Splider/Hermite.h"
+#include "Splider/Lagrange.h"
+#include "Splider/Prefetch.h"
+#include "Splider/Spline.h"
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+#include <list>
+#include <random>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Prefetch_test)
+
+//-----------------------------------------------------------------------------
+
+using Methods = boost::mpl::list<
+    Splider::C2,
+    Splider::C2::FiniteDiff,
+    Splider::Hermite::FiniteDiff,
+    Splider::Hermite::CatmullRom::Uniform,
+    Splider::Lagrange>;
+
+/**
+ * @brief Arguments scattered over many knots, such that most gathers miss the cache.
+ *
+ * The number of arguments is tested against prefetching distances which are smaller, equal and larger.
+ */
+struct ScatteredFixture {
+  std::vector<double> u;
+  std::vector<double> v;
+  std::vector<double> x;
+
+  ScatteredFixture() : u(20000), v(20000), x(1000)
+  {
+    for (std::size_t i = 0; i < u.size(); ++i) {
+      u[i] = i;
+      v[i] = std::sin(0.01 * i);
+    }
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> distribution(0, u.back());
+    for (auto& e : x) {
+      e = distribution(generator);
+    }
+  }
+};
+
+BOOST_AUTO_TEST_CASE(can_prefetch_test)
+{
+  using Arg = Splider::C2Arg<Splider::Partition<double>>;
+  BOOST_TEST((Splider::can_prefetch<std::vector<Arg>::const_iterator, Arg>()));
+  BOOST_TEST((Splider::can_prefetch<const Arg*, Arg>()));
+  BOOST_TEST((not Splider::can_prefetch<std::list<Arg>::const_iterator, Arg>()));
+  BOOST_TEST((not Splider::can_prefetch<std::vector<double>::const_iterator, Arg>()));
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(cospline_prefetch_test, TMethod, Methods, ScatteredFixture)
+{
+  const auto build = TMethod::builder(u);
+  auto cospline = build.cospline(x);
+  const auto expected = cospline(v);
+  for (Linx::Index distance : {1, 8, 999, 1000, 5000}) {
+    cospline.prefetch_distance(distance);
+    BOOST_TEST(cospline.spline().prefetch_distance() == distance);
+    BOOST_TEST(cospline(v) == expected, boost::test_tools::per_element());
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(legacy_spline_prefetch_test, ScatteredFixture)
+{
+  const Splider::Partition<double> domain(u);
+  const Splider::Args<double> args(domain, x);
+  Splider::Spline<double> spline(domain, v);
+  const auto expected = spline(args);
+  for (Linx::Index distance : {1, 8, 1000, 5000}) {
+    spline.prefetch_distance(distance);
+    BOOST_TEST(spline(args) == expected, boost::test_tools::per_element());
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,186 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Splider/C2.h"
+#include "Splider/Quintic.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <complex>
+#include <random>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Quintic_test)
+
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief Knots with a step ratio of 100, which stress the block factorization,
+ * and random values, such that all the derivatives are significant.
+ */
+struct UnevenFixture {
+  std::vector<double> u;
+  std::vector<double> v;
+  std::vector<double> x;
+
+  UnevenFixture() : u(40), v(40), x(500)
+  {
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> exponent(-1, 1);
+    u[0] = -3;
+    for (std::size_t i = 1; i < u.size(); ++i) {
+      u[i] = u[i - 1] + 0.5 * std::pow(10., exponent(generator)); // Log-uniform in [0.05, 5]
+    }
+    std::uniform_real_distribution<double> value(-1, 1);
+    for (auto& e : v) {
+      e = value(generator);
+    }
+    std::uniform_real_distribution<double> distribution(u.front(), u.back());
+    for (auto& e : x) {
+      e = distribution(generator);
+    }
+  }
+};
+
+/**
+ * @brief Evaluate the k-th derivative of a polynomial in power basis.
+ */
+template <typename T, std::size_t N>
+T derivative(const std::array<T, N>& p, int k, double s)
+{
+  T out {};
+  for (int j = N - 1; j >= k; --j) {
+    double factor = 1;
+    for (int l = 0; l < k; ++l) {
+      factor *= j - l;
+    }
+    out = out * s + p[j] * factor;
+  }
+  return out;
+}
+
+BOOST_AUTO_TEST_CASE(linear_test)
+{
+  const auto build = Splider::Quintic::builder({1., 2., 4., 5., 7.});
+  auto spline = build.spline({10., 20., 40., 50., 70.});
+  for (double x = 1; x <= 7; x += 0.25) {
+    BOOST_TEST(spline(x) == 10 * x, boost::test_tools::tolerance(1e-12));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(interpolation_test, UnevenFixture)
+{
+  const auto build = Splider::Quintic::builder(u);
+  auto spline = build.spline(v);
+  for (std::size_t i = 0; i < u.size(); ++i) {
+    BOOST_TEST(std::abs(spline(u[i]) - v[i]) < 1e-12);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(continuity_test, UnevenFixture)
+{
+  const auto build = Splider::Quintic::builder(u);
+  auto spline = build.spline(v);
+  const auto n = build.domain().ssize();
+  for (int k = 2; k <= 4; k += 2) {
+    BOOST_TEST(std::abs(derivative(spline.coefficients(0), k, 0)) < 1e-12);
+    BOOST_TEST(std::abs(derivative(spline.coefficients(n - 2), k, build.domain().length(n - 2))) < 1e-9);
+  }
+  for (Linx::Index i = 0; i < n - 2; ++i) {
+    const auto left = spline.coefficients(i);
+    const auto right = spline.coefficients(i + 1);
+    const auto h = build.domain().length(i);
+    for (int k = 0; k <= 4; ++k) {
+      const auto expected = derivative(right, k, 0);
+      BOOST_TEST(derivative(left, k, h) == expected, boost::test_tools::tolerance(1e-8));
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(coefficients_test, UnevenFixture)
+{
+  const auto build = Splider::Quintic::builder(u);
+  auto spline = build.spline(v);
+  for (auto e : x) {
+    const auto i = build.domain().index(e);
+    const auto y = derivative(spline.coefficients(i), 0, e - u[i]);
+    BOOST_TEST(std::abs(spline(e) - y) < 1e-12);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(accuracy_test)
+{
+  std::vector<double> u(101);
+  std::vector<double> v(u.size());
+  for (std::size_t i = 0; i < u.size(); ++i) {
+    u[i] = 0.1 * i + 0.02 * std::sin(double(i));
+    v[i] = std::sin(u[i]);
+  }
+  const auto build = Splider::Quintic::builder(u);
+  auto spline = build.spline(v);
+  const auto c2_build = Splider::C2::builder(u);
+  auto c2 = c2_build.spline(v);
+  double error = 0;
+  double c2_error = 0;
+  for (double x = 2; x < 8; x += 0.0123) {
+    error = std::max(error, std::abs(spline(x) - std::sin(x)));
+    c2_error = std::max(c2_error, std::abs(c2(x) - std::sin(x)));
+  }
+  BOOST_TEST(error < 1e-8);
+  BOOST_TEST(error < c2_error);
+}
+
+BOOST_FIXTURE_TEST_CASE(cospline_test, UnevenFixture)
+{
+  const auto build = Splider::Quintic::builder(u);
+  auto spline = build.spline(v);
+  auto cospline = build.cospline(x);
+  const auto y = cospline(v);
+  const auto expected = spline(x);
+  BOOST_TEST(y == expected, boost::test_tools::per_element());
+}
+
+BOOST_FIXTURE_TEST_CASE(complex_test, UnevenFixture)
+{
+  std::vector<std::complex<double>> w(v.size());
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    w[i] = {v[i], -2 * v[i]};
+  }
+  const auto build = Splider::Quintic::builder(u);
+  auto real = build.spline(v);
+  auto complex = build.spline(w);
+  for (auto e : x) {
+    const auto expected = real(e);
+    const auto y = complex(e);
+    BOOST_TEST(y.real() == expected, boost::test_tools::tolerance(1e-12));
+    BOOST_TEST(y.imag() == -2 * expected, boost::test_tools::tolerance(1e-12));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(bicospline_test)
+{
+  std::vector<double> u0 {0, 1, 2, 3, 5};
+  std::vector<double> u1 {-1, 0, 0.5, 2};
+  Linx::Raster<double> v({5, 4});
+  v.generate(
+      [&](const auto& p) {
+        return std::cos(u0[p[0]]) + u1[p[1]] * u0[p[0]];
+      },
+      v.domain());
+  const auto build = Splider::Quintic::Multi::builder(u0, u1);
+  Splider::Trajectory<2> x(3);
+  x[0] = {1., 0.};
+  x[1] = {3., 2.};
+  x[2] = {0., 0.5};
+  auto cospline = build.cospline(x);
+  const auto y = cospline(v);
+  BOOST_TEST(y[0] == std::cos(1.), boost::test_tools::tolerance(1e-12));
+  BOOST_TEST(y[1] == std::cos(3.) + 6, boost::test_tools::tolerance(1e-12));
+  BOOST_TEST(y[2] == 1., boost::test_tools::tolerance(1e-12));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
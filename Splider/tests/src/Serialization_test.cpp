@@ -0,0 +1,166 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Linx/Data/Raster.h"
+#include "Splider/BSpline.h"
+#include "Splider/C2.h"
+#include "Splider/CatmullRom.h"
+#include "Splider/Hermite.h"
+#include "Splider/Lagrange.h"
+#include "Splider/Serialization.h"
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Serialization_test)
+
+//-----------------------------------------------------------------------------
+
+using Methods = boost::mpl::list<
+    Splider::C2,
+    Splider::C2::FiniteDiff,
+    Splider::Hermite::FiniteDiff,
+    Splider::Hermite::CatmullRom::Uniform,
+    Splider::Lagrange>;
+
+struct FileFixture {
+  std::string path = "Serialization_test.bin";
+  std::vector<double> u {0, 1, 2, 3, 4, 5, 6, 7};
+  std::vector<double> x {0.5, 1.5, 2.5, 3.1, 4.9, 6.5};
+  std::vector<double> v {0, 1, 4, 9, 16, 25, 36, 49};
+
+  ~FileFixture()
+  {
+    std::remove(path.c_str());
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(cospline_roundtrip_test, TMethod, Methods, FileFixture)
+{
+  const auto build = TMethod::builder(u);
+  auto cospline = build.cospline(x);
+  Splider::save(cospline, path);
+  using Spline = typename decltype(cospline)::Method;
+  Splider::MappedCo<Spline> mapped(cospline.domain(), path);
+  mapped.args().verify();
+  BOOST_TEST(mapped.size() == x.size());
+  const auto expected = cospline(v);
+  const auto y = mapped(v);
+  BOOST_TEST(y == expected);
+  Splider::Co<Spline> copied(cospline.domain(), Splider::Precomputed(), mapped.args().begin(), mapped.args().end());
+  BOOST_TEST(copied(v) == expected);
+  Splider::MappedCo<Spline> standalone(path); // Domain read from the file
+  BOOST_TEST(standalone.domain().size() == u.size());
+  BOOST_TEST(standalone(v) == expected);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(bicospline_roundtrip_test, TMethod, Methods, FileFixture)
+{
+  const auto build = TMethod::Multi::builder(u, u);
+  Splider::Trajectory<2> trajectory {{0.5, 1.5}, {2.5, 3.1}, {4.9, 6.5}};
+  Linx::Raster<double> raster({8, 8});
+  for (Linx::Index j = 0; j < 8; ++j) {
+    for (Linx::Index i = 0; i < 8; ++i) {
+      raster[{i, j}] = i * j;
+    }
+  }
+  auto cospline = build.cospline(trajectory);
+  Splider::save(cospline, path);
+  using Spline = typename decltype(cospline)::Method;
+  auto loaded = Splider::load_bicospline<Spline>(build.domain(0), build.domain(1), path);
+  const auto expected = cospline(raster);
+  BOOST_TEST(loaded(raster) == expected);
+  Splider::MappedBiCo<Spline> mapped(build.domain(0), build.domain(1), path);
+  BOOST_TEST(mapped.size() == trajectory.size());
+  BOOST_TEST(mapped(raster) == expected);
+  Splider::MappedBiCo<Spline> standalone(path); // Domains read from the file
+  BOOST_TEST(standalone(raster) == expected);
+}
+
+BOOST_FIXTURE_TEST_CASE(linspace_roundtrip_test, FileFixture)
+{
+  const auto build = Splider::BSpline::builder(0.1, 0.7, 8);
+  auto cospline = build.cospline(std::vector<double> {0.5, 1.5, 2.5, 3.1, 4.9});
+  Splider::save(cospline, path);
+  using Spline = decltype(cospline)::Method;
+  Splider::MappedCo<Spline> mapped(path);
+  BOOST_TEST(mapped.domain().front() == 0.1); // Exactly
+  BOOST_TEST(mapped.domain().length(0) == 0.7);
+  BOOST_TEST(mapped(v) == cospline(v));
+}
+
+BOOST_FIXTURE_TEST_CASE(corrupted_header_test, FileFixture)
+{
+  const auto build = Splider::C2::builder(u);
+  auto cospline = build.cospline(x);
+  Splider::save(cospline, path);
+  using Spline = decltype(cospline)::Method;
+  using Arg = Spline::Arg;
+  Splider::CosplineHeader header;
+  {
+    std::ifstream file(path, std::ios::binary);
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  }
+  BOOST_TEST(header.args_offset % Splider::CosplineHeader::args_alignment == 0);
+  const auto write = [&](const Splider::CosplineHeader& corrupted) {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.write(reinterpret_cast<const char*>(&corrupted), sizeof(corrupted));
+  };
+
+  auto corrupted = header;
+  corrupted.args_offset = 0; // Overlaps the header
+  write(corrupted);
+  BOOST_CHECK_THROW(Splider::MappedArgs<Arg> {path}, std::runtime_error);
+
+  corrupted = header;
+  corrupted.args_offset += 1; // Misaligned
+  write(corrupted);
+  BOOST_CHECK_THROW(Splider::MappedArgs<Arg> {path}, std::runtime_error);
+
+  corrupted = header;
+  corrupted.arg_count = std::numeric_limits<std::uint64_t>::max() / sizeof(Arg) + 2; // Wraps around
+  write(corrupted);
+  BOOST_CHECK_THROW(Splider::MappedArgs<Arg> {path}, std::runtime_error);
+
+  corrupted = header;
+  corrupted.knot_counts[0] = std::numeric_limits<std::uint64_t>::max() / 4; // Truncated domain
+  write(corrupted);
+  BOOST_CHECK_THROW(Splider::MappedCo<Spline> {path}, std::runtime_error);
+
+  write(header);
+  BOOST_CHECK_NO_THROW(Splider::MappedCo<Spline> {path});
+}
+
+BOOST_FIXTURE_TEST_CASE(mismatch_test, FileFixture)
+{
+  const auto build = Splider::C2::builder(u);
+  auto cospline = build.cospline(x);
+  Splider::save(cospline, path);
+  using Spline = decltype(cospline)::Method;
+
+  std::vector<double> other_u {0, 1, 2, 3, 4, 5, 6, 8};
+  const auto other = Splider::C2::builder(other_u);
+  BOOST_CHECK_THROW((Splider::MappedCo<Spline> {other.domain(), path}), std::runtime_error);
+  using LagrangeArg = Splider::Lagrange::Arg<Splider::Partition<double>>;
+  BOOST_CHECK_THROW(Splider::MappedArgs<LagrangeArg> {path}, std::runtime_error);
+
+  {
+    Splider::MappedArgs<Spline::Arg> args(path);
+    const auto offset = args.header().args_offset;
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(offset + 3);
+    file.put('\x7F');
+  }
+  Splider::MappedCo<Spline> corrupted(cospline.domain(), path);
+  BOOST_CHECK_THROW(corrupted.args().verify(), std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
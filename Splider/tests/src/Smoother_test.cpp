@@ -0,0 +1,162 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Splider/Smoother.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Smoother_test)
+
+//-----------------------------------------------------------------------------
+
+struct NoisyFixture {
+  std::vector<double> u;
+  std::vector<double> y;
+  std::vector<double> w;
+
+  NoisyFixture() : u(60), y(60), w(60)
+  {
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> step(0.05, 0.2);
+    std::normal_distribution<double> noise(0, 0.1);
+    std::uniform_real_distribution<double> weight(0.5, 2);
+    u[0] = 0;
+    for (std::size_t i = 1; i < u.size(); ++i) {
+      u[i] = u[i - 1] + step(generator);
+    }
+    for (std::size_t i = 0; i < u.size(); ++i) {
+      y[i] = std::sin(u[i]) + noise(generator);
+      w[i] = weight(generator);
+    }
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(interpolation_test, NoisyFixture)
+{
+  Splider::Smoother<> smoother(u);
+  smoother.assign(y);
+  const auto& g = smoother.fit(0);
+  for (std::size_t i = 0; i < u.size(); ++i) {
+    BOOST_TEST(g[i] == y[i], boost::test_tools::tolerance(1e-9));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(linear_regression_test, NoisyFixture)
+{
+  Splider::Smoother<> smoother(u);
+  smoother.assign(y, w);
+  const auto& g = smoother.fit(1e12);
+
+  // Weighted least-squares line
+  double sw = 0;
+  double su = 0;
+  double sy = 0;
+  double suu = 0;
+  double suy = 0;
+  for (std::size_t i = 0; i < u.size(); ++i) {
+    sw += w[i];
+    su += w[i] * u[i];
+    sy += w[i] * y[i];
+    suu += w[i] * u[i] * u[i];
+    suy += w[i] * u[i] * y[i];
+  }
+  const auto slope = (sw * suy - su * sy) / (sw * suu - su * su);
+  const auto intercept = (sy - slope * su) / sw;
+  for (std::size_t i = 0; i < u.size(); ++i) {
+    BOOST_TEST(g[i] == intercept + slope * u[i], boost::test_tools::tolerance(1e-5));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(optimality_test, NoisyFixture)
+{
+  // The third derivative of the smoothing spline jumps by w (y - g) / lambda at each knot
+  const double lambda = 0.01;
+  Splider::Smoother<> smoother(u);
+  smoother.assign(y, w);
+  smoother.fit(lambda);
+  const auto& g = smoother.values();
+  auto spline = smoother.spline();
+  const auto n = u.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto right = i < n - 1 ? spline.coefficients(i)[3] * 6 : 0.;
+    const auto left = i > 0 ? spline.coefficients(i - 1)[3] * 6 : 0.;
+    BOOST_TEST(right - left == w[i] * (y[i] - g[i]) / lambda, boost::test_tools::tolerance(1e-6));
+    BOOST_TEST(spline(u[i]) == g[i], boost::test_tools::tolerance(1e-9));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(trace_test, NoisyFixture)
+{
+  // The trace of the influence matrix is the sum of the fitted unit vectors at their knots
+  const double lambda = 0.003;
+  Splider::Smoother<> smoother(u);
+  smoother.assign(y, w);
+  smoother.gcv(lambda);
+  const auto dof = smoother.degrees_of_freedom();
+  double expected = 0;
+  std::vector<double> e(u.size(), 0.);
+  for (std::size_t k = 0; k < u.size(); ++k) {
+    e[k] = 1;
+    smoother.assign(e, w);
+    expected += smoother.fit(lambda)[k];
+    e[k] = 0;
+  }
+  BOOST_TEST(dof == expected, boost::test_tools::tolerance(1e-8));
+  BOOST_TEST(dof > 2);
+  BOOST_TEST(dof < u.size());
+}
+
+BOOST_FIXTURE_TEST_CASE(sweep_test, NoisyFixture)
+{
+  std::vector<double> lambdas;
+  for (double lambda = 1e-8; lambda < 1e4; lambda *= 10) {
+    lambdas.push_back(lambda);
+  }
+  Splider::Smoother<> smoother(u);
+  smoother.assign(y);
+  std::vector<double> scores(lambdas.size());
+  smoother.sweep(lambdas.begin(), lambdas.end(), scores.begin());
+  const auto selected = smoother.select(lambdas);
+  BOOST_TEST(smoother.lambda() == selected);
+  for (std::size_t i = 0; i < lambdas.size(); ++i) {
+    BOOST_TEST(scores[i] > 0);
+    if (lambdas[i] != selected) {
+      BOOST_TEST(scores[i] >= smoother.gcv(selected));
+    }
+  }
+  BOOST_TEST(selected > lambdas.front());
+  BOOST_TEST(selected < lambdas.back());
+
+  // The selected fit is closer to the noiseless function than the data
+  smoother.fit(selected);
+  double fit_error = 0;
+  double data_error = 0;
+  for (std::size_t i = 0; i < u.size(); ++i) {
+    fit_error += std::pow(smoother.values()[i] - std::sin(u[i]), 2);
+    data_error += std::pow(y[i] - std::sin(u[i]), 2);
+  }
+  BOOST_TEST(fit_error < data_error);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_test)
+{
+  BOOST_CHECK_THROW(Splider::Smoother<>(std::vector<double>()), std::runtime_error);
+  BOOST_CHECK_THROW(Splider::Smoother<>({0., 1.}), std::runtime_error);
+  Splider::Smoother<> smoother({0., 1., 2., 3.});
+  BOOST_CHECK_THROW(smoother.fit(1), std::runtime_error);
+  BOOST_CHECK_THROW(smoother.assign(std::vector<double> {1, 2, 3}), std::runtime_error);
+  const std::vector<double> y {1, 2, 3, 4};
+  BOOST_CHECK_THROW(smoother.assign(y, std::vector<double> {1, 0, 1, 1}), std::runtime_error);
+  smoother.assign(y);
+  BOOST_CHECK_THROW(smoother.spline(), std::runtime_error);
+  BOOST_CHECK_THROW(smoother.fit(-1), std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -5,6 +5,7 @@
 #include "Linx/Data/Sequence.h"
 #include "Splider/Spline.h"
 
+#include <array>
 #include <boost/test/unit_test.hpp>
 #include <complex>
 #include <gsl/gsl_interp.h>
@@ -84,6 +85,41 @@ BOOST_FIXTURE_TEST_CASE(real_lin_spline_test, RealLinFixture)
   BOOST_TEST(out == expected, boost::test_tools::tolerance(1.e-6) << boost::test_tools::per_element());
 }
 
+/**
+ * @brief Get the left and right first and second derivatives at an abscissa, with one-sided finite differences.
+ */
+template <typename TSpline>
+std::array<double, 4> one_sided_derivatives(TSpline& spline, double x)
+{
+  const double e = 1.e-5;
+  const auto f0 = spline(x);
+  const auto l1 = spline(x - e);
+  const auto l2 = spline(x - 2 * e);
+  const auto r1 = spline(x + e);
+  const auto r2 = spline(x + 2 * e);
+  return {
+      (3 * f0 - 4 * l1 + l2) / (2 * e),
+      (-3 * f0 + 4 * r1 - r2) / (2 * e),
+      (f0 - 2 * l1 + l2) / (e * e),
+      (f0 - 2 * r1 + r2) / (e * e)};
+}
+
+struct UnevenFixture {
+  std::vector<double> u {0, 0.3, 1.5, 1.9, 4, 4.2, 7};
+  std::vector<double> v {1, -1, 2, 0, 3, -2, 1};
+};
+
+BOOST_FIXTURE_TEST_CASE(uneven_test, UnevenFixture)
+{
+  const Splider::Partition<> domain(u);
+  Splider::Spline<double> spline(domain, v);
+  for (std::size_t i = 1; i < u.size() - 1; ++i) {
+    const auto d = one_sided_derivatives(spline, u[i]);
+    BOOST_TEST(d[0] == d[1], boost::test_tools::tolerance(1.e-6));
+    BOOST_TEST(d[2] == d[3], boost::test_tools::tolerance(1.e-3));
+  }
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END()
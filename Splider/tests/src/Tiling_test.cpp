@@ -0,0 +1,151 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Linx/Data/Raster.h"
+#include "Splider/C2.h"
+#include "Splider/CatmullRom.h"
+#include "Splider/Hermite.h"
+#include "Splider/Lagrange.h"
+#include "Splider/Quintic.h"
+#include "Splider/Tiling.h"
+
+#include <algorithm>
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Tiling_test)
+
+//-----------------------------------------------------------------------------
+
+using LocalMethods =
+    boost::mpl::list<Splider::Hermite::FiniteDiff, Splider::Hermite::CatmullRom::Uniform, Splider::Lagrange>;
+
+using GlobalMethods = boost::mpl::list<Splider::C2, Splider::Quintic>;
+
+struct MosaicFixture {
+  Linx::Index n0 = 40;
+  Linx::Index n1 = 30;
+  std::vector<double> u0;
+  std::vector<double> u1;
+  Linx::Raster<double> v;
+  std::vector<Linx::Vector<double, 2>> x;
+
+  MosaicFixture() : u0(n0), u1(n1), v({n0, n1}), x()
+  {
+    for (Linx::Index i = 0; i < n0; ++i) {
+      u0[i] = 0.5 * i;
+    }
+    for (Linx::Index i = 0; i < n1; ++i) {
+      u1[i] = 0.25 * i;
+    }
+    for (Linx::Index j = 0; j < n1; ++j) {
+      for (Linx::Index i = 0; i < n0; ++i) {
+        v[{i, j}] = std::sin(u0[i]) * std::cos(u1[j]);
+      }
+    }
+    for (Linx::Index k = 0; k < 500; ++k) {
+      x.push_back({u0.back() * (k % 97) / 97., u1.back() * (k % 89) / 89.});
+    }
+  }
+
+  void read(const Linx::Position<2>& front, const Linx::Position<2>& shape, double* data) const
+  {
+    for (Linx::Index j = 0; j < shape[1]; ++j) {
+      for (Linx::Index i = 0; i < shape[0]; ++i) {
+        *data++ = v[{front[0] + i, front[1] + j}];
+      }
+    }
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(same_as_untiled_test, TMethod, LocalMethods, MosaicFixture)
+{
+  const auto build = TMethod::Multi::builder(u0, u1);
+  auto cospline = build.cospline(x);
+  const auto expected = cospline(v);
+  const Splider::TiledBiCospline<TMethod> tiled(u0, u1, x, {8, 5});
+  BOOST_TEST(tiled.size() == static_cast<Linx::Index>(x.size()));
+  BOOST_TEST(tiled.tile_count() > 1);
+  BOOST_TEST(tiled.max_tile_size() < static_cast<Linx::Index>(v.size()));
+  for (Linx::Index threads : {1, 3}) {
+    const auto y = tiled(
+        [&](const auto& front, const auto& shape, double* data) {
+          read(front, shape, data);
+        },
+        threads);
+    for (std::size_t k = 0; k < x.size(); ++k) {
+      BOOST_TEST(y[k] == expected[k], boost::test_tools::tolerance(1.e-12));
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(global_halo_test, TMethod, GlobalMethods, MosaicFixture)
+{
+  const auto reader = [&](const auto& front, const auto& shape, double* data) {
+    read(front, shape, data);
+  };
+  const Splider::TiledBiCospline<TMethod> untiled(u0, u1, x, {n0, n1});
+  BOOST_TEST(untiled.tile_count() == 1);
+  const auto expected = untiled(reader);
+  const Splider::TiledBiCospline<TMethod> tiled(u0, u1, x, {8, 5});
+  const Splider::TiledBiCospline<TMethod> narrow(u0, u1, x, {8, 5}, 2);
+  const auto y = tiled(reader, 3);
+  const auto z = narrow(reader, 3);
+  double error = 0;
+  double narrow_error = 0;
+  for (std::size_t k = 0; k < x.size(); ++k) {
+    error = std::max(error, std::abs(y[k] - expected[k]));
+    narrow_error = std::max(narrow_error, std::abs(z[k] - expected[k]));
+  }
+  BOOST_TEST(error < 1.e-6);
+  BOOST_TEST(narrow_error > 1.e-4);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(tensor_product_test, TMethod, GlobalMethods, MosaicFixture)
+{
+  const auto build0 = TMethod::builder(u0);
+  const auto build1 = TMethod::builder(u1);
+  std::vector<double> expected(x.size());
+  std::vector<double> column(n1);
+  for (std::size_t k = 0; k < x.size(); ++k) {
+    for (Linx::Index j = 0; j < n1; ++j) {
+      std::vector<double> row(n0);
+      for (Linx::Index i = 0; i < n0; ++i) {
+        row[i] = v[{i, j}];
+      }
+      column[j] = build0.spline(row.begin(), row.end())(build0.arg(x[k][0]));
+    }
+    expected[k] = build1.spline(column.begin(), column.end())(build1.arg(x[k][1]));
+  }
+  const auto reader = [&](const auto& front, const auto& shape, double* data) {
+    read(front, shape, data);
+  };
+  const Splider::TiledBiCospline<TMethod> untiled(u0, u1, x, {n0, n1});
+  const Splider::TiledBiCospline<TMethod> tiled(u0, u1, x, {8, 5});
+  const auto y = untiled(reader);
+  const auto z = tiled(reader, 3);
+  for (std::size_t k = 0; k < x.size(); ++k) {
+    BOOST_TEST(y[k] == expected[k], boost::test_tools::tolerance(1.e-12));
+    BOOST_TEST(std::abs(z[k] - expected[k]) < 1.e-6);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(reader_exception_test, MosaicFixture)
+{
+  const Splider::TiledBiCospline<Splider::Lagrange> tiled(u0, u1, x, {8, 5});
+  BOOST_CHECK_THROW(
+      tiled(
+          [&](const auto&, const auto&, double*) {
+            throw std::runtime_error("Tile unavailable");
+          },
+          2),
+      std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,138 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Splider/C2.h"
+#include "Splider/CatmullRom.h"
+#include "Splider/Hermite.h"
+#include "Splider/Lagrange.h"
+#include "Splider/Serialization.h"
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <algorithm>
+#include <list>
+#include <random>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Traversal_test)
+
+//-----------------------------------------------------------------------------
+
+using Methods = boost::mpl::list<
+    Splider::C2,
+    Splider::C2::FiniteDiff,
+    Splider::Hermite::FiniteDiff,
+    Splider::Hermite::CatmullRom::Uniform,
+    Splider::Lagrange>;
+
+/**
+ * @brief Arguments which stress the counting sort:
+ * many arguments per interval, duplicates, arguments on the knots and empty intervals, in random order.
+ */
+struct ClusteredFixture {
+  std::vector<double> u;
+  std::vector<double> v;
+  std::vector<double> x;
+
+  ClusteredFixture() : u(100), v(100), x()
+  {
+    for (std::size_t i = 0; i < u.size(); ++i) {
+      u[i] = i;
+      v[i] = std::sin(0.1 * i);
+    }
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> cluster(10, 13);
+    std::uniform_real_distribution<double> sparse(0, 50);
+    for (int k = 0; k < 600; ++k) {
+      x.push_back(cluster(generator));
+    }
+    for (int k = 0; k < 200; ++k) {
+      x.push_back(sparse(generator));
+    }
+    for (int k = 0; k < 100; ++k) {
+      x.push_back(x[k * 7]); // Duplicates
+    }
+    x.insert(x.end(), u.begin(), u.end()); // Knots, including the last one, and thus empty intervals in [50, 99)
+    std::shuffle(x.begin(), x.end(), generator);
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(interval_major_test, TMethod, Methods, ClusteredFixture)
+{
+  const auto build = TMethod::builder(u);
+  auto cospline = build.cospline(x);
+  cospline.traversal(Splider::Traversal::Sequential);
+  BOOST_TEST(not cospline.is_interval_major());
+  const auto expected = cospline(v);
+  cospline.traversal(Splider::Traversal::IntervalMajor);
+  BOOST_TEST(cospline.is_interval_major());
+  const auto& order = cospline.order();
+  std::vector<bool> seen(x.size(), false);
+  for (std::size_t k = 0; k < cospline.size(); ++k) {
+    seen[order[k]] = true;
+    if (k > 0) {
+      const auto previous = cospline.args()[k - 1].index();
+      BOOST_TEST(previous <= cospline.args()[k].index());
+      if (previous == cospline.args()[k].index()) {
+        BOOST_TEST(order[k - 1] < order[k]); // Stable
+      }
+    }
+  }
+  BOOST_TEST(std::count(seen.begin(), seen.end(), true) == x.size()); // Permutation
+  BOOST_TEST(cospline(v) == expected, boost::test_tools::per_element());
+  std::list<double> listed;
+  cospline.transform(v.begin(), v.end(), std::back_inserter(listed));
+  BOOST_TEST(std::vector<double>(listed.begin(), listed.end()) == expected, boost::test_tools::per_element());
+}
+
+BOOST_FIXTURE_TEST_CASE(restore_order_test, ClusteredFixture)
+{
+  const auto build = Splider::C2::builder(u);
+  auto cospline = build.cospline(x);
+  cospline.traversal(Splider::Traversal::Sequential);
+  const auto args = cospline.args();
+  cospline.traversal(Splider::Traversal::IntervalMajor);
+  cospline.traversal(Splider::Traversal::Sequential);
+  BOOST_TEST(cospline.order().empty());
+  for (std::size_t k = 0; k < args.size(); ++k) {
+    BOOST_TEST(cospline.args()[k].index() == args[k].index());
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(auto_traversal_test, ClusteredFixture)
+{
+  const auto build = Splider::C2::builder(u);
+  auto cospline = build.cospline(x);
+  BOOST_TEST((cospline.traversal() == Splider::Traversal::Auto));
+  BOOST_TEST(not cospline.is_interval_major()); // Few knots
+  cospline.traversal(Splider::Traversal::IntervalMajor);
+  std::sort(x.begin(), x.end());
+  cospline.assign(x);
+  BOOST_TEST(cospline.is_interval_major()); // Forced
+  cospline.traversal(Splider::Traversal::Auto);
+  BOOST_TEST(not cospline.is_interval_major());
+}
+
+BOOST_FIXTURE_TEST_CASE(save_argument_order_test, ClusteredFixture)
+{
+  const std::string path = "Splider_Traversal_test.bin";
+  const auto build = Splider::C2::builder(u);
+  auto cospline = build.cospline(x);
+  cospline.traversal(Splider::Traversal::IntervalMajor);
+  const auto expected = cospline(v);
+  Splider::save(cospline, path);
+  using Spline = typename decltype(cospline)::Method;
+  Splider::MappedCo<Spline> mapped(cospline.domain(), path);
+  BOOST_TEST(mapped(v) == expected, boost::test_tools::per_element());
+  Splider::Co<Spline> copied(cospline.domain(), Splider::Precomputed(), mapped.args().begin(), mapped.args().end());
+  copied.traversal(Splider::Traversal::IntervalMajor);
+  BOOST_TEST(copied(v) == expected, boost::test_tools::per_element());
+  std::remove(path.c_str());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
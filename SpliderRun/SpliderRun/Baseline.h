@@ -0,0 +1,342 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDERRUN_BASELINE_H
+#define _SPLIDERRUN_BASELINE_H
+
+#include "SpliderRun/Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Splider {
+
+/**
+ * @brief A median and its confidence interval.
+ */
+struct MedianInterval {
+  double low; ///< The lower bound of the interval
+  double median; ///< The median
+  double high; ///< The upper bound of the interval
+};
+
+/**
+ * @brief Compute the median of a sample and a distribution-free confidence interval.
+ * @param samples The measurements
+ * @param confidence The confidence level, e.g. 0.95
+ *
+ * The interval is bounded by order statistics, whose ranks are given by the binomial distribution
+ * of the number of samples below the true median.
+ * It does not assume the distribution to be Gaussian, which timings are not.
+ * With too few samples to reach the confidence level, the interval spans the whole sample.
+ */
+inline MedianInterval median_interval(std::vector<double> samples, double confidence = 0.95)
+{
+  if (samples.empty()) {
+    throw std::runtime_error("Cannot compute the median of an empty sample.");
+  }
+  std::sort(samples.begin(), samples.end());
+  const auto n = samples.size();
+  const auto median = n % 2 == 1 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+
+  // Largest k such that P(B < k) <= alpha / 2 with B ~ Bin(n, 1/2)
+  const auto tail = (1 - confidence) / 2;
+  const auto log_half_n = n * std::log(0.5);
+  std::size_t k = 0;
+  double cdf = 0;
+  while (k < n / 2) {
+    cdf += std::exp(std::lgamma(n + 1.) - std::lgamma(k + 1.) - std::lgamma(n - k + 1.) + log_half_n);
+    if (cdf > tail) {
+      break;
+    }
+    ++k;
+  }
+  k = std::max<std::size_t>(k, 1); // 1-based rank
+  return {samples[k - 1], median, samples[n - k]};
+}
+
+/**
+ * @brief A named set of timings, stored as JSON.
+ *
+ * Each entry is identified by a key which encodes the benchmark case and phase,
+ * and holds the repeated measurements of the duration per element, in nanoseconds.
+ */
+class Baseline {
+public:
+
+  /**
+   * @brief The repeated measurements.
+   */
+  using Samples = std::vector<double>;
+
+  /**
+   * @brief Constructor.
+   */
+  explicit Baseline(std::string name = "") : m_name(std::move(name)), m_entries() {}
+
+  /**
+   * @brief Create a baseline from a benchmark report.
+   */
+  static Baseline from_report(std::string name, const BenchmarkReport& report)
+  {
+    Baseline out(std::move(name));
+    for (const auto& c : report.timings()) {
+      for (const auto& p : c.second) {
+        Samples samples;
+        for (const auto& s : p.samples) {
+          samples.push_back(std::chrono::duration<double, std::nano>(s).count() / std::max<Linx::Index>(p.elements, 1));
+        }
+        out.add(key(c.first, p.phase), std::move(samples));
+      }
+    }
+    return out;
+  }
+
+  /**
+   * @brief Get the key of a case and phase.
+   */
+  static std::string key(const BenchmarkCase& c, const std::string& phase)
+  {
+    return c.method + '/' + c.value + '/' + std::to_string(c.knots) + '/' + std::to_string(c.args) + '/' +
+        (c.sorted ? "sorted" : "random") + '/' + phase;
+  }
+
+  /**
+   * @brief Get the baseline name.
+   */
+  const std::string& name() const
+  {
+    return m_name;
+  }
+
+  /**
+   * @brief Get the entries, ordered by key.
+   */
+  const std::map<std::string, Samples>& entries() const
+  {
+    return m_entries;
+  }
+
+  /**
+   * @brief Add measurements to an entry.
+   */
+  void add(const std::string& key, const Samples& samples)
+  {
+    auto& entry = m_entries[key];
+    entry.insert(entry.end(), samples.begin(), samples.end());
+  }
+
+  /**
+   * @brief Get the path of a named baseline in a directory.
+   */
+  static std::filesystem::path path(const std::filesystem::path& dir, const std::string& name)
+  {
+    return dir / (name + ".json");
+  }
+
+  /**
+   * @brief Save the baseline in a directory, which is created if needed.
+   */
+  void save(const std::filesystem::path& dir) const
+  {
+    std::filesystem::create_directories(dir);
+    std::ofstream file(path(dir, m_name));
+    if (not file) {
+      throw std::runtime_error("Cannot write baseline: " + path(dir, m_name).string());
+    }
+    write(file);
+  }
+
+  /**
+   * @brief Load a named baseline from a directory.
+   */
+  static Baseline load(const std::filesystem::path& dir, const std::string& name)
+  {
+    std::ifstream file(path(dir, name));
+    if (not file) {
+      throw std::runtime_error("Cannot read baseline: " + path(dir, name).string());
+    }
+    return read(file);
+  }
+
+  /**
+   * @brief Write the baseline as JSON.
+   */
+  void write(std::ostream& os) const
+  {
+    os.precision(9);
+    os << "{\n  \"name\": \"" << m_name << "\",\n  \"unit\": \"ns_per_element\",\n  \"entries\": {";
+    bool first = true;
+    for (const auto& e : m_entries) {
+      os << (first ? "\n" : ",\n") << "    \"" << e.first << "\": [";
+      first = false;
+      for (std::size_t i = 0; i < e.second.size(); ++i) {
+        os << (i ? ", " : "") << e.second[i];
+      }
+      os << "]";
+    }
+    os << "\n  }\n}\n";
+  }
+
+  /**
+   * @brief Read a baseline written by `write()`.
+   *
+   * Only the subset of JSON which is written is supported: strings without escapes, numbers,
+   * arrays of numbers and objects.
+   */
+  static Baseline read(std::istream& is)
+  {
+    Baseline out;
+    expect(is, '{');
+    while (not next_is(is, '}')) {
+      const auto field = read_string(is);
+      expect(is, ':');
+      if (field == "name") {
+        out.m_name = read_string(is);
+      } else if (field == "unit") {
+        const auto unit = read_string(is);
+        if (unit != "ns_per_element") {
+          throw std::runtime_error("Unsupported baseline unit: " + unit);
+        }
+      } else if (field == "entries") {
+        expect(is, '{');
+        while (not next_is(is, '}')) {
+          const auto key = read_string(is);
+          expect(is, ':');
+          expect(is, '[');
+          Samples samples;
+          while (not next_is(is, ']')) {
+            double value;
+            if (not(is >> value)) {
+              throw std::runtime_error("Malformed baseline: expected a number in entry " + key);
+            }
+            samples.push_back(value);
+            next_is(is, ',');
+          }
+          out.add(key, samples);
+          next_is(is, ',');
+        }
+      } else {
+        throw std::runtime_error("Malformed baseline: unknown field " + field);
+      }
+      next_is(is, ',');
+    }
+    return out;
+  }
+
+private:
+
+  /**
+   * @brief Skip white spaces and consume a character if it is the expected one.
+   */
+  static bool next_is(std::istream& is, char c)
+  {
+    is >> std::ws;
+    if (is.peek() == c) {
+      is.get();
+      return true;
+    }
+    if (not is) {
+      throw std::runtime_error(std::string("Malformed baseline: unexpected end before ") + c);
+    }
+    return false;
+  }
+
+  /**
+   * @brief Skip white spaces and consume an expected character, or throw.
+   */
+  static void expect(std::istream& is, char c)
+  {
+    if (not next_is(is, c)) {
+      throw std::runtime_error(std::string("Malformed baseline: expected ") + c);
+    }
+  }
+
+  /**
+   * @brief Read a quoted string.
+   */
+  static std::string read_string(std::istream& is)
+  {
+    expect(is, '"');
+    std::string out;
+    if (not std::getline(is, out, '"')) {
+      throw std::runtime_error("Malformed baseline: unterminated string");
+    }
+    return out;
+  }
+
+  std::string m_name; ///< The baseline name
+  std::map<std::string, Samples> m_entries; ///< The measurements, by key
+};
+
+/**
+ * @brief The outcome of the comparison of an entry with its baseline.
+ */
+enum class Verdict {
+  Unchanged = 0, ///< The change is not significant or below the threshold
+  Improvement, ///< The entry is significantly faster
+  Regression ///< The entry is significantly slower
+};
+
+/**
+ * @brief The comparison of an entry with its baseline.
+ */
+struct BaselineComparison {
+  std::string key; ///< The entry key
+  MedianInterval reference; ///< The baseline statistics
+  MedianInterval current; ///< The current statistics
+  Verdict verdict; ///< The outcome
+
+  /**
+   * @brief Get the relative change of the median, positive if slower.
+   */
+  double change() const
+  {
+    return current.median / reference.median - 1;
+  }
+};
+
+/**
+ * @brief Compare the entries of a run with a baseline.
+ * @param reference The baseline
+ * @param current The new run
+ * @param threshold The relative slowdown (or speedup) above which a change is reported, e.g. 0.05
+ * @param confidence The confidence level of the median intervals
+ *
+ * A change is significant if the confidence intervals of the medians are disjoint.
+ * It is reported if it is significant and larger than the threshold, in order to ignore tiny but stable shifts.
+ * Entries which are not in both sets are ignored.
+ */
+inline std::vector<BaselineComparison>
+compare(const Baseline& reference, const Baseline& current, double threshold, double confidence = 0.95)
+{
+  std::vector<BaselineComparison> out;
+  for (const auto& e : current.entries()) {
+    const auto it = reference.entries().find(e.first);
+    if (it == reference.entries().end() || it->second.empty() || e.second.empty()) {
+      continue;
+    }
+    BaselineComparison c {e.first, median_interval(it->second, confidence), median_interval(e.second, confidence)};
+    c.verdict = Verdict::Unchanged;
+    if (c.current.low > c.reference.high && c.change() > threshold) {
+      c.verdict = Verdict::Regression;
+    } else if (c.current.high < c.reference.low && c.change() < -threshold) {
+      c.verdict = Verdict::Improvement;
+    }
+    out.push_back(std::move(c));
+  }
+  return out;
+}
+
+} // namespace Splider
+
+#endif
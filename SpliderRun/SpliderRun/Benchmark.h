@@ -0,0 +1,387 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDERRUN_BENCHMARK_H
+#define _SPLIDERRUN_BENCHMARK_H
+
+#include "Linx/Data/Vector.h" // Index
+#include "Linx/Run/Chronometer.h"
+#include "SpliderRun/PerfCounters.h"
+
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace Splider {
+
+/**
+ * @brief The benchmark time unit.
+ */
+using BenchmarkDuration = std::chrono::nanoseconds;
+
+/**
+ * @brief Get the median of a list of durations, or zero if the list is empty.
+ */
+inline BenchmarkDuration median(std::vector<BenchmarkDuration> samples)
+{
+  std::sort(samples.begin(), samples.end());
+  const auto size = samples.size();
+  if (size == 0) {
+    return BenchmarkDuration::zero();
+  }
+  if (size % 2 == 1) {
+    return samples[size / 2];
+  }
+  return (samples[size / 2 - 1] + samples[size / 2]) / 2;
+}
+
+/**
+ * @brief A benchmark case, i.e. a point of the parameter sweep.
+ */
+struct BenchmarkCase {
+  std::string method; ///< The method name
+  std::string value; ///< The knot value type name
+  Linx::Index knots; ///< The number of knots (along each axis)
+  Linx::Index args; ///< The number of arguments
+  bool sorted; ///< Whether the arguments are sorted
+
+  /**
+   * @brief Lexicographic ordering, for use as a key.
+   */
+  bool operator<(const BenchmarkCase& rhs) const
+  {
+    return std::tie(method, value, knots, args, sorted) <
+        std::tie(rhs.method, rhs.value, rhs.knots, rhs.args, rhs.sorted);
+  }
+};
+
+/**
+ * @brief The timings of a phase of a benchmark case.
+ */
+struct PhaseTimings {
+  std::string phase; ///< The phase name
+  Linx::Index elements; ///< The number of elements processed by the phase
+  std::size_t bytes; ///< The memory footprint of the data structure built by the phase, if relevant
+  std::vector<BenchmarkDuration> samples; ///< The repeated measurements
+  std::map<std::string, std::vector<double>> counters; ///< The repeated performance counter measurements
+
+  /**
+   * @brief Get the median duration.
+   */
+  BenchmarkDuration median() const
+  {
+    return Splider::median(samples);
+  }
+
+  /**
+   * @brief Get the median duration per element, in nanoseconds.
+   */
+  double ns_per_element() const
+  {
+    return std::chrono::duration<double, std::nano>(median()).count() / std::max<Linx::Index>(elements, 1);
+  }
+
+  /**
+   * @brief Get the median throughput, in elements per second.
+   */
+  double elements_per_second() const
+  {
+    const auto seconds = std::chrono::duration<double>(median()).count();
+    return seconds > 0 ? elements / seconds : 0;
+  }
+
+  /**
+   * @brief Get the memory footprint per element, in bytes.
+   */
+  double bytes_per_element() const
+  {
+    return static_cast<double>(bytes) / std::max<Linx::Index>(elements, 1);
+  }
+
+  /**
+   * @brief Get the median count of a performance counter, or -1 if not measured.
+   */
+  double counter(const std::string& name) const
+  {
+    const auto it = counters.find(name);
+    if (it == counters.end() || it->second.empty()) {
+      return -1;
+    }
+    auto sorted = it->second;
+    std::sort(sorted.begin(), sorted.end());
+    return sorted[sorted.size() / 2];
+  }
+
+  /**
+   * @brief Get the median count of a performance counter per element, or -1 if not measured.
+   */
+  double counter_per_element(const std::string& name) const
+  {
+    const auto count = counter(name);
+    return count < 0 ? -1 : count / std::max<Linx::Index>(elements, 1);
+  }
+
+  /**
+   * @brief Get the number of instructions per cycle, or -1 if not measured.
+   */
+  double ipc() const
+  {
+    const auto instructions = counter("instructions");
+    const auto cycles = counter("cycles");
+    return instructions < 0 || cycles <= 0 ? -1 : instructions / cycles;
+  }
+
+  /**
+   * @brief Estimate the memory traffic per element from the cache misses, or -1 if not measured.
+   *
+   * This assumes 64-byte cache lines.
+   */
+  double miss_bytes_per_element() const
+  {
+    const auto misses = counter_per_element("cache-misses");
+    return misses < 0 ? -1 : misses * 64;
+  }
+};
+
+/**
+ * @brief Collection of phase timings, which can be written as CSV or JSON.
+ */
+class BenchmarkReport {
+public:
+
+  /**
+   * @brief Record a measurement.
+   *
+   * Measurements of the same case and phase are accumulated as repetitions.
+   */
+  void add(
+      const BenchmarkCase& c,
+      const std::string& phase,
+      Linx::Index elements,
+      BenchmarkDuration duration,
+      std::size_t bytes = 0,
+      const PerfCounters::Counts& counts = {})
+  {
+    auto& phases = m_timings[c];
+    auto it = std::find_if(phases.begin(), phases.end(), [&](const auto& p) {
+      return p.phase == phase;
+    });
+    if (it == phases.end()) {
+      phases.push_back({phase, elements, bytes, {}, {}});
+      it = phases.end() - 1;
+    }
+    it->samples.push_back(duration);
+    for (const auto& count : counts) {
+      it->counters[count.first].push_back(count.second);
+      if (std::find(m_counters.begin(), m_counters.end(), count.first) == m_counters.end()) {
+        m_counters.push_back(count.first);
+      }
+    }
+  }
+
+  /**
+   * @brief Get the timings, ordered by case.
+   */
+  const std::map<BenchmarkCase, std::vector<PhaseTimings>>& timings() const
+  {
+    return m_timings;
+  }
+
+  /**
+   * @brief Write the report in a given format, `csv` or `json`.
+   */
+  void write(std::ostream& os, const std::string& format) const
+  {
+    if (format == "csv") {
+      write_csv(os);
+    } else if (format == "json") {
+      write_json(os);
+    } else {
+      throw std::runtime_error("Unknown report format: " + format);
+    }
+  }
+
+  /**
+   * @brief Write the report as CSV, with one line per case and phase.
+   */
+  void write_csv(std::ostream& os) const
+  {
+    os << "method,value,knots,args,order,phase,elements,repetitions,";
+    os << "ns,ns_per_element,elements_per_s,bytes_per_element";
+    for (const auto& name : m_counters) {
+      os << ',' << name << "_per_element";
+    }
+    if (not m_counters.empty()) {
+      os << ",ipc,miss_bytes_per_element";
+    }
+    os << '\n';
+    for (const auto& c : m_timings) {
+      for (const auto& p : c.second) {
+        os << c.first.method << ',' << c.first.value << ',' << c.first.knots << ',' << c.first.args << ','
+           << (c.first.sorted ? "sorted" : "random") << ',' << p.phase << ',' << p.elements << ','
+           << p.samples.size() << ',' << p.median().count() << ',' << p.ns_per_element() << ','
+           << p.elements_per_second() << ',' << p.bytes_per_element();
+        for (const auto& name : m_counters) {
+          os << ',' << p.counter_per_element(name);
+        }
+        if (not m_counters.empty()) {
+          os << ',' << p.ipc() << ',' << p.miss_bytes_per_element();
+        }
+        os << '\n';
+      }
+    }
+  }
+
+  /**
+   * @brief Write the report as a JSON array of objects, with one object per case and phase.
+   */
+  void write_json(std::ostream& os) const
+  {
+    os << "[";
+    bool first = true;
+    for (const auto& c : m_timings) {
+      for (const auto& p : c.second) {
+        os << (first ? "\n" : ",\n");
+        first = false;
+        os << "  {\"method\": \"" << c.first.method << "\", \"value\": \"" << c.first.value
+           << "\", \"knots\": " << c.first.knots << ", \"args\": " << c.first.args << ", \"order\": \""
+           << (c.first.sorted ? "sorted" : "random") << "\", \"phase\": \"" << p.phase
+           << "\", \"elements\": " << p.elements << ", \"repetitions\": " << p.samples.size()
+           << ", \"ns\": " << p.median().count() << ", \"ns_per_element\": " << p.ns_per_element()
+           << ", \"elements_per_s\": " << p.elements_per_second()
+           << ", \"bytes_per_element\": " << p.bytes_per_element();
+        for (const auto& name : m_counters) {
+          os << ", \"" << name << "_per_element\": " << p.counter_per_element(name);
+        }
+        if (not m_counters.empty()) {
+          os << ", \"ipc\": " << p.ipc() << ", \"miss_bytes_per_element\": " << p.miss_bytes_per_element();
+        }
+        os << "}";
+      }
+    }
+    os << "\n]\n";
+  }
+
+private:
+
+  std::map<BenchmarkCase, std::vector<PhaseTimings>> m_timings; ///< The timings, ordered by case
+  std::vector<std::string> m_counters; ///< The names of the measured performance counters
+};
+
+/**
+ * @brief Phase timer which feeds a report.
+ *
+ * If performance counters are provided, they are read for each phase, too.
+ */
+class PhaseTimer {
+public:
+
+  /**
+   * @brief Constructor.
+   * @param report The report to be fed
+   * @param c The benchmark case
+   * @param counters The optional performance counters
+   */
+  PhaseTimer(BenchmarkReport& report, BenchmarkCase c, PerfCounters* counters = nullptr) :
+      m_report(report), m_case(std::move(c)), m_counters(counters), m_chrono()
+  {}
+
+  /**
+   * @brief Start timing a phase.
+   */
+  void start()
+  {
+    if (m_counters) {
+      m_counters->start();
+    }
+    m_chrono.start();
+  }
+
+  /**
+   * @brief Stop timing a phase and record it.
+   * @param phase The phase name
+   * @param elements The number of processed elements
+   * @param bytes The memory footprint of the data structure built by the phase, if relevant
+   */
+  void stop(const std::string& phase, Linx::Index elements, std::size_t bytes = 0)
+  {
+    const auto duration = m_chrono.stop();
+    const auto counts = m_counters ? m_counters->stop() : PerfCounters::Counts();
+    m_report.add(m_case, phase, elements, duration, bytes, counts);
+  }
+
+private:
+
+  BenchmarkReport& m_report; ///< The report
+  BenchmarkCase m_case; ///< The current case
+  PerfCounters* m_counters; ///< The performance counters, or `nullptr`
+  Linx::Chronometer<BenchmarkDuration> m_chrono; ///< The chronometer
+};
+
+/**
+ * @brief Consume a result such that the computation which produced it cannot be optimized out.
+ */
+template <typename TRange>
+void consume(const TRange& y)
+{
+  static volatile double sink = 0;
+  if (std::begin(y) != std::end(y)) {
+    sink = sink + std::abs(*std::begin(y));
+  }
+}
+
+/**
+ * @brief Call `update()` on splines which have such a method, do nothing otherwise.
+ */
+template <typename TSpline>
+auto update_if_any(TSpline& spline, int) -> decltype(spline.update(0), void())
+{
+  spline.update(0);
+}
+
+/**
+ * @copydoc update_if_any()
+ */
+template <typename TSpline>
+void update_if_any(TSpline&, long)
+{}
+
+/**
+ * @brief Split a comma-separated list.
+ */
+inline std::vector<std::string> split(const std::string& list, char separator = ',')
+{
+  std::vector<std::string> out;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, separator)) {
+    if (not item.empty()) {
+      out.push_back(item);
+    }
+  }
+  return out;
+}
+
+/**
+ * @brief Split a comma-separated list of integers.
+ */
+inline std::vector<Linx::Index> split_indices(const std::string& list, char separator = ',')
+{
+  std::vector<Linx::Index> out;
+  for (const auto& item : split(list, separator)) {
+    out.push_back(std::stol(item));
+  }
+  return out;
+}
+
+} // namespace Splider
+
+#endif
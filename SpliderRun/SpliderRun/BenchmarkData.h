@@ -0,0 +1,89 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDERRUN_BENCHMARKDATA_H
+#define _SPLIDERRUN_BENCHMARKDATA_H
+
+#include "Linx/Data/Raster.h"
+#include "Linx/Data/Sequence.h"
+#include "Splider/BiSpline.h" // Trajectory
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Splider {
+
+/**
+ * @brief The knots, values and arguments of a 1D case.
+ */
+template <typename TValue>
+struct Data1D {
+  Linx::Sequence<double> u;
+  std::vector<TValue> v;
+  Linx::Sequence<double> x;
+};
+
+/**
+ * @brief The knots, values and arguments of a 2D case.
+ */
+template <typename TValue>
+struct Data2D {
+  Linx::Sequence<double> u;
+  Linx::Raster<TValue> v;
+  Splider::Trajectory<2> x;
+};
+
+/**
+ * @brief Generate the data of a 1D case.
+ */
+template <typename TValue>
+Data1D<TValue> generate_1d(Linx::Index knots, Linx::Index args, bool sorted, Linx::Index seed)
+{
+  Data1D<TValue> data;
+  data.u = Linx::Sequence<double>(knots).linspace(0, Linx::pi<double>() * 4);
+  data.v.resize(knots);
+  for (Linx::Index i = 0; i < knots; ++i) {
+    data.v[i] = TValue(std::sin(data.u[i]));
+  }
+  data.x = Linx::Sequence<double>(args).generate(Linx::UniformNoise<double>(data.u[1], data.u[knots - 2], seed));
+  if (sorted) {
+    std::sort(data.x.begin(), data.x.end());
+  }
+  return data;
+}
+
+/**
+ * @brief Generate the data of a 2D case.
+ */
+template <typename TValue>
+Data2D<TValue> generate_2d(Linx::Index knots, Linx::Index args, bool sorted, Linx::Index seed)
+{
+  Data2D<TValue> data;
+  data.u = Linx::Sequence<double>(knots).linspace(0, Linx::pi<double>() * 4);
+  data.v = Linx::Raster<TValue>({knots, knots});
+  data.v.generate(
+      [&](const auto& p) {
+        return TValue(std::sin(data.u[p[0]]) * std::cos(data.u[p[1]]));
+      },
+      data.v.domain());
+  data.x = Splider::Trajectory<2>(args);
+  auto si = seed;
+  for (auto& xi : data.x) {
+    if (seed != -1) {
+      ++si;
+    }
+    xi.generate(Linx::UniformNoise<double>(data.u[1], data.u[knots - 2], si));
+  }
+  if (sorted) {
+    std::sort(data.x.begin(), data.x.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs[1] < rhs[1] || (lhs[1] == rhs[1] && lhs[0] < rhs[0]);
+    });
+  }
+  return data;
+}
+
+} // namespace Splider
+
+#endif
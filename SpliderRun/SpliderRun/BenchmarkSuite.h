@@ -0,0 +1,252 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDERRUN_BENCHMARKSUITE_H
+#define _SPLIDERRUN_BENCHMARKSUITE_H
+
+#include "Splider/BSpline.h"
+#include "Splider/BiSpline.h"
+#include "Splider/C2.h"
+#include "Splider/CatmullRom.h"
+#include "Splider/Cospline.h"
+#include "Splider/Hermite.h"
+#include "Splider/Lagrange.h"
+#include "Splider/Quintic.h"
+#include "Splider/Spline.h"
+#include "SpliderRun/Benchmark.h"
+#include "SpliderRun/BenchmarkData.h"
+
+#include <complex>
+#include <stdexcept>
+#include <string>
+
+namespace Splider {
+
+/**
+ * @brief Time the phases of a builder-based spline.
+ */
+template <typename TMethod, typename TValue>
+void run_builder(const Data1D<TValue>& data, PhaseTimer& timer, Resource* resource, Linx::Index prefetch)
+{
+  timer.start();
+  const auto build = TMethod::builder(data.u, resource);
+  timer.stop("domain", data.u.ssize());
+
+  timer.start();
+  const auto args = build.args(data.x, resource);
+  timer.stop("args", data.x.ssize(), args.size() * sizeof(args[0]));
+
+  auto spline = build.template spline<TValue>(resource);
+  spline.prefetch_distance(prefetch);
+  timer.start();
+  spline.assign(data.v);
+  update_if_any(spline, 0);
+  timer.stop("solve", data.u.ssize());
+
+  timer.start();
+  const auto y = spline(args);
+  timer.stop("eval", data.x.ssize());
+  consume(y);
+}
+
+/**
+ * @brief Time the phases of the legacy `Spline`.
+ */
+template <typename TValue>
+void run_spline(const Data1D<TValue>& data, PhaseTimer& timer, Resource* resource, Linx::Index prefetch)
+{
+  using Domain = Splider::Partition<double>;
+
+  timer.start();
+  const Domain domain(data.u, resource);
+  timer.stop("domain", data.u.ssize());
+
+  timer.start();
+  const Splider::Args<double> args(domain, data.x, resource);
+  timer.stop("args", data.x.ssize(), args.size() * sizeof(Splider::SplineArg<double>));
+
+  Splider::Spline<TValue, Domain> spline(domain, resource);
+  spline.prefetch_distance(prefetch);
+  timer.start();
+  spline.assign(data.v);
+  timer.stop("solve", data.u.ssize());
+
+  timer.start();
+  const auto y = spline(args);
+  timer.stop("eval", data.x.ssize());
+  consume(y);
+}
+
+/**
+ * @brief Time the phases of the legacy `Cospline`.
+ */
+template <typename TValue>
+void run_cospline(const Data1D<TValue>& data, PhaseTimer& timer, Resource* resource, Linx::Index prefetch)
+{
+  using Domain = Splider::Partition<double>;
+
+  timer.start();
+  const Domain domain(data.u, resource);
+  timer.stop("domain", data.u.ssize());
+
+  using Cospline = Splider::Cospline<TValue, Domain>;
+  timer.start();
+  Cospline cospline(domain, data.x, resource);
+  cospline.prefetch_distance(prefetch);
+  timer.stop("args", data.x.ssize(), data.x.size() * sizeof(typename Cospline::Arg));
+
+  timer.start();
+  const auto y = cospline(data.v);
+  timer.stop("resample", data.x.ssize());
+  consume(y);
+}
+
+/**
+ * @brief Time the phases of a `BiCospline`.
+ */
+template <typename TMethod, typename TValue>
+void run_bicospline(const Data2D<TValue>& data, PhaseTimer& timer, Resource* resource)
+{
+  timer.start();
+  const auto build = TMethod::Multi::builder(data.u, data.u);
+  timer.stop("domain", data.u.ssize() * 2);
+
+  timer.start();
+  auto cospline = build.template cospline<TValue>(data.x, resource);
+  using Arg = typename decltype(cospline)::Arg;
+  timer.stop("args", data.x.ssize(), data.x.size() * sizeof(Arg) * 2);
+
+  timer.start();
+  const auto y = cospline(data.v);
+  timer.stop("resample", data.x.ssize());
+  consume(y);
+}
+
+/**
+ * @brief Time the phases of a `BiBSpline`.
+ *
+ * The arguments are precomputed once, like in a cospline, and the resampling includes the prefiltering.
+ */
+template <typename TValue>
+void run_bibspline(const Data2D<TValue>& data, PhaseTimer& timer, Resource* resource)
+{
+  using Domain = Splider::Linspace<double>;
+  using Arg = Splider::BSplineArg<Domain>;
+
+  timer.start();
+  const auto build = Splider::BSpline::builder(data.u);
+  const auto& domain = build.domain();
+  timer.stop("domain", data.u.ssize() * 2);
+
+  timer.start();
+  Buffer<std::array<Arg, 2>> args(resource);
+  args.reserve(data.x.size());
+  for (const auto& p : data.x) {
+    args.push_back({Arg(domain, p[0]), Arg(domain, p[1])});
+  }
+  timer.stop("args", data.x.ssize(), data.x.size() * sizeof(Arg) * 2);
+
+  Splider::BiBSpline<Domain, TValue> spline(domain, domain, resource);
+  std::vector<TValue> y(args.size());
+  timer.start();
+  spline.assign(data.v);
+  spline.transform(args.begin(), args.end(), y.begin());
+  timer.stop("resample", data.x.ssize());
+  consume(y);
+}
+
+/**
+ * @brief Run a 1D or 2D method for a given value type, once.
+ *
+ * The domains, arguments and splines are allocated from `resource`, e.g. a `HugePageResource`.
+ * The 1D splines prefetch the knots `prefetch` arguments ahead, if positive.
+ */
+template <typename TValue>
+void run_case(
+    const std::string& method,
+    const std::string& value,
+    Linx::Index knots,
+    Linx::Index args,
+    bool sorted,
+    Linx::Index seed,
+    BenchmarkReport& report,
+    Splider::PerfCounters* counters,
+    Resource* resource,
+    Linx::Index prefetch)
+{
+  PhaseTimer timer(report, BenchmarkCase {method, value, knots, args, sorted}, counters);
+  if (method.rfind("Bi", 0) == 0) {
+    const auto data = generate_2d<TValue>(knots, args, sorted, seed);
+    if (method == "BiC2") {
+      run_bicospline<Splider::C2>(data, timer, resource);
+    } else if (method == "BiC2FD") {
+      run_bicospline<Splider::C2::FiniteDiff>(data, timer, resource);
+    } else if (method == "BiHermiteFD") {
+      run_bicospline<Splider::Hermite::FiniteDiff>(data, timer, resource);
+    } else if (method == "BiCatmullRom") {
+      run_bicospline<Splider::Hermite::CatmullRom::Uniform>(data, timer, resource);
+    } else if (method == "BiLagrange") {
+      run_bicospline<Splider::Lagrange>(data, timer, resource);
+    } else if (method == "BiQuintic") {
+      run_bicospline<Splider::Quintic>(data, timer, resource);
+    } else if (method == "BiBSpline") {
+      run_bibspline(data, timer, resource);
+    } else {
+      throw std::runtime_error("Unknown method: " + method);
+    }
+    return;
+  }
+  const auto data = generate_1d<TValue>(knots, args, sorted, seed);
+  if (method == "C2") {
+    run_builder<Splider::C2>(data, timer, resource, prefetch);
+  } else if (method == "C2FD") {
+    run_builder<Splider::C2::FiniteDiff>(data, timer, resource, prefetch);
+  } else if (method == "HermiteFD") {
+    run_builder<Splider::Hermite::FiniteDiff>(data, timer, resource, prefetch);
+  } else if (method == "CatmullRom") {
+    run_builder<Splider::Hermite::CatmullRom::Uniform>(data, timer, resource, prefetch);
+  } else if (method == "Lagrange") {
+    run_builder<Splider::Lagrange>(data, timer, resource, prefetch);
+  } else if (method == "Quintic") {
+    run_builder<Splider::Quintic>(data, timer, resource, prefetch);
+  } else if (method == "BSpline") {
+    run_builder<Splider::BSpline>(data, timer, resource, prefetch);
+  } else if (method == "Spline") {
+    run_spline(data, timer, resource, prefetch);
+  } else if (method == "Cospline") {
+    run_cospline(data, timer, resource, prefetch);
+  } else {
+    throw std::runtime_error("Unknown method: " + method);
+  }
+}
+
+/**
+ * @brief Run a 1D or 2D method for a value type given by name, once.
+ */
+inline void run_case(
+    const std::string& method,
+    const std::string& value,
+    Linx::Index knots,
+    Linx::Index args,
+    bool sorted,
+    Linx::Index seed,
+    BenchmarkReport& report,
+    PerfCounters* counters = nullptr,
+    Resource* resource = default_resource(),
+    Linx::Index prefetch = 0)
+{
+  if (value == "double") {
+    run_case<double>(method, value, knots, args, sorted, seed, report, counters, resource, prefetch);
+  } else if (value == "float") {
+    run_case<float>(method, value, knots, args, sorted, seed, report, counters, resource, prefetch);
+  } else if (value == "complex") {
+    run_case<std::complex<double>>(method, value, knots, args, sorted, seed, report, counters, resource, prefetch);
+  } else {
+    throw std::runtime_error("Unknown value type: " + value);
+  }
+}
+
+} // namespace Splider
+
+#endif
@@ -32,6 +32,25 @@ std::vector<double> resample_with_gsl(const U& u, const V& v, const X& x)
   return y;
 }
 
+/**
+ * @brief 1D evaluation with GSL.
+ */
+template <typename U, typename V, typename X>
+std::vector<double> eval_with_gsl(const U& u, const V& v, const X& x)
+{
+  gsl_interp_accel* acc = gsl_interp_accel_alloc();
+  gsl_spline* spline = gsl_spline_alloc(gsl_interp_cspline, u.size());
+  std::vector<double> y;
+  y.reserve(x.size());
+  gsl_spline_init(spline, u.data(), v.data(), u.size());
+  for (const auto& e : x) {
+    y.push_back(gsl_spline_eval(spline, e, acc));
+  }
+  gsl_interp_accel_free(acc);
+  gsl_spline_free(spline);
+  return y;
+}
+
 /**
  * @brief 2D resampling with GSL.
  */
@@ -0,0 +1,358 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDERRUN_MAPPEDARRAY_H
+#define _SPLIDERRUN_MAPPEDARRAY_H
+
+#include "Linx/Data/Vector.h" // Index, Position
+#include "Splider/MappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional> // multiplies
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Splider {
+
+/**
+ * @brief The header of an NPY file.
+ * @see https://numpy.org/doc/stable/reference/generated/numpy.lib.format.html
+ */
+struct NpyHeader {
+  std::string descr; ///< The element type descriptor, e.g. `<f8`
+  bool fortran_order; ///< Whether the array is stored column-major
+  std::vector<Linx::Index> shape; ///< The shape, slowest axis first
+  std::size_t offset; ///< The data offset in bytes
+
+  /**
+   * @brief Parse the header at the beginning of a buffer.
+   */
+  static NpyHeader parse(const char* data, std::size_t size)
+  {
+    if (size < 10 || std::memcmp(data, "\x93NUMPY", 6) != 0) {
+      throw std::runtime_error("Not an NPY file.");
+    }
+    const auto major = static_cast<unsigned char>(data[6]);
+    std::size_t length = 0;
+    std::size_t begin = 0;
+    if (major == 1) {
+      length = static_cast<unsigned char>(data[8]) | static_cast<unsigned char>(data[9]) << 8;
+      begin = 10;
+    } else if (major == 2 || major == 3) {
+      if (size < 12) {
+        throw std::runtime_error("Truncated NPY header.");
+      }
+      for (int i = 3; i >= 0; --i) {
+        length = length << 8 | static_cast<unsigned char>(data[8 + i]);
+      }
+      begin = 12;
+    } else {
+      throw std::runtime_error("Unsupported NPY version: " + std::to_string(major));
+    }
+    if (begin + length > size) {
+      throw std::runtime_error("Truncated NPY header.");
+    }
+    const std::string dict(data + begin, length);
+
+    NpyHeader out;
+    out.offset = begin + length;
+    out.descr = quoted_value(dict, "descr");
+    out.fortran_order = raw_value(dict, "fortran_order").rfind("True", 0) == 0;
+    const auto open = dict.find('(', dict.find("'shape'"));
+    const auto close = dict.find(')', open);
+    if (open == std::string::npos || close == std::string::npos) {
+      throw std::runtime_error("Malformed NPY header: missing shape.");
+    }
+    std::size_t pos = open + 1;
+    while (pos < close) {
+      const auto end = std::min(dict.find(',', pos), close);
+      const auto item = dict.substr(pos, end - pos);
+      if (item.find_first_of("0123456789") != std::string::npos) {
+        out.shape.push_back(std::stol(item));
+      }
+      pos = end + 1;
+    }
+    return out;
+  }
+
+  /**
+   * @brief Serialize a version 1.0 header, padded such that the data is 64-byte aligned.
+   */
+  std::string serialize() const
+  {
+    std::string dict = "{'descr': '" + descr + "', 'fortran_order': " + (fortran_order ? "True" : "False") +
+        ", 'shape': (";
+    for (const auto& n : shape) {
+      dict += std::to_string(n) + ", ";
+    }
+    if (shape.size() > 1) {
+      dict.resize(dict.size() - 1);
+    }
+    dict += "), }";
+    const auto padding = 63 - (10 + dict.size()) % 64; // + '\n'
+    dict += std::string(padding, ' ') + '\n';
+    std::string out = "\x93NUMPY";
+    out += '\x01';
+    out += '\x00';
+    out += static_cast<char>(dict.size() & 0xFF);
+    out += static_cast<char>(dict.size() >> 8);
+    return out + dict;
+  }
+
+private:
+
+  static std::string raw_value(const std::string& dict, const std::string& key)
+  {
+    const auto pos = dict.find("'" + key + "'");
+    if (pos == std::string::npos) {
+      throw std::runtime_error("Malformed NPY header: missing " + key);
+    }
+    const auto colon = dict.find(':', pos);
+    return dict.substr(dict.find_first_not_of(' ', colon + 1));
+  }
+
+  static std::string quoted_value(const std::string& dict, const std::string& key)
+  {
+    const auto value = raw_value(dict, key);
+    const auto end = value.find('\'', 1);
+    if (value.empty() || value[0] != '\'' || end == std::string::npos) {
+      throw std::runtime_error("Malformed NPY header: " + key);
+    }
+    return value.substr(1, end - 1);
+  }
+};
+
+/**
+ * @brief Get the little-endian NPY descriptor of a floating point type.
+ */
+template <typename T>
+std::string npy_descr()
+{
+  static_assert(std::is_floating_point<T>::value, "Only floating point types are supported.");
+  return "<f" + std::to_string(sizeof(T));
+}
+
+/**
+ * @brief Zero-copy view of an array stored in an NPY or raw binary file.
+ *
+ * Arrays are row-major (C order): the last axis is the fastest,
+ * such that a value cube of shape `(..., n)` is a sequence of rows of `n` values.
+ *
+ * Files are specified as either a path to an `.npy` file,
+ * or a path to a raw file of native values followed by its comma-separated shape, e.g. `cube.raw:100,20,30`.
+ */
+template <typename T>
+class MappedArray {
+public:
+
+  /**
+   * @brief The value type.
+   */
+  using Value = T;
+
+  /**
+   * @brief Map an existing NPY or raw file for reading.
+   */
+  static MappedArray open(const std::string& spec)
+  {
+    const auto colon = spec.rfind(':');
+    if (colon == std::string::npos) {
+      MappedFile file(spec);
+      const auto header = NpyHeader::parse(file.data(), file.size());
+      if (header.descr != npy_descr<T>()) {
+        throw std::runtime_error("Unexpected NPY type " + header.descr + " in " + spec + "; expected " + npy_descr<T>() +
+            ".");
+      }
+      if (header.fortran_order) {
+        throw std::runtime_error("Fortran-ordered NPY arrays are not supported: " + spec);
+      }
+      return MappedArray(std::move(file), header.shape, header.offset);
+    }
+    std::vector<Linx::Index> shape;
+    std::size_t pos = colon + 1;
+    while (pos <= spec.size()) {
+      const auto end = std::min(spec.find(',', pos), spec.size());
+      shape.push_back(std::stol(spec.substr(pos, end - pos)));
+      pos = end + 1;
+    }
+    return MappedArray(MappedFile(spec.substr(0, colon)), shape, 0);
+  }
+
+  /**
+   * @brief Create an NPY file of given shape and map it for writing.
+   */
+  static MappedArray create(const std::string& path, std::vector<Linx::Index> shape)
+  {
+    NpyHeader header {npy_descr<T>(), false, shape, 0};
+    const auto bytes = header.serialize();
+    const auto size = std::accumulate(shape.begin(), shape.end(), Linx::Index(1), std::multiplies<Linx::Index>());
+    MappedFile file(path, MappedFile::Mode::Write, bytes.size() + size * sizeof(T));
+    std::memcpy(file.data(), bytes.data(), bytes.size());
+    return MappedArray(std::move(file), std::move(shape), bytes.size());
+  }
+
+  /**
+   * @brief Get the shape, slowest axis first.
+   */
+  const std::vector<Linx::Index>& shape() const
+  {
+    return m_shape;
+  }
+
+  /**
+   * @brief Get the number of elements.
+   */
+  Linx::Index size() const
+  {
+    return m_size;
+  }
+
+  /**
+   * @brief Get the length of the last axis, or 1 for a scalar.
+   */
+  Linx::Index row_size() const
+  {
+    return m_shape.empty() ? 1 : m_shape.back();
+  }
+
+  /**
+   * @brief Get the number of rows, i.e. the product of the lengths of all the axes but the last one.
+   */
+  Linx::Index rows() const
+  {
+    return m_size / std::max<Linx::Index>(row_size(), 1);
+  }
+
+  /**
+   * @brief Get the values.
+   */
+  const T* data() const
+  {
+    return m_data;
+  }
+
+  /**
+   * @copydoc data()
+   */
+  T* data()
+  {
+    return m_data;
+  }
+
+  /**
+   * @brief Iterator to the first value.
+   */
+  const T* begin() const
+  {
+    return m_data;
+  }
+
+  /**
+   * @brief Iterator past the last value.
+   */
+  const T* end() const
+  {
+    return m_data + m_size;
+  }
+
+  /**
+   * @brief Get the underlying file.
+   */
+  MappedFile& file()
+  {
+    return m_file;
+  }
+
+  /**
+   * @brief Release the pages of a range of elements, which were entirely processed.
+   */
+  void release(Linx::Index first, Linx::Index count)
+  {
+    m_file.release(m_offset + first * sizeof(T), count * sizeof(T));
+  }
+
+private:
+
+  MappedArray(MappedFile file, std::vector<Linx::Index> shape, std::size_t offset) :
+      m_file(std::move(file)), m_shape(std::move(shape)), m_offset(offset),
+      m_size(std::accumulate(m_shape.begin(), m_shape.end(), Linx::Index(1), std::multiplies<Linx::Index>())),
+      m_data(reinterpret_cast<T*>(m_file.data() + offset))
+  {
+    if (offset + m_size * sizeof(T) > m_file.size()) {
+      throw std::runtime_error("File is too small for its declared shape: " + m_file.path());
+    }
+  }
+
+  MappedFile m_file; ///< The mapped file
+  std::vector<Linx::Index> m_shape; ///< The shape, slowest axis first
+  std::size_t m_offset; ///< The data offset in bytes
+  Linx::Index m_size; ///< The number of elements
+  T* m_data; ///< The values
+};
+
+/**
+ * @brief Get the element type descriptor of an NPY file, or an empty string for a raw file specification.
+ */
+inline std::string npy_descr(const std::string& spec)
+{
+  if (spec.rfind(':') != std::string::npos) {
+    return "";
+  }
+  MappedFile file(spec);
+  return NpyHeader::parse(file.data(), file.size()).descr;
+}
+
+/**
+ * @brief Load a small NPY or raw array, e.g. knots or arguments, as a vector of doubles.
+ *
+ * Unlike the values, such arrays are copied, because they are converted to double precision if needed.
+ */
+inline std::vector<double> load_vector(const std::string& spec)
+{
+  if (npy_descr(spec) == npy_descr<float>()) {
+    const auto array = MappedArray<float>::open(spec);
+    return std::vector<double>(array.begin(), array.end());
+  }
+  const auto array = MappedArray<double>::open(spec);
+  return std::vector<double>(array.begin(), array.end());
+}
+
+/**
+ * @brief Zero-copy 2D view of a plane of a row-major array, indexed like a `Linx::Raster`.
+ *
+ * Index 0 is the fastest axis, i.e. the last axis of the array.
+ */
+template <typename T>
+class PlaneView {
+public:
+
+  /**
+   * @brief Constructor.
+   * @param data The first value of the plane
+   * @param width The length of the fastest axis
+   */
+  PlaneView(const T* data, Linx::Index width) : m_data(data), m_width(width) {}
+
+  /**
+   * @brief Access the value at given position.
+   */
+  const T& operator[](const Linx::Position<2>& p) const
+  {
+    return m_data[p[0] + p[1] * m_width];
+  }
+
+private:
+
+  const T* m_data; ///< The values
+  Linx::Index m_width; ///< The length of the fastest axis
+};
+
+} // namespace Splider
+
+#endif
@@ -0,0 +1,260 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _SPLIDERRUN_PERFCOUNTERS_H
+#define _SPLIDERRUN_PERFCOUNTERS_H
+
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Splider {
+
+/**
+ * @brief A hardware performance counter event.
+ */
+struct PerfEvent {
+  std::string name; ///< The event name
+  std::uint32_t type; ///< The `perf_event_attr::type`
+  std::uint64_t config; ///< The `perf_event_attr::config`
+};
+
+/**
+ * @brief Group of hardware performance counters read through Linux `perf_event_open`.
+ *
+ * Events which cannot be opened (unsupported by the CPU, virtualized environment, restrictive `perf_event_paranoid`...)
+ * are silently dropped, such that the group may be partially or totally unavailable.
+ * On non-Linux systems, the group is always empty.
+ *
+ * Generic events are designated by their `perf` names, e.g. `cycles` or `cache-misses`.
+ * Model-specific events, e.g. retired vector floating point instructions for computing vectorization ratios,
+ * are designated by their raw `perf` code, e.g. `r01c7`.
+ */
+class PerfCounters {
+public:
+
+  /**
+   * @brief A measurement, i.e. the list of event names and counts.
+   */
+  using Counts = std::vector<std::pair<std::string, double>>;
+
+  /**
+   * @brief Get the default list of events.
+   */
+  static std::vector<std::string> default_events()
+  {
+    return {"cycles", "instructions", "cache-references", "cache-misses", "branches", "branch-misses"};
+  }
+
+  /**
+   * @brief Parse a comma-separated list of event names.
+   *
+   * Special values `none` and `default` designate an empty list and the default list, respectively.
+   */
+  static std::vector<std::string> parse_list(const std::string& list)
+  {
+    if (list == "none") {
+      return {};
+    }
+    if (list == "default") {
+      return default_events();
+    }
+    std::vector<std::string> out;
+    std::stringstream ss(list);
+    std::string name;
+    while (std::getline(ss, name, ',')) {
+      if (not name.empty()) {
+        out.push_back(name);
+      }
+    }
+    return out;
+  }
+
+  /**
+   * @brief Parse an event name.
+   */
+  static PerfEvent parse(const std::string& name)
+  {
+#ifdef __linux__
+    if (name == "cycles") {
+      return {name, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+    }
+    if (name == "instructions") {
+      return {name, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS};
+    }
+    if (name == "cache-references") {
+      return {name, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES};
+    }
+    if (name == "cache-misses") {
+      return {name, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES};
+    }
+    if (name == "branches") {
+      return {name, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS};
+    }
+    if (name == "branch-misses") {
+      return {name, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES};
+    }
+    if (name == "stalled-cycles-frontend") {
+      return {name, PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND};
+    }
+    if (name == "stalled-cycles-backend") {
+      return {name, PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND};
+    }
+    if (name == "L1-dcache-load-misses") {
+      return {
+          name,
+          PERF_TYPE_HW_CACHE,
+          PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+    }
+    if (name == "dTLB-load-misses") {
+      return {
+          name,
+          PERF_TYPE_HW_CACHE,
+          PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+    }
+    if (name.size() > 1 && name[0] == 'r') {
+      return {name, PERF_TYPE_RAW, std::stoull(name.substr(1), nullptr, 16)};
+    }
+#endif
+    throw std::runtime_error("Unknown performance counter: " + name);
+  }
+
+  /**
+   * @brief Constructor.
+   * @param names The event names
+   */
+  explicit PerfCounters(const std::vector<std::string>& names) : m_events(), m_fds()
+  {
+#ifdef __linux__
+    for (const auto& name : names) {
+      const auto event = parse(name);
+      const auto fd = open(event, m_fds.empty() ? -1 : m_fds[0]);
+      if (fd != -1) {
+        m_events.push_back(event);
+        m_fds.push_back(fd);
+      }
+    }
+#endif
+  }
+
+  /**
+   * @brief Non-copyable.
+   */
+  PerfCounters(const PerfCounters&) = delete;
+
+  /**
+   * @brief Non-copyable.
+   */
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  /**
+   * @brief Destructor.
+   */
+  ~PerfCounters()
+  {
+#ifdef __linux__
+    for (auto fd : m_fds) {
+      close(fd);
+    }
+#endif
+  }
+
+  /**
+   * @brief Check whether at least one counter could be opened.
+   */
+  bool available() const
+  {
+    return not m_fds.empty();
+  }
+
+  /**
+   * @brief Get the list of opened events.
+   */
+  const std::vector<PerfEvent>& events() const
+  {
+    return m_events;
+  }
+
+  /**
+   * @brief Reset and start the counters.
+   */
+  void start()
+  {
+#ifdef __linux__
+    if (available()) {
+      ioctl(m_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(m_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+  }
+
+  /**
+   * @brief Stop the counters and read them.
+   *
+   * If the counters were multiplexed by the kernel, the counts are scaled accordingly.
+   * An empty list is returned if no counter is available.
+   */
+  Counts stop()
+  {
+    Counts out;
+#ifdef __linux__
+    if (not available()) {
+      return out;
+    }
+    ioctl(m_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    // Layout of PERF_FORMAT_GROUP: nr, time_enabled, time_running, values[nr]
+    std::vector<std::uint64_t> buffer(3 + m_fds.size());
+    const auto size = static_cast<ssize_t>(buffer.size() * sizeof(std::uint64_t));
+    if (read(m_fds[0], buffer.data(), size) != size) {
+      return out;
+    }
+    const double enabled = buffer[1];
+    const double running = buffer[2];
+    const double scale = running > 0 ? enabled / running : 0;
+    for (std::size_t i = 0; i < m_events.size(); ++i) {
+      out.emplace_back(m_events[i].name, buffer[3 + i] * scale);
+    }
+#endif
+    return out;
+  }
+
+private:
+
+#ifdef __linux__
+  /**
+   * @brief Open an event in the group of a given leader, or as the leader if `leader = -1`.
+   */
+  static int open(const PerfEvent& event, int leader)
+  {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = event.type;
+    attr.config = event.config;
+    attr.disabled = leader == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0));
+  }
+#endif
+
+  std::vector<PerfEvent> m_events; ///< The opened events
+  std::vector<int> m_fds; ///< The file descriptors, leader first
+};
+
+} // namespace Splider
+
+#endif
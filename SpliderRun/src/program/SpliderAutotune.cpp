@@ -0,0 +1,70 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Linx/Data/Sequence.h"
+#include "Linx/Run/ProgramOptions.h"
+#include "Splider/Autotuner.h"
+#include "SpliderRun/Benchmark.h"
+
+#include <iostream>
+
+int main(int argc, const char* const argv[])
+{
+  Linx::ProgramOptions options("Select the fastest resampling configuration which meets an accuracy bound.");
+  options.named("knots", "Number of knots", 1000L);
+  options.named("args", "Number of arguments", 100000L);
+  options.named("sorted", "Sort the arguments (0 or 1)", 0L);
+  options.named("tolerance", "Maximum absolute error", 1.e-6);
+  options.named("methods", "Comma-separated candidate methods", std::string("C2,C2FD,HermiteFD,CatmullRom,Lagrange"));
+  options.named("batches", "Comma-separated candidate batch sizes, 0 for a single batch", std::string("0,256,4096"));
+  options.named("threads", "Comma-separated candidate thread counts", std::string("1,2,4"));
+  options.named("prefetches", "Comma-separated candidate prefetching distances, 0 to disable", std::string("0,8,32"));
+  options.named("reps", "Number of repetitions per candidate", 5L);
+  options.named("seed", "Random seed", -1L);
+  options.named("load", "Tuning file to be loaded and benchmarked instead of tuning", std::string(""));
+  options.named("save", "Tuning file to be written", std::string(""));
+  options.parse(argc, argv);
+  const auto knots = options.as<Linx::Index>("knots");
+  const auto args = options.as<Linx::Index>("args");
+  const auto sorted = options.as<Linx::Index>("sorted");
+  const auto tolerance = options.as<double>("tolerance");
+  const auto load = options.as<std::string>("load");
+  const auto save = options.as<std::string>("save");
+
+  std::cout << "\nGenerating data...\n" << std::endl;
+
+  const auto u = Linx::Sequence<double>(knots).linspace(0, Linx::pi<double>() * 4);
+  std::vector<double> v(u.size());
+  std::transform(u.begin(), u.end(), v.begin(), [](double e) {
+    return std::sin(e);
+  });
+  auto x = Linx::Sequence<double>(args).generate(
+      Linx::UniformNoise<double>(u[0], u[knots - 1], options.as<Linx::Index>("seed")));
+  if (sorted) {
+    std::sort(x.begin(), x.end());
+  }
+
+  Splider::Autotuner<double> tuner(u, v, x);
+  tuner.methods(Splider::split(options.as<std::string>("methods")));
+  tuner.batches(Splider::split_indices(options.as<std::string>("batches")));
+  tuner.threads(Splider::split_indices(options.as<std::string>("threads")));
+  tuner.prefetches(Splider::split_indices(options.as<std::string>("prefetches")));
+  tuner.repetitions(options.as<Linx::Index>("reps"));
+
+  Splider::Tuning tuning;
+  if (load.empty()) {
+    std::cout << "Tuning...\n" << std::endl;
+    tuning = tuner.tune(tolerance);
+  } else {
+    std::cout << "Loading " << load << "...\n" << std::endl;
+    tuning = Splider::Tuning::load(load);
+    tuning.ns_per_element = tuner.measure(tuning);
+  }
+  std::cout << tuning.serialize() << std::endl;
+
+  if (not save.empty()) {
+    tuning.save(save);
+    std::cout << "Saved to " << save << "\n" << std::endl;
+  }
+}
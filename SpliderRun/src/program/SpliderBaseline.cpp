@@ -0,0 +1,124 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Linx/Run/ProgramOptions.h"
+#include "SpliderRun/Baseline.h"
+#include "SpliderRun/BenchmarkSuite.h"
+
+#include <iomanip>
+#include <iostream>
+
+#ifndef SPLIDER_BASELINE_DIR
+#define SPLIDER_BASELINE_DIR "baselines"
+#endif
+
+/**
+ * @brief Get the name of a verdict.
+ */
+std::string verdict_name(Splider::Verdict verdict)
+{
+  switch (verdict) {
+    case Splider::Verdict::Improvement:
+      return "improvement";
+    case Splider::Verdict::Regression:
+      return "REGRESSION";
+    default:
+      return "unchanged";
+  }
+}
+
+int main(int argc, const char* const argv[])
+{
+  Linx::ProgramOptions options(
+      "Record a named benchmark baseline, or compare a new run against a baseline.\n"
+      "In compare mode, the exit code is 1 if a regression is detected.");
+  options.named("mode", "Mode: record, compare", std::string("compare"));
+  options.named("name", "Baseline name", std::string("default"));
+  options.named("dir", "Baseline directory", std::string(SPLIDER_BASELINE_DIR));
+  options.named(
+      "methods",
+      "Comma-separated methods: C2, C2FD, HermiteFD, CatmullRom, Lagrange, Quintic, BSpline, Spline, Cospline, "
+      "BiC2, BiC2FD, BiHermiteFD, BiCatmullRom, BiLagrange, BiQuintic, BiBSpline",
+      std::string("C2,C2FD,HermiteFD,CatmullRom,Lagrange,Spline,Cospline,BiC2,BiLagrange"));
+  options.named("values", "Comma-separated value types: double, float, complex", std::string("double"));
+  options.named("knots", "Comma-separated numbers of knots (along each axis in 2D)", std::string("10,1000"));
+  options.named("args", "Comma-separated numbers of arguments", std::string("100000"));
+  options.named("orders", "Comma-separated argument orders: sorted, random", std::string("sorted,random"));
+  options.named("reps", "Number of repetitions per case (at least 6 for a 95% interval)", 15L);
+  options.named("warmup", "Number of discarded repetitions", 1L);
+  options.named("seed", "Random seed", 0L);
+  options.named("threshold", "Relative slowdown above which a significant change is a regression", 0.05);
+  options.named("confidence", "Confidence level of the median intervals", 0.95);
+  options.parse(argc, argv);
+  const auto mode = options.as<std::string>("mode");
+  const auto name = options.as<std::string>("name");
+  const auto dir = options.as<std::string>("dir");
+  const auto methods = Splider::split(options.as<std::string>("methods"));
+  const auto values = Splider::split(options.as<std::string>("values"));
+  const auto knot_counts = Splider::split_indices(options.as<std::string>("knots"));
+  const auto arg_counts = Splider::split_indices(options.as<std::string>("args"));
+  const auto orders = Splider::split(options.as<std::string>("orders"));
+  const auto reps = options.as<Linx::Index>("reps");
+  const auto warmup = options.as<Linx::Index>("warmup");
+  const auto seed = options.as<Linx::Index>("seed");
+  const auto threshold = options.as<double>("threshold");
+  const auto confidence = options.as<double>("confidence");
+
+  if (mode != "record" && mode != "compare") {
+    throw std::runtime_error("Unknown mode: " + mode);
+  }
+  Splider::Baseline reference;
+  if (mode == "compare") {
+    reference = Splider::Baseline::load(dir, name); // Fail early
+  }
+
+  // Repetitions are the outer loop, such that slow drifts of the machine state spread over all cases
+  Splider::BenchmarkReport scratch;
+  Splider::BenchmarkReport report;
+  for (Linx::Index r = -warmup; r < reps; ++r) {
+    for (const auto& method : methods) {
+      for (const auto& value : values) {
+        for (const auto& knots : knot_counts) {
+          for (const auto& args : arg_counts) {
+            for (const auto& order : orders) {
+              const bool sorted = order == "sorted";
+              Splider::run_case(method, value, knots, args, sorted, seed, r < 0 ? scratch : report);
+            }
+          }
+        }
+      }
+    }
+  }
+  const auto current = Splider::Baseline::from_report(name, report);
+
+  if (mode == "record") {
+    current.save(dir);
+    std::cout << "Baseline recorded: " << Splider::Baseline::path(dir, name).string() << std::endl;
+    return 0;
+  }
+
+  const auto comparisons = Splider::compare(reference, current, threshold, confidence);
+  Linx::Index regressions = 0;
+  std::cout << "key,reference_ns_per_element,reference_low,reference_high,";
+  std::cout << "current_ns_per_element,current_low,current_high,change_percent,verdict\n";
+  for (const auto& c : comparisons) {
+    std::cout << c.key << ',' << c.reference.median << ',' << c.reference.low << ',' << c.reference.high << ','
+              << c.current.median << ',' << c.current.low << ',' << c.current.high << ',' << std::fixed
+              << std::setprecision(1) << c.change() * 100 << std::defaultfloat << std::setprecision(6) << ','
+              << verdict_name(c.verdict) << '\n';
+    if (c.verdict == Splider::Verdict::Regression) {
+      ++regressions;
+    }
+  }
+  const auto missing = current.entries().size() - comparisons.size();
+  if (missing > 0) {
+    std::cerr << "Warning: " << missing << " entries are not in baseline " << name << " and were ignored."
+              << std::endl;
+  }
+  if (regressions > 0) {
+    std::cerr << regressions << " regression(s) beyond " << threshold * 100 << "% detected." << std::endl;
+    return 1;
+  }
+  return 0;
+}
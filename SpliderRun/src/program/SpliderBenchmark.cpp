@@ -12,6 +12,7 @@
 #include "Splider/Hermite.h"
 #include "Splider/Lagrange.h"
 #include "SpliderRun/GslInterp.h"
+#include "SpliderRun/PerfCounters.h"
 
 #include <iostream>
 
@@ -82,12 +83,14 @@ int main(int argc, const char* const argv[])
   options.named("args", "Number of arguments", 100L);
   options.named("iters", "Number of iterations", 1L);
   options.named("seed", "Random seed", -1L);
+  options.named("counters", "Comma-separated hardware counters, default, or none", std::string("none"));
   options.parse(argc, argv);
   const auto setup = options.as<std::string>("case");
   const auto u_size = options.as<Linx::Index>("knots");
   const auto x_size = options.as<Linx::Index>("args");
   const auto v_iters = options.as<Linx::Index>("iters");
   const auto seed = options.as<Linx::Index>("seed");
+  const auto counter_names = options.as<std::string>("counters");
 
   std::cout << "\nGenerating knots...\n" << std::endl;
 
@@ -110,10 +113,20 @@ int main(int argc, const char* const argv[])
 
   std::cout << "\nInterpolating...\n" << std::endl;
 
+  Splider::PerfCounters counters(Splider::PerfCounters::parse_list(counter_names));
+  counters.start();
   const auto duration = resample<Duration>(u, v, x, y, setup);
+  const auto counts = counters.stop();
   std::cout << "  y: " << Linx::Sequence<double>(y) << std::endl;
 
   std::cout << "  Done in " << duration.count() << "ms" << std::endl;
+  if (counter_names != "none" && not counters.available()) {
+    std::cout << "  Hardware counters unavailable" << std::endl;
+  }
+  for (const auto& count : counts) {
+    std::cout << "  " << count.first << ": " << count.second << " (" << count.second / x_size << " per argument)"
+              << std::endl;
+  }
 
   std::cout << std::endl;
 }
@@ -7,10 +7,13 @@
 #include "Linx/Data/Tiling.h"
 #include "Linx/Run/Chronometer.h"
 #include "Linx/Run/ProgramOptions.h"
+#include "Splider/BSpline.h"
 #include "Splider/C2.h"
 #include "Splider/Hermite.h"
 #include "Splider/Lagrange.h"
+#include "Splider/Quintic.h"
 #include "SpliderRun/GslInterp.h"
+#include "SpliderRun/PerfCounters.h"
 
 #include <iostream>
 
@@ -26,6 +29,26 @@ void eval(const U& u, const V& v, const X& x, Y& y)
   }
 }
 
+template <typename U, typename V, typename X, typename Y>
+void eval_bspline(const U& u, const V& v, const X& x, Y& y)
+{
+  using Domain = Splider::Linspace<double>;
+  using Arg = Splider::BSplineArg<Domain>;
+  const auto build = Splider::BSpline::builder(u);
+  const auto& domain = build.domain();
+  std::vector<std::array<Arg, 2>> args;
+  args.reserve(x.size());
+  for (const auto& p : x) {
+    args.push_back({Arg(domain, p[0]), Arg(domain, p[1])});
+  }
+  Splider::BiBSpline<Domain, double> spline(domain, domain);
+  y.resize(args.size());
+  for (const auto& plane : sections(v)) {
+    spline.assign(plane);
+    spline.transform(args.begin(), args.end(), y.begin());
+  }
+}
+
 template <typename TDuration, typename U, typename V, typename X, typename Y>
 TDuration resample(const U& u, const V& v, const X& x, Y& y, const std::string& setup)
 {
@@ -37,6 +60,10 @@ TDuration resample(const U& u, const V& v, const X& x, Y& y, const std::string&
     eval<Splider::Hermite::FiniteDiff>(u, v, x, y);
   } else if (setup == "lagrange") {
     eval<Splider::Lagrange>(u, v, x, y);
+  } else if (setup == "quintic") {
+    eval<Splider::Quintic>(u, v, x, y);
+  } else if (setup == "bspline") {
+    eval_bspline(u, v, x, y);
   } else if (setup == "gsl") {
     y = resample_with_gsl(u, u, v, x);
   } else {
@@ -48,17 +75,19 @@ TDuration resample(const U& u, const V& v, const X& x, Y& y, const std::string&
 int main(int argc, const char* const argv[])
 {
   Linx::ProgramOptions options("2D cospline benchmark.");
-  options.named("case", "Test case: c2, hermite, lagrange, gsl", std::string("c2"));
+  options.named("case", "Test case: c2, hermite, lagrange, quintic, bspline, gsl", std::string("c2"));
   options.named("knots", "Number of knots along each axis", 100L);
   options.named("args", "Number of arguments", 100L);
   options.named("iters", "Numper of iterations", 1L);
   options.named("seed", "Random seed", -1L);
+  options.named("counters", "Comma-separated hardware counters, default, or none", std::string("none"));
   options.parse(argc, argv);
   const auto setup = options.as<std::string>("case");
   const auto u_size = options.as<Linx::Index>("knots");
   const auto x_size = options.as<Linx::Index>("args");
   const auto v_iters = options.as<Linx::Index>("iters");
   const auto seed = options.as<Linx::Index>("seed");
+  const auto counter_names = options.as<std::string>("counters");
 
   std::cout << "\nGenerating knots...\n" << std::endl;
 
@@ -88,7 +117,10 @@ int main(int argc, const char* const argv[])
   std::cout << "  x: " << x << std::endl;
 
   std::cout << "\nInterpolating...\n" << std::endl;
+  Splider::PerfCounters counters(Splider::PerfCounters::parse_list(counter_names));
+  counters.start();
   const auto duration = resample<Duration>(u, v, x, y, setup);
+  const auto counts = counters.stop();
   std::cout << "  y: " << Linx::Sequence<double>(y) << std::endl;
 
   // logger.debug("i\t\tx0\tx1\tf(x0, x1)\ty");
@@ -99,6 +131,13 @@ int main(int argc, const char* const argv[])
   // }
 
   std::cout << "  Done in " << duration.count() << "ms" << std::endl;
+  if (counter_names != "none" && not counters.available()) {
+    std::cout << "  Hardware counters unavailable" << std::endl;
+  }
+  for (const auto& count : counts) {
+    std::cout << "  " << count.first << ": " << count.second << " (" << count.second / x_size << " per argument)"
+              << std::endl;
+  }
 
   std::cout << std::endl;
 }
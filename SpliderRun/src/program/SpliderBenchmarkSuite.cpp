@@ -0,0 +1,109 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Linx/Data/Raster.h"
+#include "Linx/Data/Sequence.h"
+#include "Linx/Run/ProgramOptions.h"
+#include "Splider/HugePages.h"
+#include "SpliderRun/BenchmarkSuite.h"
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Parse a huge page policy.
+ */
+Splider::HugePages huge_pages(const std::string& name)
+{
+  if (name == "none") {
+    return Splider::HugePages::None;
+  }
+  if (name == "transparent") {
+    return Splider::HugePages::Transparent;
+  }
+  if (name == "explicit") {
+    return Splider::HugePages::Explicit;
+  }
+  throw std::runtime_error("Unknown huge page policy: " + name);
+}
+
+int main(int argc, const char* const argv[])
+{
+  Linx::ProgramOptions options("Phase-resolved benchmark of all methods.");
+  options.named(
+      "methods",
+      "Comma-separated methods: C2, C2FD, HermiteFD, CatmullRom, Lagrange, Quintic, BSpline, Spline, Cospline, "
+      "BiC2, BiC2FD, BiHermiteFD, BiCatmullRom, BiLagrange, BiQuintic, BiBSpline",
+      std::string("C2,C2FD,HermiteFD,CatmullRom,Lagrange,Spline,Cospline,BiC2,BiLagrange"));
+  options.named("values", "Comma-separated value types: double, float, complex", std::string("double"));
+  options.named("knots", "Comma-separated numbers of knots (along each axis in 2D)", std::string("10,100,1000"));
+  options.named("args", "Comma-separated numbers of arguments", std::string("1000,100000"));
+  options.named("orders", "Comma-separated argument orders: sorted, random", std::string("sorted,random"));
+  options.named("reps", "Number of repetitions per case", 5L);
+  options.named("seed", "Random seed", -1L);
+  options.named(
+      "counters",
+      "Comma-separated hardware counters (e.g. cycles, cache-misses, r01c7), default, or none",
+      std::string("none"));
+  options.named(
+      "hugepages",
+      "Huge page policy of buffers larger than 2 MiB: none, transparent, explicit",
+      std::string("none"));
+  options.named("prefetch", "Software prefetching distance of the 1D methods, 0 to disable", 0L);
+  options.named("format", "Output format: csv, json", std::string("csv"));
+  options.named("output", "Output file, or - for standard output", std::string("-"));
+  options.parse(argc, argv);
+  const auto methods = Splider::split(options.as<std::string>("methods"));
+  const auto values = Splider::split(options.as<std::string>("values"));
+  const auto knot_counts = Splider::split_indices(options.as<std::string>("knots"));
+  const auto arg_counts = Splider::split_indices(options.as<std::string>("args"));
+  const auto orders = Splider::split(options.as<std::string>("orders"));
+  const auto reps = options.as<Linx::Index>("reps");
+  const auto seed = options.as<Linx::Index>("seed");
+  const auto counter_names = options.as<std::string>("counters");
+  Splider::HugePageResource resource(huge_pages(options.as<std::string>("hugepages")));
+  const auto prefetch = options.as<Linx::Index>("prefetch");
+  const auto format = options.as<std::string>("format");
+  const auto output = options.as<std::string>("output");
+
+  std::unique_ptr<Splider::PerfCounters> counters;
+  if (counter_names != "none") {
+    counters = std::make_unique<Splider::PerfCounters>(Splider::PerfCounters::parse_list(counter_names));
+    if (not counters->available()) {
+      std::cerr << "Warning: hardware counters are unavailable; reporting timings only." << std::endl;
+      counters.reset();
+    }
+  }
+
+  Splider::BenchmarkReport report;
+  for (Linx::Index r = 0; r < reps; ++r) {
+    for (const auto& method : methods) {
+      for (const auto& value : values) {
+        for (const auto& knots : knot_counts) {
+          for (const auto& args : arg_counts) {
+            for (const auto& order : orders) {
+              const bool sorted = order == "sorted";
+              Splider::run_case(method, value, knots, args, sorted, seed, report, counters.get(), &resource, prefetch);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  if (resource.mapped_bytes() > resource.huge_bytes()) {
+    std::cerr << "Warning: " << resource.mapped_bytes() - resource.huge_bytes()
+              << " bytes could not be mapped with huge pages." << std::endl;
+  }
+
+  if (output == "-") {
+    report.write(std::cout, format);
+  } else {
+    std::ofstream file(output);
+    report.write(file, format);
+  }
+}
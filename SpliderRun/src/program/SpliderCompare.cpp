@@ -0,0 +1,338 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Linx/Run/ProgramOptions.h"
+#include "Splider/BiSpline.h"
+#include "Splider/C2.h"
+#include "Splider/CatmullRom.h"
+#include "Splider/Hermite.h"
+#include "Splider/Lagrange.h"
+#include "SpliderRun/Benchmark.h"
+#include "SpliderRun/BenchmarkData.h"
+#include "SpliderRun/GslInterp.h"
+
+#include <fstream>
+#include <iostream>
+
+#if __has_include(<boost/math/interpolators/cardinal_cubic_b_spline.hpp>)
+#include <boost/math/interpolators/cardinal_cubic_b_spline.hpp>
+#define SPLIDER_HAS_BOOST_CARDINAL
+#endif
+
+#if __has_include(<boost/math/interpolators/makima.hpp>)
+#include <boost/math/interpolators/makima.hpp>
+#define SPLIDER_HAS_BOOST_MAKIMA
+#endif
+
+using Splider::BenchmarkCase;
+using Splider::BenchmarkReport;
+using Splider::Data1D;
+using Splider::Data2D;
+using Splider::PhaseTimer;
+
+/**
+ * @brief Get the i-th set of knot values, which are the base values scaled by `i + 1`.
+ *
+ * Varying the values while keeping the knots and arguments is the typical cospline use case.
+ */
+template <typename TRange>
+TRange value_set(const TRange& v, Linx::Index i)
+{
+  auto out = v;
+  for (auto& e : out) {
+    e *= i + 1;
+  }
+  return out;
+}
+
+/**
+ * @brief Time a Splider method in 1D.
+ *
+ * The setup consists in precomputing the arguments, and each evaluation solves and resamples.
+ */
+template <typename TMethod>
+void run_splider(const Data1D<double>& data, const std::vector<std::vector<double>>& sets, PhaseTimer& timer)
+{
+  timer.start();
+  const auto build = TMethod::builder(data.u);
+  auto cospline = build.cospline(data.x);
+  timer.stop("setup", data.x.ssize());
+
+  std::vector<double> y(data.x.size());
+  timer.start();
+  for (const auto& v : sets) {
+    cospline.transform(v.begin(), v.end(), y.begin());
+  }
+  timer.stop("eval", data.x.ssize() * sets.size());
+  Splider::consume(y);
+}
+
+/**
+ * @brief Time GSL cubic spline in 1D, with or without accelerator.
+ *
+ * The setup consists in allocating the spline, and each evaluation initializes and evaluates it.
+ */
+void run_gsl(const Data1D<double>& data, const std::vector<std::vector<double>>& sets, bool accel, PhaseTimer& timer)
+{
+  timer.start();
+  gsl_interp_accel* acc = accel ? gsl_interp_accel_alloc() : nullptr;
+  gsl_spline* spline = gsl_spline_alloc(gsl_interp_cspline, data.u.size());
+  timer.stop("setup", data.x.ssize());
+
+  std::vector<double> y(data.x.size());
+  timer.start();
+  for (const auto& v : sets) {
+    gsl_spline_init(spline, data.u.data(), v.data(), data.u.size());
+    for (std::size_t i = 0; i < y.size(); ++i) {
+      y[i] = gsl_spline_eval(spline, data.x[i], acc);
+    }
+    if (acc) {
+      gsl_interp_accel_reset(acc);
+    }
+  }
+  timer.stop("eval", data.x.ssize() * sets.size());
+  Splider::consume(y);
+
+  if (acc) {
+    gsl_interp_accel_free(acc);
+  }
+  gsl_spline_free(spline);
+}
+
+#ifdef SPLIDER_HAS_BOOST_CARDINAL
+/**
+ * @brief Time Boost.Math cardinal cubic B-spline in 1D.
+ *
+ * There is no setup, and each evaluation builds and evaluates the spline.
+ */
+void run_boost_cardinal(const Data1D<double>& data, const std::vector<std::vector<double>>& sets, PhaseTimer& timer)
+{
+  timer.start();
+  const auto front = data.u[0];
+  const auto step = data.u[1] - data.u[0];
+  timer.stop("setup", data.x.ssize());
+
+  std::vector<double> y(data.x.size());
+  timer.start();
+  for (const auto& v : sets) {
+    boost::math::interpolators::cardinal_cubic_b_spline<double> spline(v.begin(), v.end(), front, step);
+    for (std::size_t i = 0; i < y.size(); ++i) {
+      y[i] = spline(data.x[i]);
+    }
+  }
+  timer.stop("eval", data.x.ssize() * sets.size());
+  Splider::consume(y);
+}
+#endif
+
+#ifdef SPLIDER_HAS_BOOST_MAKIMA
+/**
+ * @brief Time Boost.Math modified Akima interpolation in 1D.
+ *
+ * There is no setup, and each evaluation builds and evaluates the interpolant.
+ */
+void run_boost_makima(const Data1D<double>& data, const std::vector<std::vector<double>>& sets, PhaseTimer& timer)
+{
+  timer.start();
+  const std::vector<double> u(data.u.begin(), data.u.end());
+  timer.stop("setup", data.x.ssize());
+
+  std::vector<double> y(data.x.size());
+  timer.start();
+  for (const auto& v : sets) {
+    auto ui = u;
+    auto vi = v;
+    boost::math::interpolators::makima<std::vector<double>> spline(std::move(ui), std::move(vi));
+    for (std::size_t i = 0; i < y.size(); ++i) {
+      y[i] = spline(data.x[i]);
+    }
+  }
+  timer.stop("eval", data.x.ssize() * sets.size());
+  Splider::consume(y);
+}
+#endif
+
+/**
+ * @brief Time a Splider method in 2D.
+ */
+template <typename TMethod>
+void run_splider_2d(const Data2D<double>& data, const std::vector<Linx::Raster<double>>& sets, PhaseTimer& timer)
+{
+  timer.start();
+  const auto build = TMethod::Multi::builder(data.u, data.u);
+  auto cospline = build.cospline(data.x);
+  timer.stop("setup", data.x.ssize());
+
+  std::vector<double> y(data.x.size());
+  timer.start();
+  for (const auto& v : sets) {
+    cospline.transform(v, y.begin());
+  }
+  timer.stop("eval", data.x.ssize() * sets.size());
+  Splider::consume(y);
+}
+
+/**
+ * @brief Time GSL bicubic interpolation in 2D, with or without accelerators.
+ */
+void run_gsl_2d(
+    const Data2D<double>& data,
+    const std::vector<Linx::Raster<double>>& sets,
+    bool accel,
+    PhaseTimer& timer)
+{
+  const auto size = data.u.size();
+  timer.start();
+  gsl_interp_accel* xacc = accel ? gsl_interp_accel_alloc() : nullptr;
+  gsl_interp_accel* yacc = accel ? gsl_interp_accel_alloc() : nullptr;
+  gsl_spline2d* spline = gsl_spline2d_alloc(gsl_interp2d_bicubic, size, size);
+  timer.stop("setup", data.x.ssize());
+
+  std::vector<double> y(data.x.size());
+  timer.start();
+  for (const auto& v : sets) {
+    gsl_spline2d_init(spline, data.u.data(), data.u.data(), v.data(), size, size);
+    for (std::size_t i = 0; i < y.size(); ++i) {
+      y[i] = gsl_spline2d_eval(spline, data.x[i][0], data.x[i][1], xacc, yacc);
+    }
+  }
+  timer.stop("eval", data.x.ssize() * sets.size());
+  Splider::consume(y);
+
+  if (accel) {
+    gsl_interp_accel_free(xacc);
+    gsl_interp_accel_free(yacc);
+  }
+  gsl_spline2d_free(spline);
+}
+
+/**
+ * @brief Run a 1D or 2D method.
+ */
+void run(
+    const std::string& method,
+    Linx::Index knots,
+    Linx::Index args,
+    Linx::Index set_count,
+    bool sorted,
+    Linx::Index seed,
+    BenchmarkReport& report)
+{
+  PhaseTimer timer(report, BenchmarkCase {method, "double", knots, args, sorted});
+  if (method.rfind("Bi", 0) == 0) {
+    const auto data = Splider::generate_2d<double>(knots, args, sorted, seed);
+    std::vector<Linx::Raster<double>> sets;
+    for (Linx::Index i = 0; i < set_count; ++i) {
+      sets.push_back(value_set(data.v, i));
+    }
+    if (method == "BiC2") {
+      run_splider_2d<Splider::C2>(data, sets, timer);
+    } else if (method == "BiC2FD") {
+      run_splider_2d<Splider::C2::FiniteDiff>(data, sets, timer);
+    } else if (method == "BiHermiteFD") {
+      run_splider_2d<Splider::Hermite::FiniteDiff>(data, sets, timer);
+    } else if (method == "BiCatmullRom") {
+      run_splider_2d<Splider::Hermite::CatmullRom::Uniform>(data, sets, timer);
+    } else if (method == "BiLagrange") {
+      run_splider_2d<Splider::Lagrange>(data, sets, timer);
+    } else if (method == "BiGSL") {
+      run_gsl_2d(data, sets, true, timer);
+    } else if (method == "BiGSLNoAccel") {
+      run_gsl_2d(data, sets, false, timer);
+    } else {
+      throw std::runtime_error("Unknown method: " + method);
+    }
+    return;
+  }
+  const auto data = Splider::generate_1d<double>(knots, args, sorted, seed);
+  std::vector<std::vector<double>> sets;
+  for (Linx::Index i = 0; i < set_count; ++i) {
+    sets.push_back(value_set(data.v, i));
+  }
+  if (method == "C2") {
+    run_splider<Splider::C2>(data, sets, timer);
+  } else if (method == "C2FD") {
+    run_splider<Splider::C2::FiniteDiff>(data, sets, timer);
+  } else if (method == "HermiteFD") {
+    run_splider<Splider::Hermite::FiniteDiff>(data, sets, timer);
+  } else if (method == "CatmullRom") {
+    run_splider<Splider::Hermite::CatmullRom::Uniform>(data, sets, timer);
+  } else if (method == "Lagrange") {
+    run_splider<Splider::Lagrange>(data, sets, timer);
+  } else if (method == "GSL") {
+    run_gsl(data, sets, true, timer);
+  } else if (method == "GSLNoAccel") {
+    run_gsl(data, sets, false, timer);
+#ifdef SPLIDER_HAS_BOOST_CARDINAL
+  } else if (method == "BoostCardinal") {
+    run_boost_cardinal(data, sets, timer);
+#endif
+#ifdef SPLIDER_HAS_BOOST_MAKIMA
+  } else if (method == "BoostMakima") {
+    run_boost_makima(data, sets, timer);
+#endif
+  } else {
+    throw std::runtime_error("Unknown or unavailable method: " + method);
+  }
+}
+
+/**
+ * @brief Get the list of all available methods.
+ */
+std::string all_methods()
+{
+  std::string out = "C2,C2FD,HermiteFD,CatmullRom,Lagrange,GSL,GSLNoAccel";
+#ifdef SPLIDER_HAS_BOOST_CARDINAL
+  out += ",BoostCardinal";
+#endif
+#ifdef SPLIDER_HAS_BOOST_MAKIMA
+  out += ",BoostMakima";
+#endif
+  out += ",BiC2,BiC2FD,BiHermiteFD,BiCatmullRom,BiLagrange,BiGSL,BiGSLNoAccel";
+  return out;
+}
+
+int main(int argc, const char* const argv[])
+{
+  Linx::ProgramOptions options("Comparative benchmark of Splider, GSL and Boost.Math (when available).");
+  options.named("methods", "Comma-separated methods (default: all available)", all_methods());
+  options.named("knots", "Comma-separated numbers of knots (along each axis in 2D)", std::string("16,1024"));
+  options.named("args", "Comma-separated numbers of arguments", std::string("100000"));
+  options.named("sets", "Number of value sets resampled at the same arguments", 10L);
+  options.named("orders", "Comma-separated argument orders: sorted, random", std::string("sorted,random"));
+  options.named("reps", "Number of repetitions per case", 5L);
+  options.named("seed", "Random seed", -1L);
+  options.named("format", "Output format: csv, json", std::string("csv"));
+  options.named("output", "Output file, or - for standard output", std::string("-"));
+  options.parse(argc, argv);
+  const auto methods = Splider::split(options.as<std::string>("methods"));
+  const auto knot_counts = Splider::split_indices(options.as<std::string>("knots"));
+  const auto arg_counts = Splider::split_indices(options.as<std::string>("args"));
+  const auto set_count = options.as<Linx::Index>("sets");
+  const auto orders = Splider::split(options.as<std::string>("orders"));
+  const auto reps = options.as<Linx::Index>("reps");
+  const auto seed = options.as<Linx::Index>("seed");
+  const auto format = options.as<std::string>("format");
+  const auto output = options.as<std::string>("output");
+
+  BenchmarkReport report;
+  for (Linx::Index r = 0; r < reps; ++r) {
+    for (const auto& method : methods) {
+      for (const auto& knots : knot_counts) {
+        for (const auto& args : arg_counts) {
+          for (const auto& order : orders) {
+            run(method, knots, args, set_count, order == "sorted", seed, report);
+          }
+        }
+      }
+    }
+  }
+
+  if (output == "-") {
+    report.write(std::cout, format);
+  } else {
+    std::ofstream file(output);
+    report.write(file, format);
+  }
+}
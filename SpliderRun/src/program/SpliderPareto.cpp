@@ -0,0 +1,210 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Linx/Data/Sequence.h"
+#include "Linx/Run/Chronometer.h"
+#include "Linx/Run/ProgramOptions.h"
+#include "Splider/C2.h"
+#include "Splider/CatmullRom.h"
+#include "Splider/Hermite.h"
+#include "Splider/Lagrange.h"
+#include "SpliderRun/Benchmark.h"
+#include "SpliderRun/GslInterp.h"
+
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+
+using Duration = Splider::BenchmarkDuration;
+
+/**
+ * @brief An analytic test function with its interval of definition.
+ */
+struct TestFunction {
+  std::string name; ///< The function name
+  std::function<double(double)> f; ///< The function
+  double min; ///< The lower bound
+  double max; ///< The upper bound
+};
+
+/**
+ * @brief Get a test function by name.
+ */
+TestFunction test_function(const std::string& name)
+{
+  if (name == "sin") {
+    return {name, [](double x) { return std::sin(x); }, 0, Linx::pi<double>() * 4};
+  }
+  if (name == "runge") {
+    return {name, [](double x) { return 1. / (1. + 25. * x * x); }, -1, 1};
+  }
+  if (name == "exp") {
+    return {name, [](double x) { return std::exp(x); }, 0, 3};
+  }
+  if (name == "sqrt") {
+    return {name, [](double x) { return std::sqrt(x); }, 0, 1};
+  }
+  throw std::runtime_error("Unknown function: " + name);
+}
+
+/**
+ * @brief A point of the accuracy-throughput plane.
+ */
+struct ParetoPoint {
+  std::string function; ///< The function name
+  Linx::Index knots; ///< The number of knots
+  std::string method; ///< The method name
+  double max_error; ///< The maximum absolute error
+  double rms_error; ///< The root mean square error
+  double ns_per_element; ///< The median resampling time per argument
+  bool optimal; ///< Whether the point belongs to the Pareto front
+
+  /**
+   * @brief Check whether the point is at least as good as another one in both criteria, and better in one.
+   */
+  bool dominates(const ParetoPoint& rhs) const
+  {
+    return max_error <= rhs.max_error && ns_per_element <= rhs.ns_per_element &&
+        (max_error < rhs.max_error || ns_per_element < rhs.ns_per_element);
+  }
+};
+
+/**
+ * @brief Resample with a Splider method and return the median duration.
+ *
+ * Only the resampling is timed, i.e. the arguments are computed once, as for a cospline.
+ */
+template <typename TMethod, typename TU, typename TV, typename TX>
+Duration resample(const TU& u, const TV& v, const TX& x, std::vector<double>& y, Linx::Index reps)
+{
+  const auto build = TMethod::builder(u);
+  auto cospline = build.cospline(x);
+  Linx::Chronometer<Duration> chrono;
+  std::vector<Duration> samples;
+  for (Linx::Index r = 0; r < reps; ++r) {
+    chrono.start();
+    y = cospline(v);
+    samples.push_back(chrono.stop());
+  }
+  return Splider::median(samples);
+}
+
+/**
+ * @brief Resample with GSL and return the median duration.
+ *
+ * GSL has no separate argument precomputation, such that the whole interpolation is timed.
+ */
+template <typename TU, typename TV, typename TX>
+Duration resample_gsl(const TU& u, const TV& v, const TX& x, std::vector<double>& y, Linx::Index reps)
+{
+  Linx::Chronometer<Duration> chrono;
+  std::vector<Duration> samples;
+  for (Linx::Index r = 0; r < reps; ++r) {
+    chrono.start();
+    y = eval_with_gsl(u, v, x);
+    samples.push_back(chrono.stop());
+  }
+  return Splider::median(samples);
+}
+
+/**
+ * @brief Measure the accuracy and throughput of a method on a test function.
+ */
+ParetoPoint
+measure(const std::string& method, const TestFunction& function, Linx::Index knots, Linx::Index args, Linx::Index reps)
+{
+  const auto u = Linx::Sequence<double>(knots).linspace(function.min, function.max);
+  auto x = Linx::Sequence<double>(args).linspace(function.min, function.max);
+  x[args - 1] = u[knots - 1]; // Avoid rounding errors
+  std::vector<double> v(u.size());
+  std::transform(u.begin(), u.end(), v.begin(), function.f);
+
+  std::vector<double> y;
+  Duration duration;
+  if (method == "C2") {
+    duration = resample<Splider::C2>(u, v, x, y, reps);
+  } else if (method == "C2FD") {
+    duration = resample<Splider::C2::FiniteDiff>(u, v, x, y, reps);
+  } else if (method == "HermiteFD") {
+    duration = resample<Splider::Hermite::FiniteDiff>(u, v, x, y, reps);
+  } else if (method == "CatmullRom") {
+    duration = resample<Splider::Hermite::CatmullRom::Uniform>(u, v, x, y, reps);
+  } else if (method == "Lagrange") {
+    duration = resample<Splider::Lagrange>(u, v, x, y, reps);
+  } else if (method == "GSL") {
+    duration = resample_gsl(u, v, x, y, reps);
+  } else {
+    throw std::runtime_error("Unknown method: " + method);
+  }
+
+  double max_error = 0;
+  double sum2 = 0;
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    const auto error = std::abs(y[i] - function.f(x[i]));
+    max_error = std::max(max_error, error);
+    sum2 += error * error;
+  }
+  const auto ns = std::chrono::duration<double, std::nano>(duration).count() / args;
+  return {function.name, knots, method, max_error, std::sqrt(sum2 / args), ns, false};
+}
+
+/**
+ * @brief Flag the non-dominated points among points of the same function and knot density.
+ */
+void flag_pareto_front(std::vector<ParetoPoint>& points)
+{
+  for (auto& p : points) {
+    p.optimal = std::none_of(points.begin(), points.end(), [&](const auto& q) {
+      return q.function == p.function && q.knots == p.knots && q.dominates(p);
+    });
+  }
+}
+
+int main(int argc, const char* const argv[])
+{
+  Linx::ProgramOptions options("Accuracy versus throughput benchmark of all methods, including GSL.");
+  options.named(
+      "methods",
+      "Comma-separated methods: C2, C2FD, HermiteFD, CatmullRom, Lagrange, GSL",
+      std::string("C2,C2FD,HermiteFD,CatmullRom,Lagrange,GSL"));
+  options.named(
+      "functions",
+      "Comma-separated test functions: sin, runge, exp, sqrt",
+      std::string("sin,runge,exp,sqrt"));
+  options.named("knots", "Comma-separated numbers of knots", std::string("8,16,32,64,128,256"));
+  options.named("args", "Number of arguments", 100000L);
+  options.named("reps", "Number of repetitions per case", 5L);
+  options.named("output", "Output CSV file, or - for standard output", std::string("-"));
+  options.parse(argc, argv);
+  const auto methods = Splider::split(options.as<std::string>("methods"));
+  const auto functions = Splider::split(options.as<std::string>("functions"));
+  const auto knot_counts = Splider::split_indices(options.as<std::string>("knots"));
+  const auto args = options.as<Linx::Index>("args");
+  const auto reps = options.as<Linx::Index>("reps");
+  const auto output = options.as<std::string>("output");
+
+  std::vector<ParetoPoint> points;
+  for (const auto& name : functions) {
+    const auto function = test_function(name);
+    for (const auto& knots : knot_counts) {
+      for (const auto& method : methods) {
+        points.push_back(measure(method, function, knots, args, reps));
+      }
+    }
+  }
+  flag_pareto_front(points);
+
+  std::ofstream file;
+  if (output != "-") {
+    file.open(output);
+  }
+  std::ostream& os = output == "-" ? std::cout : file;
+  os << "function,knots,method,max_error,rms_error,ns_per_element,elements_per_s,pareto\n";
+  for (const auto& p : points) {
+    os << p.function << ',' << p.knots << ',' << p.method << ',' << p.max_error << ',' << p.rms_error << ','
+       << p.ns_per_element << ',' << (p.ns_per_element > 0 ? 1.e9 / p.ns_per_element : 0) << ','
+       << (p.optimal ? 1 : 0) << '\n';
+  }
+}
@@ -0,0 +1,224 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Linx/Run/ProgramOptions.h"
+#include "Splider/BiSpline.h"
+#include "Splider/C2.h"
+#include "Splider/CatmullRom.h"
+#include "Splider/Hermite.h"
+#include "Splider/Lagrange.h"
+#include "Splider/Tiling.h"
+#include "SpliderRun/MappedArray.h"
+
+#include <iostream>
+
+/**
+ * @brief The number of bytes processed between two releases of the mapped pages.
+ */
+constexpr std::size_t release_bytes = std::size_t(64) << 20;
+
+/**
+ * @brief Resample each row of a value cube along its last axis.
+ *
+ * Input and output rows are accessed in place, without copy.
+ */
+template <typename TMethod, typename TValue>
+void resample_1d(
+    const std::vector<double>& u,
+    Splider::MappedArray<TValue>& v,
+    const std::vector<double>& x,
+    const std::string& output)
+{
+  if (v.row_size() != static_cast<Linx::Index>(u.size())) {
+    throw std::runtime_error("The last axis of the values does not match the number of knots.");
+  }
+  auto shape = v.shape();
+  shape.back() = x.size();
+  auto y = Splider::MappedArray<TValue>::create(output, shape);
+  v.file().advise_sequential();
+  y.file().advise_sequential();
+
+  const auto build = TMethod::builder(u);
+  auto cospline = build.template cospline<TValue>(x);
+  const auto n = v.row_size();
+  const auto m = y.row_size();
+  const auto rows_per_release = std::max<Linx::Index>(release_bytes / (n * sizeof(TValue)), 1);
+  Linx::Index released = 0;
+  auto release = [&](Linx::Index end) {
+    v.release(released * n, (end - released) * n);
+    y.release(released * m, (end - released) * m);
+    released = end;
+  };
+  for (Linx::Index r = 0; r < v.rows(); ++r) {
+    const auto in = v.data() + r * n;
+    cospline.transform(in, in + n, y.data() + r * m);
+    if ((r + 1) % rows_per_release == 0) {
+      release(r + 1);
+    }
+  }
+  release(v.rows());
+  y.file().sync();
+}
+
+/**
+ * @brief Resample each plane of a value cube along its last two axes.
+ *
+ * Input planes are accessed in place, and output values are written in place.
+ * If a tile side is given, planes are read tile by tile, which bounds the working set for planes larger than RAM.
+ * Global methods are always resampled by `TiledBiCospline`, as the tensor product of 1D splines,
+ * with a single tile per plane if no tile side is given,
+ * such that the result does not depend on the tile side.
+ */
+template <typename TMethod, typename TValue>
+void resample_2d(
+    const std::vector<double>& u0,
+    const std::vector<double>& u1,
+    Splider::MappedArray<TValue>& v,
+    const std::vector<double>& x0,
+    const std::vector<double>& x1,
+    const std::string& output,
+    Linx::Index tile,
+    Linx::Index threads)
+{
+  const auto& in_shape = v.shape();
+  const auto dim = in_shape.size();
+  if (dim < 2 || in_shape[dim - 1] != static_cast<Linx::Index>(u0.size()) ||
+      in_shape[dim - 2] != static_cast<Linx::Index>(u1.size())) {
+    throw std::runtime_error("The last two axes of the values do not match the numbers of knots.");
+  }
+  if (x0.size() != x1.size()) {
+    throw std::runtime_error("The trajectory coordinates have different lengths.");
+  }
+  std::vector<Linx::Index> shape(in_shape.begin(), in_shape.end() - 1);
+  shape.back() = x0.size();
+  auto y = Splider::MappedArray<TValue>::create(output, shape);
+  v.file().advise_sequential();
+  y.file().advise_sequential();
+
+  Splider::Trajectory<2> trajectory(x0.size());
+  for (std::size_t i = 0; i < x0.size(); ++i) {
+    trajectory[i][0] = x0[i];
+    trajectory[i][1] = x1[i];
+  }
+  const auto n = in_shape[dim - 1] * in_shape[dim - 2];
+  const auto m = y.row_size();
+  const auto planes = v.size() / n;
+  const auto planes_per_release = std::max<Linx::Index>(release_bytes / (n * sizeof(TValue)), 1);
+  Linx::Index released = 0;
+  auto release = [&](Linx::Index end) {
+    v.release(released * n, (end - released) * n);
+    y.release(released * m, (end - released) * m);
+    released = end;
+  };
+
+  if (tile > 0 || not Splider::is_local<TMethod>()) {
+    const Linx::Position<2> side {tile > 0 ? tile : in_shape[dim - 1], tile > 0 ? tile : in_shape[dim - 2]};
+    const Splider::TiledBiCospline<TMethod, TValue> tiled(u0, u1, trajectory, side);
+    const auto width = in_shape[dim - 1];
+    for (Linx::Index p = 0; p < planes; ++p) {
+      const auto plane = v.data() + p * n;
+      const auto read = [&](const Linx::Position<2>& front, const Linx::Position<2>& shape, TValue* data) {
+        for (Linx::Index j = 0; j < shape[1]; ++j) {
+          const auto row = plane + (front[1] + j) * width + front[0];
+          data = std::copy(row, row + shape[0], data);
+        }
+      };
+      tiled.transform(read, y.data() + p * m, threads);
+      if ((p + 1) % planes_per_release == 0) {
+        release(p + 1);
+      }
+    }
+  } else {
+    const auto build = TMethod::Multi::builder(u0, u1);
+    auto cospline = build.template cospline<TValue>(trajectory);
+    for (Linx::Index p = 0; p < planes; ++p) {
+      const Splider::PlaneView<TValue> plane(v.data() + p * n, in_shape[dim - 1]);
+      cospline.transform(plane, y.data() + p * m);
+      if ((p + 1) % planes_per_release == 0) {
+        release(p + 1);
+      }
+    }
+  }
+  release(planes);
+  y.file().sync();
+}
+
+/**
+ * @brief Select the dimension.
+ */
+template <typename TMethod, typename TValue>
+void resample(const Linx::ProgramOptions& options)
+{
+  auto v = Splider::MappedArray<TValue>::open(options.as<std::string>("values"));
+  const auto u0 = Splider::load_vector(options.as<std::string>("u0"));
+  const auto x0 = Splider::load_vector(options.as<std::string>("x0"));
+  const auto output = options.as<std::string>("output");
+  if (options.as<std::string>("u1").empty()) {
+    resample_1d<TMethod>(u0, v, x0, output);
+  } else {
+    const auto u1 = Splider::load_vector(options.as<std::string>("u1"));
+    const auto x1 = Splider::load_vector(options.as<std::string>("x1"));
+    const auto tile = options.as<Linx::Index>("tile");
+    const auto threads = options.as<Linx::Index>("threads");
+    resample_2d<TMethod>(u0, u1, v, x0, x1, output, tile, threads);
+  }
+}
+
+/**
+ * @brief Select the value type.
+ */
+template <typename TMethod>
+void resample(const Linx::ProgramOptions& options)
+{
+  auto descr = Splider::npy_descr(options.as<std::string>("values"));
+  if (descr.empty()) {
+    descr = "<" + options.as<std::string>("dtype");
+  }
+  if (descr == Splider::npy_descr<double>()) {
+    resample<TMethod, double>(options);
+  } else if (descr == Splider::npy_descr<float>()) {
+    resample<TMethod, float>(options);
+  } else {
+    throw std::runtime_error("Unsupported value type: " + descr);
+  }
+}
+
+int main(int argc, const char* const argv[])
+{
+  Linx::ProgramOptions options(
+      "Resample memory-mapped value cubes along their last axis (1D) or last two axes (2D).\n"
+      "Arrays are NPY files or raw files specified as path:shape, e.g. cube.raw:100,20,30, in C order.\n"
+      "The output is an NPY file of the same shape as the values, where the resampled axes are replaced by one axis "
+      "of the length of the arguments.");
+  options.named("method", "Method: C2, C2FD, HermiteFD, CatmullRom, Lagrange", std::string("C2"));
+  options.named("values", "Knot values", std::string());
+  options.named("u0", "Knot abscissae along the last axis", std::string());
+  options.named("u1", "Knot abscissae along the second-to-last axis, for 2D resampling", std::string());
+  options.named("x0", "Argument coordinates along the last axis", std::string());
+  options.named("x1", "Argument coordinates along the second-to-last axis, for 2D resampling", std::string());
+  options.named(
+      "tile",
+      "Tile side in knots for out-of-core 2D resampling, or 0 to resample whole planes; "
+      "C2 is resampled as a tensor product of 1D splines in both cases",
+      0L);
+  options.named("threads", "Number of threads for tiled resampling", 1L);
+  options.named("dtype", "Value type of raw files: f8, f4", std::string("f8"));
+  options.named("output", "Output NPY file", std::string("resampled.npy"));
+  options.parse(argc, argv);
+  const auto method = options.as<std::string>("method");
+
+  if (method == "C2") {
+    resample<Splider::C2>(options);
+  } else if (method == "C2FD") {
+    resample<Splider::C2::FiniteDiff>(options);
+  } else if (method == "HermiteFD") {
+    resample<Splider::Hermite::FiniteDiff>(options);
+  } else if (method == "CatmullRom") {
+    resample<Splider::Hermite::CatmullRom::Uniform>(options);
+  } else if (method == "Lagrange") {
+    resample<Splider::Lagrange>(options);
+  } else {
+    throw std::runtime_error("Unknown method: " + method);
+  }
+}
@@ -0,0 +1,76 @@
+/// @copyright 2023-2024, Antoine Basset (CNES)
+// This file is part of Splider <github.com/kabasset/Splider>
+// SPDX-License-Identifier: Apache-2.0
+
+#include "SpliderRun/Baseline.h"
+
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Baseline_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(median_interval_test)
+{
+  const std::vector<double> samples {9, 1, 8, 2, 7, 3, 6, 4, 5, 10};
+  const auto interval = Splider::median_interval(samples, 0.95);
+  BOOST_TEST(interval.median == 5.5);
+  BOOST_TEST(interval.low == 2); // Ranks 2 and 9 for 10 samples
+  BOOST_TEST(interval.high == 9);
+  const auto few = Splider::median_interval({3, 1, 2}, 0.95);
+  BOOST_TEST(few.low == 1);
+  BOOST_TEST(few.median == 2);
+  BOOST_TEST(few.high == 3);
+}
+
+BOOST_AUTO_TEST_CASE(json_roundtrip_test)
+{
+  Splider::Baseline baseline("main");
+  baseline.add("C2/double/10/1000/sorted/eval", {1.5, 1.25, 2});
+  baseline.add("Lagrange/float/100/1000/random/args", {0.125});
+  std::stringstream ss;
+  baseline.write(ss);
+  const auto read = Splider::Baseline::read(ss);
+  BOOST_TEST(read.name() == "main");
+  BOOST_TEST(read.entries() == baseline.entries());
+}
+
+BOOST_AUTO_TEST_CASE(regression_detection_test)
+{
+  Splider::Baseline reference("ref");
+  Splider::Baseline current("new");
+  std::vector<double> base;
+  std::vector<double> slow;
+  std::vector<double> noisy;
+  for (int i = 0; i < 15; ++i) {
+    base.push_back(10 + 0.1 * (i % 5));
+    slow.push_back(12 + 0.1 * (i % 5));
+    noisy.push_back(10.5 + (i % 2 ? 3 : -3));
+  }
+  reference.add("slow", base);
+  reference.add("noisy", base);
+  reference.add("fast", slow);
+  reference.add("gone", base);
+  current.add("slow", slow);
+  current.add("noisy", noisy);
+  current.add("fast", base);
+  current.add("new", base);
+  const auto comparisons = Splider::compare(reference, current, 0.05);
+  BOOST_TEST(comparisons.size() == 3);
+  for (const auto& c : comparisons) {
+    if (c.key == "slow") {
+      BOOST_TEST((c.verdict == Splider::Verdict::Regression));
+    } else if (c.key == "noisy") {
+      BOOST_TEST((c.verdict == Splider::Verdict::Unchanged));
+    } else {
+      BOOST_TEST((c.verdict == Splider::Verdict::Improvement));
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()